@@ -34,6 +34,7 @@
 
 #include "compression.h"
 #include "my_inttypes.h"
+#include "mysql/components/services/bits/my_io_bits.h"  // File
 
 typedef void (*before_header_callback_fn)(NET *net, void *user_data,
                                           size_t count);
@@ -73,4 +74,44 @@ inline void net_server_ext_init(NET_SERVER *ns) {
   ns->timeout_on_full_packet = false;
 }
 
+/**
+  Write a logical packet whose payload is a prefix followed by a range of a
+  file, sending the file content with sendfile(2) rather than through the
+  write buffer. The packet is split as my_net_write() would split it.
+
+  Only for connections where vio_can_sendfile() is true and without
+  compression.
+
+  @param  net         NET handler.
+  @param  prefix      Bytes sent before the file content.
+  @param  prefix_len  Length of the prefix.
+  @param  file        The file to read the content from.
+  @param  offset      Where the content starts in the file.
+  @param  length      Length of the content.
+
+  @return true on error, false on success.
+*/
+bool my_net_write_file(NET *net, const uchar *prefix, size_t prefix_len,
+                       File file, my_off_t offset, size_t length);
+
+/**
+  Release the per connection state of a NET, like net_end(), but keep its
+  packet buffer for my_net_reinit().
+
+  @param  net  NET handler.
+*/
+void net_end_keep_buffer(NET *net);
+
+/**
+  Initialize a NET ended by net_end_keep_buffer() for a new connection,
+  like my_net_init(). The packet buffer is reused unless its size differs
+  from net_buffer_length.
+
+  @param  net  NET handler.
+  @param  vio  Vio of the new connection.
+
+  @return true on error, false on success.
+*/
+bool my_net_reinit(NET *net, Vio *vio);
+
 #endif
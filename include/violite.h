@@ -169,6 +169,10 @@ int vio_set_blocking_flag(Vio *vio, bool set_blocking_flag);
 size_t vio_read(MYSQL_VIO vio, uchar *buf, size_t size);
 size_t vio_read_buff(MYSQL_VIO vio, uchar *buf, size_t size);
 size_t vio_write(MYSQL_VIO vio, const uchar *buf, size_t size);
+/* Whether vio_sendfile() can be used with the connection */
+bool vio_can_sendfile(MYSQL_VIO vio);
+/* Send part of a file with sendfile(2), without copying it to user space */
+size_t vio_sendfile(MYSQL_VIO vio, File file, my_off_t offset, size_t size);
 /* setsockopt TCP_NODELAY at IPPROTO_TCP level, when possible */
 int vio_fastsend(MYSQL_VIO vio);
 /* setsockopt SO_KEEPALIVE at SOL_SOCKET level, when possible */
@@ -42,51 +42,6 @@
 #include "plugin/group_replication/libmysqlgcs/include/mysql/gcs/gcs_communication_interface.h"
 #include "plugin/group_replication/libmysqlgcs/include/mysql/gcs/gcs_control_interface.h"
 
-/**
-  This class extends Gtid_set to include a reference counter.
-
-  It is for Certifier only, so it is single-threaded and no locks
-  are needed since Certifier already ensures sequential use.
-
-  It is to be used to share by multiple entries in the
-  certification info and released when the last reference to it
-  needs to be freed.
-*/
-class Gtid_set_ref : public Gtid_set {
- public:
-  Gtid_set_ref(Sid_map *sid_map, int64 parallel_applier_sequence_number)
-      : Gtid_set(sid_map),
-        reference_counter(0),
-        parallel_applier_sequence_number(parallel_applier_sequence_number) {}
-
-  virtual ~Gtid_set_ref() = default;
-
-  /**
-    Increment the number of references by one.
-
-    @return the number of references
-  */
-  size_t link() { return ++reference_counter; }
-
-  /**
-    Decrement the number of references by one.
-
-    @return the number of references
-  */
-  size_t unlink() {
-    assert(reference_counter > 0);
-    return --reference_counter;
-  }
-
-  int64 get_parallel_applier_sequence_number() const {
-    return parallel_applier_sequence_number;
-  }
-
- private:
-  size_t reference_counter;
-  int64 parallel_applier_sequence_number;
-};
-
 /**
   This class is a core component of the database state machine
   replication protocol. It implements conflict detection based
@@ -188,10 +143,19 @@ class Certifier_interface : public Certifier_stats {
       Gtid_set *executed_gtid_set) = 0;
 };
 
+/*
+  The certification info of remote transactions is a fixed size hash table
+  of the 64-bit write set hashes. The first two bytes of a hash select one
+  of the REPLAY_CAL_ARRAY buckets, each bucket stores up to
+  REPLAY_CAL_HASH_ITEMS entries of 8 bytes: the remaining 6 bytes of the
+  hash followed by the sequence number of the last transaction that
+  changed it, relative to base_parallel_applier_sequence_number.
+*/
 #define REPLAY_CAL_HASH_ITEM 4088
 #define REPLAY_CAL_HASH_ITEMS (REPLAY_CAL_HASH_ITEM / 8)
 #define REPLAY_CAL_ARRAY 65536
 #define MAX_RELATIVE_SEQUENCE_NUMBER 65535
+#define REPLAY_CAL_KEY_LENGTH 6
 
 typedef struct {
   int number;
@@ -199,15 +163,8 @@ typedef struct {
   unsigned char values[REPLAY_CAL_HASH_ITEM];
 } replay_cal_hash_item;
 
-
 class Certifier : public Certifier_interface {
  public:
-  typedef std::unordered_map<
-      std::string, Gtid_set_ref *, std::hash<std::string>,
-      std::equal_to<std::string>,
-      Malloc_allocator<std::pair<const std::string, Gtid_set_ref *>>>
-      Certification_info;
-
   Certifier();
   ~Certifier() override;
 
@@ -271,6 +228,10 @@ class Certifier : public Certifier_interface {
                               event.
     @param local_transaction  True if this transaction did originate from
                               this member, false otherwise.
+    @param[out] dependencies  If not null, the transactions a positively
+                              certified remote transaction depends on, no
+                              parents when they are not known better than
+                              by its last_committed.
 
     @retval >0                transaction identifier (positively certified).
                               If generate_group_id is false and certification
@@ -281,7 +242,8 @@ class Certifier : public Certifier_interface {
   rpl_gno certify(Gtid_set *snapshot_version,
                   std::list<const char *> *write_set, bool generate_group_id,
                   const char *member_uuid, Gtid_log_event *gle,
-                  bool local_transaction);
+                  bool local_transaction,
+                  Transaction_dependencies *dependencies = nullptr);
 
   /**
     Returns the transactions in stable set in text format, that is, the set of
@@ -539,6 +501,8 @@ class Certifier : public Certifier_interface {
   void clear_members();
 
   replay_cal_hash_item replayed_cal_array[REPLAY_CAL_ARRAY];
+  /// Indexes of the buckets of replayed_cal_array that are not empty.
+  std::vector<uint16> used_replay_cal_items;
   int64 base_parallel_applier_sequence_number;
 
   int64 parallel_applier_last_committed_global;
@@ -646,6 +610,29 @@ class Certifier : public Certifier_interface {
   bool add_item(const char *item, int64 sequence_number,
                       int64 *item_previous_sequence_number);
 
+  /**
+    Drop the entries of a bucket whose sequence number is not newer than
+    parallel_applier_last_committed_global, since they can no longer
+    become the last committed of a transaction.
+
+    @param hash_item  the bucket
+    @param shift      amount subtracted from the relative sequence numbers
+                      that are kept
+    @param limit      relative sequence number of
+                      parallel_applier_last_committed_global
+  */
+  void purge_replay_cal_item(replay_cal_hash_item *hash_item, int64 shift,
+                             int64 limit);
+
+  /**
+    Move base_parallel_applier_sequence_number up to
+    parallel_applier_last_committed_global, purging every bucket.
+
+    @retval false  the base moved
+    @retval true   the base is already there
+  */
+  bool rebase_replay_cal_info();
+
   void clear_replay_cal_info();
 
 
@@ -39,14 +39,17 @@ Member_version convert_to_mysql_version(
 /** Maps GCS protocol version to MySQL version. */
 /**
  * Converts the @c mysql_version into the respective GCS protocol, taking into
- * account this server's version @c my_version.
+ * account this server's version @c my_version and the protocols the members
+ * of the group support.
  *
  * @param mysql_version The MySQL version to convert
  * @param my_version The MySQL version of this server
+ * @param max_supported_protocol The highest protocol every member supports
  * @returns the respective GCS protocol version
  */
 Gcs_protocol_version convert_to_gcs_protocol(
-    Member_version const &mysql_version, Member_version const &my_version);
+    Member_version const &mysql_version, Member_version const &my_version,
+    Gcs_protocol_version const &max_supported_protocol);
 
 /**
  * Checks whether the given C-style string has the version format
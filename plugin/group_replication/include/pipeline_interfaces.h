@@ -25,6 +25,7 @@
 #define PIPELINE_INTERFACES_INCLUDED
 
 #include <list>
+#include <vector>
 
 #include <mysql/group_replication_priv.h>
 #include <mysql/plugin_group_replication.h>
@@ -39,6 +40,23 @@ typedef std::list<Gcs_member_identifier,
                   Malloc_allocator<Gcs_member_identifier>>
     Members_list;
 
+/**
+  The transactions a remote transaction depends on, as found by
+  certification. They are registered on the applier channel before the
+  transaction is queued, so that its workers wait for them instead of
+  for everything up to the transaction's last_committed.
+*/
+struct Transaction_dependencies {
+  /// GNO of the transaction
+  rpl_gno gno{0};
+  /// sequence_number of the transaction
+  int64 sequence_number{0};
+  /// The transaction is applied after this one and all earlier ones
+  int64 barrier{0};
+  /// Later transactions it conflicts with, empty if none or unknown
+  std::vector<long long> parents;
+};
+
 // Define the data packet type
 #define DATA_PACKET_TYPE 1
 
@@ -401,6 +419,18 @@ class Pipeline_event {
 
   bool get_io_buffered() { return m_io_buffered; }
 
+  /**
+    Set the dependencies of the transaction found by certification.
+    Like the consistency level they are not reset with the event.
+  */
+  void set_transaction_dependencies(Transaction_dependencies &&dependencies) {
+    m_transaction_dependencies = std::move(dependencies);
+  }
+
+  const Transaction_dependencies &get_transaction_dependencies() {
+    return m_transaction_dependencies;
+  }
+
  private:
   /**
     Converts the existing packet into a log event.
@@ -463,6 +493,7 @@ class Pipeline_event {
   bool m_online_members_memory_ownership;
   bool m_io_buffered;
   bool m_view_generated;
+  Transaction_dependencies m_transaction_dependencies;
 };
 
 /**
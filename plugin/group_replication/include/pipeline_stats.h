@@ -24,6 +24,7 @@
 #ifndef PIPELINE_STATS_INCLUDED
 #define PIPELINE_STATS_INCLUDED
 
+#include <chrono>
 #include <map>
 #include <string>
 #include <vector>
@@ -355,6 +356,28 @@ class Pipeline_member_stats {
   */
   uint64 get_stamp();
 
+  /**
+    Get the estimated number of transactions per second the member applies
+    when its applier queue is not empty.
+
+    @return the estimate, 0 if it is not known yet
+  */
+  double get_apply_capacity();
+
+  /**
+    Get the highest group commit rate, in transactions per second, that the
+    member is predicted to sustain without its applier queue growing above
+    the flow control threshold.
+
+    @return the rate, 0 if the member does not limit the group
+  */
+  double get_predicted_max_rate();
+
+  /**
+    Set the rate returned by get_predicted_max_rate().
+  */
+  void set_predicted_max_rate(double rate);
+
  private:
   int32 m_transactions_waiting_apply;
   int64 m_transactions_applied;
@@ -363,6 +386,9 @@ class Pipeline_member_stats {
   int64 m_delta_transactions_local;
   std::string m_transactions_committed_all_members;
   uint64 m_stamp;
+  double m_apply_capacity;
+  double m_predicted_max_rate;
+  std::chrono::steady_clock::time_point m_update_time;
 };
 
 /**
@@ -371,15 +397,39 @@ class Pipeline_member_stats {
 */
 typedef std::map<std::string, Pipeline_member_stats> Flow_stat_module_info;
 
+/**
+  Flow control modes:
+    FCM_DISABLED  flow control disabled
+    FCM_PREDICTIVE  commits of local transactions are paced to the apply
+                    capacity the members are predicted to have
+*/
+enum Flow_control_mode { FCM_DISABLED = 0, FCM_PREDICTIVE };
+
 /**
   @class Flow_stat_module
 
   The pipeline stats aggregator of all group members stats and
   flow control module.
+
+  With FCM_PREDICTIVE, members exchange stats every second. Each member's
+  apply capacity is estimated from the periods in which its applier was
+  busy throughout, and the group commit rate it can take over the next
+  FLOW_CONTROL_HORIZON seconds is predicted from that capacity and its
+  distance to the applier threshold. The slowest member limits the group.
+  Each member gets half of the share of that rate it recently committed,
+  plus half of an even split among the members that write.
+  Local commits are then paced by a token bucket, which spreads them
+  evenly instead of stopping and releasing writers at each period.
 */
 class Flow_stat_module {
  public:
   static const int64 MAXTPS;
+  /** Seconds in which a member's queue is brought back to the threshold. */
+  static const int FLOW_CONTROL_HORIZON;
+  /** Lowest commit rate flow control ever sets, in transactions per second. */
+  static const double MIN_COMMIT_RATE;
+  /** Seconds a transaction waits for flow control at most. */
+  static const int MAX_COMMIT_WAIT;
 
   /**
     Default constructor.
@@ -422,7 +472,37 @@ class Flow_stat_module {
   */
   Pipeline_member_stats *get_pipeline_stats(const std::string &member_id);
 
+  /**
+    Returns a copy of the stats of all members.
+
+    @param[out] info  the stats, keyed by GCS member_id
+  */
+  void get_all_pipeline_stats(Flow_stat_module_info &info);
+
+  /**
+    Wait until flow control lets the calling transaction commit, the
+    transaction is killed or MAX_COMMIT_WAIT seconds elapsed.
+  */
+  void do_wait();
+
+  /**
+    Get the commit rate local transactions are paced to.
+
+    @return the rate in transactions per second, 0 if not throttled
+  */
+  double get_commit_rate();
+
  private:
+  /**
+    Predict the rate each member can take and set the local commit rate.
+  */
+  void flow_control_step();
+
+  /**
+    Set the local commit rate and wake up the waiting transactions.
+  */
+  void set_commit_rate(double rate);
+
   Flow_stat_module_info m_info;
   /*
     A rw lock to protect the Flow_stat_module_info map.
@@ -438,6 +518,15 @@ class Flow_stat_module {
     Remaining seconds to skip flow-stat steps
   */
   int seconds_to_skip;
+
+  /*
+    Token bucket of the local commits, protected by m_flow_control_lock.
+  */
+  mysql_mutex_t m_flow_control_lock;
+  mysql_cond_t m_flow_control_cond;
+  double m_commit_rate;
+  double m_tokens;
+  std::chrono::steady_clock::time_point m_refill_time;
 };
 
 
@@ -246,6 +246,8 @@ const char *get_view_change_uuid_var();
 ulong get_exit_state_action_var();
 ulong get_components_stop_timeout_var();
 ulong get_communication_stack_var();
+ulong get_flow_control_mode_var();
+long get_flow_control_applier_threshold_var();
 ulong get_single_primary_election_mode_var();
 const char *get_single_primary_election_mode_string(int index);
 
@@ -98,6 +98,7 @@ extern PSI_mutex_key key_GR_LOCK_applier_module_run,
     key_GR_LOCK_group_part_handler_abort,
     key_GR_LOCK_group_part_handler_run,
     key_GR_LOCK_pipeline_continuation,
+    key_GR_LOCK_pipeline_stats_flow_control,
     key_GR_LOCK_pipeline_stats_transactions_waiting_apply,
     key_GR_LOCK_plugin_modules_termination,
     key_GR_LOCK_plugin_applier_module_initialize_terminate,
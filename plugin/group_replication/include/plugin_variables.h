@@ -226,6 +226,22 @@ struct plugin_options_variables {
 #define MAX_MESSAGE_CACHE_SIZE ULONG_MAX
   ulong message_cache_size_var;
 
+#define DEFAULT_MESSAGE_CACHE_SPILL_SIZE 0
+#define MIN_MESSAGE_CACHE_SPILL_SIZE 0
+#define MAX_MESSAGE_CACHE_SPILL_SIZE ULONG_MAX
+  ulong message_cache_spill_size_var;
+
+  const char *flow_control_mode_values[3] = {"DISABLED", "PREDICTIVE",
+                                             (char *)nullptr};
+  TYPELIB flow_control_mode_typelib_t = {2, "flow_control_mode_typelib_t",
+                                         flow_control_mode_values, nullptr};
+  ulong flow_control_mode_var;
+
+#define DEFAULT_FLOW_CONTROL_THRESHOLD 25000
+#define MAX_FLOW_CONTROL_THRESHOLD INT_MAX32
+#define MIN_FLOW_CONTROL_THRESHOLD 1
+  long flow_control_applier_threshold_var;
+
   uint xcom_cache_mode_var;
 
   const char *single_primary_election_mode_values[4] = {
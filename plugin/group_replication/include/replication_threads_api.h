@@ -30,6 +30,8 @@
 
 #include "my_inttypes.h"
 
+struct Transaction_dependencies;
+
 #define DEFAULT_THREAD_PRIORITY 0
 // Applier thread InnoDB priority
 #define GROUP_REPLICATION_APPLIER_THREAD_PRIORITY 1
@@ -191,6 +193,19 @@ class Replication_thread_api {
   */
   int queue_packet(const char *buf, ulong event_len, bool io_buffered);
 
+  /**
+    Register the dependencies of a transaction on the channel, before
+    the transaction is queued.
+
+    @param dependencies  the transactions it depends on
+
+    @return the operation status
+      @retval 0      OK
+      @retval != 0   Not registered, its last_committed is used
+  */
+  int add_transaction_dependencies(
+      const Transaction_dependencies &dependencies);
+
   /**
     Checks if the applier, and its workers when parallel applier is
     enabled, has already consumed all relay log, that is, applier is
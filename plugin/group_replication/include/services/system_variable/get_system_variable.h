@@ -33,7 +33,8 @@ class Get_system_variable_parameters : public Mysql_thread_body_parameters {
     VAR_GTID_EXECUTED,
     VAR_GTID_PURGED,
     VAR_READ_ONLY,
-    VAR_SUPER_READ_ONLY
+    VAR_SUPER_READ_ONLY,
+    VAR_CLONE_INCREMENTAL_BASE
   };
 
   Get_system_variable_parameters(System_variable_service service)
@@ -126,6 +127,18 @@ class Get_system_variable : Mysql_thread_body {
     */
   int get_global_super_read_only(bool &value);
 
+  /**
+    Method to return the donor a replaced data directory can be cloned
+    incrementally from, by executing the get_variables component service.
+
+    @param [out] donor_uuid The string where the result will be set
+
+    @return the error value returned
+    @retval 0      OK
+    @retval !=0    Error
+    */
+  int get_global_clone_incremental_base(std::string &donor_uuid);
+
   /**
     Method that will be run on mysql_thread.
 
@@ -111,10 +111,15 @@ enum class Gcs_protocol_version : unsigned short {
   UNKNOWN = 0,
   V1 = 1,
   V2 = 2,
+  V3 = 3,
   /* Define the highest known version. */
-  HIGHEST_KNOWN = V2,
+  HIGHEST_KNOWN = V3,
+  /*
+   Define the version a group starts with. V3 is not understood by stock
+   servers of the same release, so groups only move to it on request.
+  */
+  BOOTSTRAP = V2,
   /* Currently used in test cases. */
-  V3 = 3,
   V4 = 4,
   V5 = 5,
   /*
@@ -340,7 +340,10 @@ void Gcs_packet::deserialize(buffer_ptr &&buffer,
     auto &stage = pipeline.get_stage(stage_code);
     m_stage_metadata.push_back(stage.get_stage_header());
     auto &stage_header = m_stage_metadata.back();
-    processed_size = stage_header->decode(slider);
+    auto const decoded_size =
+        static_cast<unsigned long long>(slider - m_serialized_packet.get());
+    processed_size = stage_header->decode_within(
+        slider, buffer_size > decoded_size ? buffer_size - decoded_size : 0);
     slider += processed_size;
   }
   m_serialized_stage_metadata_size = processed_size;
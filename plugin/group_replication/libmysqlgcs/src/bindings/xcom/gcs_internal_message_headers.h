@@ -91,12 +91,22 @@ enum class Stage_code : unsigned int {
    */
   ST_SPLIT_V2 = 3,
 
+  /*
+   This type represents the zstd compression stage v3.
+   */
+  ST_ZSTD_V3 = 4,
+
+  /*
+   This type represents the split stage v3.
+   */
+  ST_SPLIT_V3 = 5,
+
   /*
    No valid state codes can appear after this one. If a stage code is to
    be added, this value needs to be incremented and the lowest type code
    available be assigned to the new stage.
    */
-  ST_MAX_STAGES = 4
+  ST_MAX_STAGES = 6
 };
 
 /**
@@ -591,6 +601,20 @@ class Gcs_stage_metadata {
    */
   virtual unsigned long long decode(const unsigned char *buffer) = 0;
 
+  /**
+   Decode the contents of the buffer like decode, knowing that it holds at
+   most buffer_length bytes. Metadata with variable length fields overrides
+   it to check those lengths against the buffer.
+
+   @param buffer The buffer to decode from.
+   @param buffer_length Number of bytes left in the buffer.
+   @return Encoded size.
+   */
+  virtual unsigned long long decode_within(
+      const unsigned char *buffer, unsigned long long /* buffer_length */) {
+    return decode(buffer);
+  }
+
   /**
    Create a string representation of the header to be logged.
 
@@ -0,0 +1,563 @@
+/* Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/gcs_message_stage_zstd.h"
+
+#include <zdict.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <unordered_set>
+
+#include "plugin/group_replication/libmysqlgcs/include/mysql/gcs/gcs_logging_system.h"
+#include "plugin/group_replication/libmysqlgcs/include/mysql/gcs/xplatform/byteorder.h"
+#include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/gcs_internal_message.h"
+
+const unsigned short Gcs_zstd_header::WIRE_HD_SENDER_ID_SIZE;
+const unsigned short Gcs_zstd_header::WIRE_HD_DICTIONARY_ID_SIZE;
+const unsigned short Gcs_zstd_header::WIRE_HD_DICTIONARY_LENGTH_SIZE;
+
+static unsigned long long constexpr WIRE_HD_FIXED_SIZE =
+    Gcs_zstd_header::WIRE_HD_SENDER_ID_SIZE +
+    Gcs_zstd_header::WIRE_HD_DICTIONARY_ID_SIZE +
+    Gcs_zstd_header::WIRE_HD_DICTIONARY_LENGTH_SIZE;
+
+std::shared_ptr<Gcs_zstd_dictionary> Gcs_zstd_dictionary::create(
+    uint64_t id, std::vector<unsigned char> &&content, bool compression) {
+  std::shared_ptr<Gcs_zstd_dictionary> dictionary(
+      new Gcs_zstd_dictionary(id, std::move(content)));
+  auto const &data = dictionary->m_content;
+
+  dictionary->m_ddict = ZSTD_createDDict(data.data(), data.size());
+  if (dictionary->m_ddict == nullptr) return nullptr;
+
+  if (compression) {
+    dictionary->m_cdict =
+        ZSTD_createCDict(data.data(), data.size(), ZSTD_CLEVEL_DEFAULT);
+    if (dictionary->m_cdict == nullptr) return nullptr;
+  }
+
+  return dictionary;
+}
+
+Gcs_zstd_dictionary::~Gcs_zstd_dictionary() {
+  ZSTD_freeCDict(m_cdict);
+  ZSTD_freeDDict(m_ddict);
+}
+
+unsigned long long Gcs_zstd_header::encode(unsigned char *buffer) const {
+  unsigned char *slider = buffer;
+
+  uint64_t le_sender_id = htole64(m_sender_id);
+  memcpy(slider, &le_sender_id, WIRE_HD_SENDER_ID_SIZE);
+  slider += WIRE_HD_SENDER_ID_SIZE;
+
+  uint64_t le_dictionary_id = htole64(m_dictionary_id);
+  memcpy(slider, &le_dictionary_id, WIRE_HD_DICTIONARY_ID_SIZE);
+  slider += WIRE_HD_DICTIONARY_ID_SIZE;
+
+  uint32_t le_dictionary_length =
+      htole32(static_cast<uint32_t>(m_dictionary.size()));
+  memcpy(slider, &le_dictionary_length, WIRE_HD_DICTIONARY_LENGTH_SIZE);
+  slider += WIRE_HD_DICTIONARY_LENGTH_SIZE;
+
+  if (!m_dictionary.empty()) {
+    memcpy(slider, m_dictionary.data(), m_dictionary.size());
+    slider += m_dictionary.size();
+  }
+
+  return slider - buffer;
+}
+
+unsigned long long Gcs_zstd_header::decode(const unsigned char *buffer) {
+  return decode_within(buffer, WIRE_HD_FIXED_SIZE +
+                                   Gcs_message_stage_zstd::DICTIONARY_SIZE);
+}
+
+unsigned long long Gcs_zstd_header::decode_within(
+    const unsigned char *buffer, unsigned long long buffer_length) {
+  const unsigned char *slider = buffer;
+
+  m_dictionary.clear();
+  m_malformed = (buffer_length < WIRE_HD_FIXED_SIZE);
+  if (m_malformed) return buffer_length;
+
+  memcpy(&m_sender_id, slider, WIRE_HD_SENDER_ID_SIZE);
+  m_sender_id = le64toh(m_sender_id);
+  slider += WIRE_HD_SENDER_ID_SIZE;
+
+  memcpy(&m_dictionary_id, slider, WIRE_HD_DICTIONARY_ID_SIZE);
+  m_dictionary_id = le64toh(m_dictionary_id);
+  slider += WIRE_HD_DICTIONARY_ID_SIZE;
+
+  uint32_t dictionary_length;
+  memcpy(&dictionary_length, slider, WIRE_HD_DICTIONARY_LENGTH_SIZE);
+  dictionary_length = le32toh(dictionary_length);
+  slider += WIRE_HD_DICTIONARY_LENGTH_SIZE;
+
+  /*
+   A dictionary is never larger than DICTIONARY_SIZE, and must fit in what
+   is left of the packet.
+   */
+  m_malformed = (dictionary_length > Gcs_message_stage_zstd::DICTIONARY_SIZE ||
+                 dictionary_length > buffer_length - WIRE_HD_FIXED_SIZE);
+  if (m_malformed) return WIRE_HD_FIXED_SIZE;
+
+  m_dictionary.assign(slider, slider + dictionary_length);
+  slider += dictionary_length;
+
+  return slider - buffer;
+}
+
+void Gcs_zstd_header::dump(std::ostringstream &output) const {
+  output << "zstd header=<sender id=(" << m_sender_id << "), dictionary id=("
+         << m_dictionary_id << "), dictionary length=(" << m_dictionary.size()
+         << "), header length=(" << calculate_encode_length() << ")>";
+}
+
+Gcs_message_stage_zstd::~Gcs_message_stage_zstd() {
+  if (m_trainer.joinable()) m_trainer.join();
+  for (auto *cctx : m_free_cctxs) ZSTD_freeCCtx(cctx);
+  ZSTD_freeDCtx(m_dctx);
+}
+
+Gcs_message_stage::stage_status Gcs_message_stage_zstd::skip_apply(
+    uint64_t const &original_payload_size) const {
+  if (original_payload_size < m_threshold) {
+    return stage_status::skip;
+  }
+
+  return stage_status::apply;
+}
+
+std::unique_ptr<Gcs_stage_metadata> Gcs_message_stage_zstd::get_stage_header() {
+  return std::unique_ptr<Gcs_stage_metadata>(new Gcs_zstd_header());
+}
+
+Gcs_message_stage_zstd::Gcs_zstd_dictionary_ptr
+Gcs_message_stage_zstd::choose_dictionary(unsigned long long payload_length,
+                                          bool &announce) {
+  /*
+   The announcement must be recoverable from a single synode, so it is only
+   embedded in a packet that is not going to be split.
+   */
+  bool const whole_packet =
+      (m_split_threshold == 0 || payload_length < m_split_threshold);
+  announce = false;
+
+  if (m_announced != nullptr && !m_announcement_sent && whole_packet) {
+    m_announcement_sent = true;
+    announce = true;
+    return m_announced;
+  }
+
+  if (m_reannounce && !m_reannouncement_sent && whole_packet) {
+    m_reannouncement_sent = true;
+    announce = true;
+  }
+  return m_current;
+}
+
+void Gcs_message_stage_zstd::sample_payload(
+    const unsigned char *payload, unsigned long long payload_length) {
+  /*
+   Only train a new dictionary when receivers are guaranteed to still have
+   every dictionary that packets in flight were compressed with, see the
+   class description.
+   */
+  bool const older_in_flight = std::any_of(
+      m_in_flight.cbegin(), m_in_flight.cend(), [this](auto const &entry) {
+        return m_current == nullptr || entry.first != m_current->get_id();
+      });
+  if (m_sender_id == 0 || m_training || m_announced != nullptr ||
+      older_in_flight || m_compressed_since_training < RETRAIN_INTERVAL)
+    return;
+
+  std::size_t const nr_samples = std::max<unsigned long long>(
+      1, std::min<unsigned long long>(SAMPLES_PER_PAYLOAD,
+                                      payload_length / SAMPLE_SIZE));
+  unsigned long long const stride = payload_length / nr_samples;
+  for (std::size_t i = 0; i < nr_samples; i++) {
+    unsigned long long const offset = i * stride;
+    std::size_t const size =
+        std::min<unsigned long long>(SAMPLE_SIZE, payload_length - offset);
+    m_samples.insert(m_samples.end(), payload + offset,
+                     payload + offset + size);
+    m_sample_sizes.push_back(size);
+  }
+  if (m_samples.size() < SAMPLES_SIZE) return;
+
+  /*
+   Training takes a while, so it runs in its own thread, and packets are
+   compressed with the current dictionary meanwhile. The previous training
+   thread is done, since m_training is false, so joining it does not block.
+   */
+  if (m_trainer.joinable()) m_trainer.join();
+  m_training = true;
+  std::vector<unsigned char> samples;
+  std::vector<std::size_t> sample_sizes;
+  samples.swap(m_samples);
+  sample_sizes.swap(m_sample_sizes);
+  m_trainer = std::thread(&Gcs_message_stage_zstd::train_dictionary, this,
+                          m_sender_id, m_next_dictionary_id++,
+                          std::move(samples), std::move(sample_sizes));
+}
+
+void Gcs_message_stage_zstd::train_dictionary(
+    Gcs_sender_id sender_id, uint64_t dictionary_id,
+    std::vector<unsigned char> samples, std::vector<std::size_t> sample_sizes) {
+  std::vector<unsigned char> content(DICTIONARY_SIZE);
+  std::size_t size = ZDICT_trainFromBuffer(
+      content.data(), content.size(), samples.data(), sample_sizes.data(),
+      static_cast<unsigned int>(sample_sizes.size()));
+
+  Gcs_zstd_dictionary_ptr dictionary;
+  if (ZDICT_isError(size)) {
+    MYSQL_GCS_LOG_DEBUG("Could not train a compression dictionary: %s",
+                        ZDICT_getErrorName(size));
+  } else {
+    content.resize(size);
+    dictionary = Gcs_zstd_dictionary::create(
+        dictionary_id, std::move(content), true /* compression */);
+  }
+
+  /* Swap the dictionary in, unless the member left the group meanwhile. */
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_training = false;
+  m_compressed_since_training = 0;
+  if (dictionary == nullptr || sender_id != m_sender_id) return;
+
+  m_announced = std::move(dictionary);
+  m_announcement_sent = false;
+}
+
+std::pair<bool, std::vector<Gcs_packet>>
+Gcs_message_stage_zstd::apply_transformation(Gcs_packet &&packet) {
+  bool constexpr ERROR = true;
+  bool constexpr OK = false;
+  auto result = std::make_pair(ERROR, std::vector<Gcs_packet>());
+  std::vector<Gcs_packet> packets_out;
+  Gcs_zstd_dictionary_ptr dictionary;
+  ZSTD_CCtx *cctx = nullptr;
+  std::size_t compressed_len = 0;
+  bool announce = false;
+
+  /* Get the original payload information. */
+  unsigned long long const original_payload_length =
+      packet.get_payload_length();
+  unsigned char const *original_payload_pointer = packet.get_payload_pointer();
+  auto &header =
+      static_cast<Gcs_zstd_header &>(packet.get_current_stage_header());
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    dictionary = choose_dictionary(original_payload_length, announce);
+    header.set_sender_id(m_sender_id);
+    if (dictionary != nullptr) {
+      header.set_dictionary_id(dictionary->get_id());
+      if (announce) header.set_dictionary(dictionary->get_content());
+      m_in_flight[dictionary->get_id()]++;
+    }
+    if (!m_free_cctxs.empty()) {
+      cctx = m_free_cctxs.back();
+      m_free_cctxs.pop_back();
+    }
+    m_compressed_since_training += original_payload_length;
+    sample_payload(original_payload_pointer, original_payload_length);
+  }
+  if (cctx == nullptr) cctx = ZSTD_createCCtx();
+
+  /* Get an upper-bound on the transformed payload size and create a packet big
+     enough to hold it. The header is copied with the dictionary, if any. */
+  unsigned long long const new_payload_length =
+      ZSTD_compressBound(original_payload_length);
+  bool packet_ok;
+  Gcs_packet new_packet;
+  std::tie(packet_ok, new_packet) =
+      Gcs_packet::make_from_existing_packet(packet, new_payload_length);
+  if (!packet_ok || cctx == nullptr) goto end;
+
+  /* Compress the old payload into the new packet. */
+  if (dictionary != nullptr) {
+    compressed_len = ZSTD_compress_usingCDict(
+        cctx, new_packet.get_payload_pointer(), new_payload_length,
+        original_payload_pointer, original_payload_length,
+        dictionary->get_cdict());
+  } else {
+    compressed_len = ZSTD_compressCCtx(
+        cctx, new_packet.get_payload_pointer(), new_payload_length,
+        original_payload_pointer, original_payload_length, ZSTD_CLEVEL_DEFAULT);
+  }
+  if (ZSTD_isError(compressed_len)) {
+    MYSQL_GCS_LOG_ERROR("Error compressing payload of size "
+                        << original_payload_length << ": "
+                        << ZSTD_getErrorName(compressed_len));
+    goto end;
+  }
+  MYSQL_GCS_LOG_TRACE("Compressing payload from size %llu to output %llu.",
+                      original_payload_length,
+                      static_cast<unsigned long long>(compressed_len))
+
+  /* Since the actual compressed payload size may be smaller than the estimate
+     given by ZSTD_compressBound, update the packet information accordingly. */
+  new_packet.set_payload_length(compressed_len);
+
+  packets_out.push_back(std::move(new_packet));
+  result = std::make_pair(OK, std::move(packets_out));
+
+end:
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (cctx != nullptr) m_free_cctxs.push_back(cctx);
+  if (result.first == ERROR && dictionary != nullptr) {
+    /* purecov: begin inspected */
+    if (--m_in_flight[dictionary->get_id()] == 0)
+      m_in_flight.erase(dictionary->get_id());
+    if (announce && dictionary == m_announced) m_announcement_sent = false;
+    if (announce && dictionary == m_current) m_reannouncement_sent = false;
+    /* purecov: end */
+  }
+  return result;
+}
+
+bool Gcs_message_stage_zstd::install_dictionary(Gcs_zstd_header &header,
+                                                const Gcs_xcom_synode &synode) {
+  Gcs_sender_id const sender_id = header.get_sender_id();
+  uint64_t const dictionary_id = header.get_dictionary_id();
+  auto &dictionaries = m_received[sender_id];
+
+  if (sender_id == m_sender_id) {
+    /*
+     The announcement of one of our dictionaries was delivered: start
+     compressing with it, or remember it was announced again.
+     */
+    if (m_announced != nullptr && m_announced->get_id() == dictionary_id) {
+      m_previous = std::move(m_current);
+      m_previous_synode = m_current_synode;
+      m_current = std::move(m_announced);
+      m_announced = nullptr;
+      dictionaries.push_back(m_current);
+    } else if (m_current == nullptr || m_current->get_id() != dictionary_id) {
+      return false;
+    }
+    m_current_synode = synode;
+    m_delivered_since_announcement = 0;
+    m_reannounce = false;
+    m_reannouncement_sent = false;
+  } else {
+    bool const known = std::any_of(dictionaries.cbegin(), dictionaries.cend(),
+                                   [dictionary_id](auto const &d) {
+                                     return d->get_id() == dictionary_id;
+                                   });
+    if (known) return false;
+
+    auto dictionary = Gcs_zstd_dictionary::create(
+        dictionary_id, std::move(header.get_dictionary()),
+        false /* compression */);
+    if (dictionary == nullptr) return true;
+    dictionaries.push_back(std::move(dictionary));
+  }
+
+  /*
+   Announcements recovered when joining are not processed in order, so drop
+   the oldest dictionary by its identifier.
+   */
+  while (dictionaries.size() > 2) {
+    dictionaries.erase(std::min_element(
+        dictionaries.begin(), dictionaries.end(),
+        [](auto const &a, auto const &b) {
+          return a->get_id() < b->get_id();
+        }));
+  }
+  return false;
+}
+
+std::pair<Gcs_pipeline_incoming_result, Gcs_packet>
+Gcs_message_stage_zstd::revert_transformation(Gcs_packet &&packet) {
+  auto &dynamic_header = packet.get_current_dynamic_header();
+  auto &header =
+      static_cast<Gcs_zstd_header &>(packet.get_current_stage_header());
+  auto result =
+      std::make_pair(Gcs_pipeline_incoming_result::ERROR, Gcs_packet());
+  Gcs_zstd_dictionary_ptr dictionary;
+  std::size_t uncompressed_len = 0;
+
+  /* Get the compressed payload information. */
+  unsigned long long const original_payload_length =
+      packet.get_payload_length();
+  unsigned char const *original_payload_pointer = packet.get_payload_pointer();
+  Gcs_sender_id const sender_id = header.get_sender_id();
+  uint64_t const dictionary_id = header.get_dictionary_id();
+
+  if (header.is_malformed()) {
+    MYSQL_GCS_LOG_ERROR("Discarding a packet of sender "
+                        << sender_id << " with a malformed zstd header");
+    goto end;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!header.get_dictionary().empty() &&
+        install_dictionary(header, packet.get_delivery_synode())) {
+      MYSQL_GCS_LOG_ERROR("Could not load the compression dictionary "
+                          << dictionary_id << " of sender " << sender_id);
+      goto end;
+    }
+
+    if (dictionary_id != 0) {
+      for (auto const &d : m_received[sender_id]) {
+        if (d->get_id() == dictionary_id) dictionary = d;
+      }
+    }
+
+    auto const in_flight = m_in_flight.find(dictionary_id);
+    if (sender_id == m_sender_id && in_flight != m_in_flight.end() &&
+        --in_flight->second == 0) {
+      m_in_flight.erase(in_flight);
+    }
+
+    m_delivered_since_announcement += original_payload_length;
+    if (m_current != nullptr &&
+        m_delivered_since_announcement >= REANNOUNCE_INTERVAL) {
+      m_reannounce = true;
+    }
+  }
+
+  if (dictionary_id != 0 && dictionary == nullptr) {
+    MYSQL_GCS_LOG_ERROR("Unknown compression dictionary "
+                        << dictionary_id << " of sender " << sender_id);
+    goto end;
+  }
+
+  {
+    /*
+     Create a packet big enough to hold the uncompressed payload.
+
+     The size of the uncompressed payload is stored in the dynamic header, i.e.
+     the payload size before the stage was applied.
+     */
+    unsigned long long expected_new_payload_length =
+        dynamic_header.get_payload_length();
+    bool packet_ok;
+    Gcs_packet new_packet;
+    std::tie(packet_ok, new_packet) = Gcs_packet::make_from_existing_packet(
+        packet, expected_new_payload_length);
+    if (!packet_ok) goto end;
+
+    if (m_dctx == nullptr) m_dctx = ZSTD_createDCtx();
+    if (m_dctx == nullptr) goto end;
+
+    /* Decompress the payload into the new packet. */
+    if (dictionary != nullptr) {
+      uncompressed_len = ZSTD_decompress_usingDDict(
+          m_dctx, new_packet.get_payload_pointer(),
+          expected_new_payload_length, original_payload_pointer,
+          original_payload_length, dictionary->get_ddict());
+    } else {
+      uncompressed_len = ZSTD_decompressDCtx(
+          m_dctx, new_packet.get_payload_pointer(),
+          expected_new_payload_length, original_payload_pointer,
+          original_payload_length);
+    }
+
+    if (ZSTD_isError(uncompressed_len) ||
+        uncompressed_len != expected_new_payload_length) {
+      MYSQL_GCS_LOG_ERROR("Error decompressing payload from size "
+                          << original_payload_length << " to "
+                          << expected_new_payload_length);
+      goto end;
+    }
+    MYSQL_GCS_LOG_TRACE(
+        "Decompressing payload from size %llu to output %llu.",
+        original_payload_length,
+        static_cast<unsigned long long>(uncompressed_len))
+
+    result = std::make_pair(Gcs_pipeline_incoming_result::OK_PACKET,
+                            std::move(new_packet));
+  }
+
+end:
+  return result;
+}
+
+Gcs_message_stage::stage_status Gcs_message_stage_zstd::skip_revert(
+    const Gcs_packet &) const {
+  return stage_status::apply;
+}
+
+void Gcs_message_stage_zstd::reset_sender() {
+  m_current = nullptr;
+  m_previous = nullptr;
+  m_announced = nullptr;
+  m_announcement_sent = false;
+  m_reannounce = false;
+  m_reannouncement_sent = false;
+  m_in_flight.clear();
+  m_compressed_since_training = RETRAIN_INTERVAL;
+  m_delivered_since_announcement = 0;
+  m_samples.clear();
+  m_sample_sizes.clear();
+}
+
+bool Gcs_message_stage_zstd::update_members_information(
+    const Gcs_member_identifier &me, const Gcs_xcom_nodes &xcom_nodes) {
+  std::unordered_set<Gcs_sender_id> sender_ids;
+  for (const auto &node : xcom_nodes.get_nodes()) {
+    sender_ids.insert(calculate_sender_id(node));
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const Gcs_xcom_node_information *const local_node = xcom_nodes.get_node(me);
+  Gcs_sender_id const sender_id = calculate_sender_id(*local_node);
+  if (sender_id != m_sender_id) {
+    reset_sender();
+    m_sender_id = sender_id;
+  }
+
+  /*
+   Forget the dictionaries of members that left the group.
+   */
+  for (auto it = m_received.begin(); it != m_received.end();) {
+    if (sender_ids.find(it->first) == sender_ids.end()) {
+      it = m_received.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  return false;
+}
+
+Gcs_xcom_synode_set Gcs_message_stage_zstd::get_snapshot() const {
+  Gcs_xcom_synode_set announcements;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_current != nullptr) {
+    announcements.insert(m_current_synode);
+  }
+  if (m_previous != nullptr &&
+      m_in_flight.find(m_previous->get_id()) != m_in_flight.end()) {
+    announcements.insert(m_previous_synode);
+  }
+  return announcements;
+}
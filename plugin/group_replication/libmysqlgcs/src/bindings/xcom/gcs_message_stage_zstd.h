@@ -0,0 +1,444 @@
+/* Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef GCS_MESSAGE_STAGE_ZSTD_H
+#define GCS_MESSAGE_STAGE_ZSTD_H
+
+#include <zstd.h>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "plugin/group_replication/libmysqlgcs/include/mysql/gcs/gcs_types.h"
+#include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/gcs_message_stage_split.h"
+#include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/gcs_message_stages.h"
+
+/**
+  A compression dictionary trained by a member from the payloads it sent.
+  Instances are immutable and shared between the threads that compress or
+  decompress with them.
+ */
+class Gcs_zstd_dictionary {
+ public:
+  /**
+   Create a dictionary.
+
+   @param id Identifier, unique among the dictionaries of the sender
+   @param content Dictionary content as returned by ZDICT_trainFromBuffer
+   @param compression Whether the dictionary is also used to compress
+   @return the dictionary, or nullptr if zstd could not load it
+   */
+  static std::shared_ptr<Gcs_zstd_dictionary> create(
+      uint64_t id, std::vector<unsigned char> &&content, bool compression);
+
+  ~Gcs_zstd_dictionary();
+
+  Gcs_zstd_dictionary(const Gcs_zstd_dictionary &) = delete;
+  Gcs_zstd_dictionary &operator=(const Gcs_zstd_dictionary &) = delete;
+
+  uint64_t get_id() const { return m_id; }
+
+  const std::vector<unsigned char> &get_content() const { return m_content; }
+
+  const ZSTD_CDict *get_cdict() const { return m_cdict; }
+
+  const ZSTD_DDict *get_ddict() const { return m_ddict; }
+
+ private:
+  Gcs_zstd_dictionary(uint64_t id, std::vector<unsigned char> &&content)
+      : m_id(id), m_content(std::move(content)) {}
+
+  uint64_t m_id;
+  std::vector<unsigned char> m_content;
+  ZSTD_CDict *m_cdict{nullptr};
+  ZSTD_DDict *m_ddict{nullptr};
+};
+
+/**
+  Metadata of the zstd stage, with the following format:
+
+  --------------------------------------------------------------------
+  | Sender Id | Dictionary Id | Dictionary Length | Dictionary        |
+  --------------------------------------------------------------------
+
+  . Sender Id - Identifier of the member that compressed the payload, see
+    calculate_sender_id.
+
+  . Dictionary Id - Dictionary the payload was compressed with, 0 if none.
+
+  . Dictionary Length - Length of the next field, 0 unless the packet
+    announces the dictionary.
+
+  . Dictionary - Content of the dictionary when the packet announces it.
+*/
+class Gcs_zstd_header : public Gcs_stage_metadata {
+ public:
+  /**
+   On-the-wire field size for the sender identification.
+   */
+  static const unsigned short WIRE_HD_SENDER_ID_SIZE = 8;
+
+  /**
+   On-the-wire field size for the dictionary identification.
+   */
+  static const unsigned short WIRE_HD_DICTIONARY_ID_SIZE = 8;
+
+  /**
+   On-the-wire field size for the dictionary length.
+   */
+  static const unsigned short WIRE_HD_DICTIONARY_LENGTH_SIZE = 4;
+
+  explicit Gcs_zstd_header() = default;
+
+  std::unique_ptr<Gcs_stage_metadata> clone() override {
+    return std::unique_ptr<Gcs_zstd_header>(new Gcs_zstd_header(*this));
+  }
+
+  unsigned long long calculate_encode_length() const override {
+    return WIRE_HD_SENDER_ID_SIZE + WIRE_HD_DICTIONARY_ID_SIZE +
+           WIRE_HD_DICTIONARY_LENGTH_SIZE + m_dictionary.size();
+  }
+
+  unsigned long long encode(unsigned char *buffer) const override;
+
+  unsigned long long decode(const unsigned char *buffer) override;
+
+  /**
+   Decode the header, and mark it as malformed instead of reading past the
+   buffer or loading an oversized dictionary if the dictionary length it
+   carries is not valid.
+   */
+  unsigned long long decode_within(const unsigned char *buffer,
+                                   unsigned long long buffer_length) override;
+
+  void dump(std::ostringstream &output) const override;
+
+  void set_sender_id(const Gcs_sender_id &sender_id) {
+    m_sender_id = sender_id;
+  }
+
+  const Gcs_sender_id &get_sender_id() const { return m_sender_id; }
+
+  void set_dictionary_id(uint64_t dictionary_id) {
+    m_dictionary_id = dictionary_id;
+  }
+
+  uint64_t get_dictionary_id() const { return m_dictionary_id; }
+
+  /**
+   Embed the content of the dictionary, i.e. announce it.
+   */
+  void set_dictionary(const std::vector<unsigned char> &dictionary) {
+    m_dictionary = dictionary;
+  }
+
+  std::vector<unsigned char> &get_dictionary() { return m_dictionary; }
+
+  bool is_malformed() const { return m_malformed; }
+
+ private:
+  Gcs_sender_id m_sender_id{0};
+
+  uint64_t m_dictionary_id{0};
+
+  std::vector<unsigned char> m_dictionary;
+
+  bool m_malformed{false};
+};
+
+/**
+  This class implements zstd compression with a dictionary trained from the
+  payloads the member sends.
+
+  While there is no dictionary, payloads are compressed without one. After
+  RETRAIN_INTERVAL bytes have been compressed, slices of the next payloads
+  are sampled and, once SAMPLES_SIZE bytes are collected, a new dictionary
+  is trained from them by a background thread, so that the thread sending
+  the message does not wait for the training.
+
+  Dictionaries are distributed in band. A new dictionary is announced by
+  embedding it in the header of a packet compressed with it, and the member
+  only compresses with it once the announcement has been delivered back to
+  it, so every member has the dictionary before it sees a packet that
+  needs it. Receivers keep the two last dictionaries of each sender, since
+  packets compressed with the previous dictionary may still be ordered
+  after the announcement of the new one. A sender only starts sampling for
+  a new dictionary once none of those packets is left in flight.
+
+  A joining member did not see the announcements, so the synodes of the
+  announcements of the dictionaries in use are part of the snapshot of the
+  stage and are recovered from the XCom cache of a donor when the member
+  joins. To keep them in the cache, the current dictionary is announced
+  again once REANNOUNCE_INTERVAL bytes went through the stage since it was
+  last announced.
+
+  Announcements are never fragmented, as they are only embedded in packets
+  whose payload is smaller than the split threshold.
+ */
+class Gcs_message_stage_zstd : public Gcs_message_stage {
+ public:
+  /*
+   Methods inherited from the Gcs_message_stage class.
+   */
+  Gcs_message_stage::stage_status skip_apply(
+      uint64_t const &original_payload_size) const override;
+
+  std::unique_ptr<Gcs_stage_metadata> get_stage_header() override;
+
+  bool update_members_information(const Gcs_member_identifier &me,
+                                  const Gcs_xcom_nodes &xcom_nodes) override;
+
+  Gcs_xcom_synode_set get_snapshot() const override;
+
+ protected:
+  std::pair<bool, std::vector<Gcs_packet>> apply_transformation(
+      Gcs_packet &&packet) override;
+
+  std::pair<Gcs_pipeline_incoming_result, Gcs_packet> revert_transformation(
+      Gcs_packet &&packet) override;
+
+  Gcs_message_stage::stage_status skip_revert(
+      const Gcs_packet &packet) const override;
+
+ public:
+  /**
+   The default threshold value in bytes.
+   */
+  static constexpr unsigned long long DEFAULT_THRESHOLD = 1024;
+
+  /**
+   Maximum size of a trained dictionary.
+   */
+  static constexpr std::size_t DICTIONARY_SIZE = 16 * 1024;
+
+  /**
+   Size of a sample, and number of samples taken from a payload.
+   */
+  static constexpr std::size_t SAMPLE_SIZE = 4 * 1024;
+  static constexpr std::size_t SAMPLES_PER_PAYLOAD = 8;
+
+  /**
+   Bytes sampled to train a dictionary.
+   */
+  static constexpr std::size_t SAMPLES_SIZE = 100 * DICTIONARY_SIZE;
+
+  /**
+   Bytes compressed with a dictionary before a new one is trained.
+   */
+  static constexpr unsigned long long RETRAIN_INTERVAL = 256ULL << 20;
+
+  /**
+   Bytes that go through the stage before the current dictionary is
+   announced again.
+   */
+  static constexpr unsigned long long REANNOUNCE_INTERVAL = 32ULL << 20;
+
+  /**
+   Creates an instance of the stage.
+
+   @param enabled enables this message stage
+   @param compress_threshold messages with the payload larger
+                             than compress_threshold in bytes are compressed.
+   @param split_threshold messages with the payload larger than
+                          split_threshold in bytes are split, 0 if
+                          fragmentation is disabled.
+   */
+  explicit Gcs_message_stage_zstd(bool enabled,
+                                  unsigned long long compress_threshold,
+                                  unsigned long long split_threshold)
+      : Gcs_message_stage(enabled),
+        m_threshold(compress_threshold),
+        m_split_threshold(split_threshold) {}
+
+  ~Gcs_message_stage_zstd() override;
+
+  /*
+   Return the stage code.
+   */
+  Stage_code get_stage_code() const override { return Stage_code::ST_ZSTD_V3; }
+
+  /**
+    Sets the threshold in bytes after which compression kicks in.
+
+    @param threshold if the payload exceeds these many bytes, then
+                     the message is compressed.
+   */
+  void set_threshold(unsigned long long threshold) { m_threshold = threshold; }
+
+ private:
+  using Gcs_zstd_dictionary_ptr = std::shared_ptr<Gcs_zstd_dictionary>;
+
+  /**
+   Pick the dictionary to compress a payload with, and decide whether the
+   packet announces it. Must be called with m_mutex held.
+   */
+  Gcs_zstd_dictionary_ptr choose_dictionary(
+      unsigned long long payload_length, bool &announce);
+
+  /**
+   Sample a payload to train the next dictionary. When enough bytes are
+   sampled, the training thread is started. Must be called with m_mutex
+   held.
+
+   @param payload Payload to sample
+   @param payload_length Length of the payload
+   */
+  void sample_payload(const unsigned char *payload,
+                      unsigned long long payload_length);
+
+  /**
+   Train a dictionary from the samples and make it the next one to be
+   announced. Runs in m_trainer, without m_mutex held while training.
+
+   @param sender_id Identifier of this member when sampling started
+   @param dictionary_id Identifier of the new dictionary
+   @param samples Samples, concatenated
+   @param sample_sizes Size of each sample
+   */
+  void train_dictionary(Gcs_sender_id sender_id, uint64_t dictionary_id,
+                        std::vector<unsigned char> samples,
+                        std::vector<std::size_t> sample_sizes);
+
+  /**
+   Store a dictionary announced by a sender. Must be called with m_mutex
+   held.
+
+   @param header Header of the announcing packet
+   @param synode Synode the announcement was delivered in
+   @return false on success, true if the dictionary could not be loaded
+   */
+  bool install_dictionary(Gcs_zstd_header &header,
+                          const Gcs_xcom_synode &synode);
+
+  /**
+   Forget the dictionaries of this member, e.g. because it rejoined the group
+   with a new identifier. Must be called with m_mutex held.
+   */
+  void reset_sender();
+
+  /**
+   This marks the threshold in bytes above which a message gets compressed.
+   */
+  unsigned long long m_threshold{DEFAULT_THRESHOLD};
+
+  /**
+   Threshold above which messages are split, 0 if they are never split.
+   */
+  unsigned long long m_split_threshold{0};
+
+  /**
+   Protects the members below. Compression and decompression happen without
+   holding it.
+   */
+  mutable std::mutex m_mutex;
+
+  /**
+   Identifier of this member as a sender, 0 until it is known.
+   */
+  Gcs_sender_id m_sender_id{0};
+
+  /**
+   Dictionaries announced by each sender, oldest first.
+   */
+  std::map<Gcs_sender_id, std::deque<Gcs_zstd_dictionary_ptr>> m_received;
+
+  /**
+   Dictionary this member compresses with, and the synode of its last
+   announcement.
+   */
+  Gcs_zstd_dictionary_ptr m_current;
+  Gcs_xcom_synode m_current_synode;
+
+  /**
+   Dictionary this member compressed with before m_current, and the synode
+   of its last announcement.
+   */
+  Gcs_zstd_dictionary_ptr m_previous;
+  Gcs_xcom_synode m_previous_synode;
+
+  /**
+   A new dictionary that is announced, or is to be announced, but whose
+   announcement was not delivered yet.
+   */
+  Gcs_zstd_dictionary_ptr m_announced;
+  bool m_announcement_sent{false};
+
+  /**
+   Whether m_current is to be announced again, and whether that
+   announcement was sent.
+   */
+  bool m_reannounce{false};
+  bool m_reannouncement_sent{false};
+
+  /**
+   Packets of this member compressed with each dictionary, and not delivered
+   yet. Dictionaries without such packets have no entry.
+   */
+  std::map<uint64_t, unsigned long long> m_in_flight;
+
+  /**
+   Bytes compressed since the last dictionary was trained.
+   */
+  unsigned long long m_compressed_since_training{RETRAIN_INTERVAL};
+
+  /**
+   Bytes that went through the stage since m_current was announced.
+   */
+  unsigned long long m_delivered_since_announcement{0};
+
+  /**
+   Samples collected for the next dictionary.
+   */
+  std::vector<unsigned char> m_samples;
+  std::vector<std::size_t> m_sample_sizes;
+  bool m_training{false};
+
+  /**
+   Thread that trains the next dictionary, joined before the next training
+   starts and when the stage is destroyed.
+   */
+  std::thread m_trainer;
+
+  /**
+   Identifier of the next dictionary of this member.
+   */
+  uint64_t m_next_dictionary_id{1};
+
+  /**
+   Compression contexts not in use, kept to be reused by the next packets.
+   */
+  std::vector<ZSTD_CCtx *> m_free_cctxs;
+
+  /**
+   Decompression context. Packets are only reverted by the GCS thread, so it
+   is used without holding m_mutex.
+   */
+  ZSTD_DCtx *m_dctx{nullptr};
+};
+
+#endif /* GCS_MESSAGE_STAGE_ZSTD_H */
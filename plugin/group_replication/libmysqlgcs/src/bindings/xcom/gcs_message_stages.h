@@ -387,7 +387,7 @@ class Gcs_message_pipeline {
   explicit Gcs_message_pipeline()
       : m_handlers(),
         m_pipelines(),
-        m_pipeline_version(Gcs_protocol_version::HIGHEST_KNOWN) {}
+        m_pipeline_version(Gcs_protocol_version::BOOTSTRAP) {}
 
   Gcs_message_pipeline(Gcs_message_pipeline &p) = delete;
 
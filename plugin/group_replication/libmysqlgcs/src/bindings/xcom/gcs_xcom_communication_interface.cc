@@ -316,6 +316,9 @@ Gcs_xcom_communication::process_recovered_packet(
    The pipeline should process the packet successfully and *not* output
    packets, because the packet we sent through the pipeline is supposed to be
    a fragment.
+   The exception is a whole packet that carries state a stage needs, e.g. the
+   announcement of a compression dictionary. Its message was delivered before
+   this server joined, so it is dropped.
    But rather than asserting that, treat it as a failure if it does not
    happen.
    */
@@ -323,8 +326,13 @@ Gcs_xcom_communication::process_recovered_packet(
     case Gcs_pipeline_incoming_result::OK_NO_PACKET:
       break;
     case Gcs_pipeline_incoming_result::OK_PACKET:
-      result = packet_recovery_result::PIPELINE_UNEXPECTED_OUTPUT;
-      goto end;
+      if (packet_in.get_dynamic_headers().empty() ||
+          packet_in.get_dynamic_headers().front().get_stage_code() !=
+              Stage_code::ST_ZSTD_V3) {
+        result = packet_recovery_result::PIPELINE_UNEXPECTED_OUTPUT;
+        goto end;
+      }
+      break;
     /* purecov: begin inspected */
     case Gcs_pipeline_incoming_result::ERROR:
       result = packet_recovery_result::PIPELINE_ERROR;
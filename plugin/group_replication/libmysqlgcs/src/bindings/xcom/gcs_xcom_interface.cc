@@ -38,6 +38,7 @@
 #include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/gcs_internal_message.h"
 #include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/gcs_message_stage_lz4.h"
 #include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/gcs_message_stage_split.h"
+#include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/gcs_message_stage_zstd.h"
 #include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/gcs_message_stages.h"
 #include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/gcs_xcom_group_member_information.h"
 #include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/gcs_xcom_networking.h"
@@ -887,9 +888,31 @@ bool Gcs_xcom_interface::initialize_xcom(
       interface_params.get_parameter("ip_allowlist");
   const std::string *xcom_cache_size_str =
       interface_params.get_parameter("xcom_cache_size");
+  const std::string *xcom_cache_spill_size_str =
+      interface_params.get_parameter("xcom_cache_spill_size");
+  const std::string *xcom_cache_spill_file_str =
+      interface_params.get_parameter("xcom_cache_spill_file");
   const std::string *comm_stack_str =
       interface_params.get_parameter("communication_stack");
 
+  /*
+    Set up the cache spill file first, so that failing to create it does
+    not leave anything else configured behind.
+  */
+  if (xcom_cache_spill_size_str != nullptr &&
+      xcom_cache_spill_file_str != nullptr) {
+    if (m_gcs_xcom_app_cfg.set_xcom_cache_spill(
+            (uint64_t)atoll(xcom_cache_spill_size_str->c_str()),
+            *xcom_cache_spill_file_str)) {
+      MYSQL_GCS_LOG_ERROR("Unable to set up the XCom cache spill file "
+                          << xcom_cache_spill_file_str->c_str() << " of "
+                          << xcom_cache_spill_size_str->c_str() << " bytes.")
+      return true;
+    }
+    MYSQL_GCS_LOG_DEBUG("Configured XCom cache spill size: %s",
+                        xcom_cache_spill_size_str->c_str());
+  }
+
   set_xcom_group_information(*group_name);
 
   initialize_peer_nodes(peers);
@@ -1204,6 +1227,8 @@ enum_gcs_error Gcs_xcom_interface::configure_message_stages(
   pipeline.register_stage<Gcs_message_stage_lz4>(compression_enabled, compression_threshold);
   pipeline.register_stage<Gcs_message_stage_lz4_v2>(compression_enabled, compression_threshold);
   pipeline.register_stage<Gcs_message_stage_split_v2>(fragmentation_enabled, fragmentation_threshold);
+  pipeline.register_stage<Gcs_message_stage_zstd>(compression_enabled, compression_threshold, fragmentation_enabled ? fragmentation_threshold : 0);
+  pipeline.register_stage<Gcs_message_stage_split_v3>(fragmentation_enabled, fragmentation_threshold);
 
   error = pipeline.register_pipeline({
     {
@@ -1218,6 +1243,13 @@ enum_gcs_error Gcs_xcom_interface::configure_message_stages(
         Stage_code::ST_LZ4_V2,
         Stage_code::ST_SPLIT_V2
       }
+    },
+    {
+      Gcs_protocol_version::V3,
+      {
+        Stage_code::ST_ZSTD_V3,
+        Stage_code::ST_SPLIT_V3
+      }
     }
   });
   // clang-format on
@@ -27,6 +27,7 @@
 #include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/gcs_xcom_utils.h"
 #include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/xcom/app_data.h"
 #include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/xcom/synode_no.h"
+#include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/xcom/xcom_cache.h"
 #include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/xcom/xcom_cfg.h"
 
 #include "plugin/group_replication/libmysqlgcs/src/bindings/xcom/xcom/network/include/network_management_interface.h"
@@ -543,7 +544,10 @@ xcom_input_request_ptr Gcs_xcom_proxy_impl::xcom_input_try_pop() {
 
 void Gcs_xcom_app_cfg::init() { ::init_cfg_app_xcom(); }
 
-void Gcs_xcom_app_cfg::deinit() { ::deinit_cfg_app_xcom(); }
+void Gcs_xcom_app_cfg::deinit() {
+  ::cache_spill_deinit();
+  ::deinit_cfg_app_xcom();
+}
 
 void Gcs_xcom_app_cfg::set_poll_spin_loops(unsigned int loops) {
   if (the_app_xcom_cfg) the_app_xcom_cfg->m_poll_spin_loops = loops;
@@ -553,6 +557,23 @@ void Gcs_xcom_app_cfg::set_xcom_cache_size(uint64_t size) {
   if (the_app_xcom_cfg) the_app_xcom_cfg->m_cache_limit = size;
 }
 
+bool Gcs_xcom_app_cfg::set_xcom_cache_spill(uint64_t size,
+                                            const std::string &file_name) {
+  bool constexpr kError = true;
+  bool constexpr kSuccess = false;
+
+  if (the_app_xcom_cfg == nullptr) return kError;
+
+  the_app_xcom_cfg->m_cache_spill_limit = 0;
+  if (size == 0) return kSuccess;
+  if (file_name.empty() || file_name.size() >= MAX_CACHE_SPILL_FILE_LEN)
+    return kError;
+
+  the_app_xcom_cfg->m_cache_spill_limit = size;
+  strcpy(the_app_xcom_cfg->m_cache_spill_file, file_name.c_str());
+  return ::cache_spill_init() != 0 ? kError : kSuccess;
+}
+
 void Gcs_xcom_app_cfg::set_network_namespace_manager(
     Network_namespace_manager *ns_mgr) {
   if (the_app_xcom_cfg) the_app_xcom_cfg->network_ns_manager = ns_mgr;
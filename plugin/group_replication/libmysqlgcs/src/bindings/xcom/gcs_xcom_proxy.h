@@ -1016,6 +1016,16 @@ class Gcs_xcom_app_cfg {
    */
   void set_xcom_cache_size(uint64_t size);
 
+  /**
+    Configures the file that decided messages evicted from the xcom cache
+    are spilled to. The file is created, allocated and mapped right away.
+    @param size the size of the file, 0 to disable spilling.
+    @param file_name the name of the file.
+    @retval true if the file could not be set up
+    @retval false otherwise
+   */
+  bool set_xcom_cache_spill(uint64_t size, const std::string &file_name);
+
   /**
    Configures XCom with its unique instance identifier, i.e. its (address,
    incarnation) pair.
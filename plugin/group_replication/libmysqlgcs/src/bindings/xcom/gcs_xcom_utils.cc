@@ -172,6 +172,8 @@ void fix_parameters_syntax(Gcs_interface_parameters &interface_params) {
       interface_params.get_parameter("fragmentation_threshold"));
   std::string *xcom_cache_size_str = const_cast<std::string *>(
       interface_params.get_parameter("xcom_cache_size"));
+  std::string *xcom_cache_spill_size_str = const_cast<std::string *>(
+      interface_params.get_parameter("xcom_cache_spill_size"));
   std::string *communication_stack_str = const_cast<std::string *>(
       interface_params.get_parameter("communication_stack"));
 
@@ -265,6 +267,11 @@ void fix_parameters_syntax(Gcs_interface_parameters &interface_params) {
     interface_params.add_parameter("xcom_cache_size",
                                    std::to_string(DEFAULT_XCOM_MAX_CACHE_SIZE));
   }
+
+  // spilling evicted XCom cache entries is disabled by default
+  if (!xcom_cache_spill_size_str) {
+    interface_params.add_parameter("xcom_cache_spill_size", "0");
+  }
 }
 
 static enum_gcs_error is_valid_flag(const std::string param,
@@ -363,6 +370,8 @@ bool is_parameters_syntax_correct(
       interface_params.get_parameter("fragmentation");
   const std::string *xcom_cache_size_str =
       interface_params.get_parameter("xcom_cache_size");
+  const std::string *xcom_cache_spill_size_str =
+      interface_params.get_parameter("xcom_cache_spill_size");
   const std::string *communication_stack_str =
       interface_params.get_parameter("communication_stack");
 
@@ -657,6 +666,21 @@ bool is_parameters_syntax_correct(
     goto end;
   }
 
+  // Validate XCom cache spill size
+  errno = 0;
+  if (xcom_cache_spill_size_str != nullptr &&
+      (xcom_cache_spill_size_str->size() == 0 ||
+       !is_number(*xcom_cache_spill_size_str) ||
+       (strtoull(xcom_cache_spill_size_str->c_str(), nullptr, 10) >
+        ULONG_MAX) ||
+       errno == ERANGE)) {
+    MYSQL_GCS_LOG_ERROR("The xcom_cache_spill_size parameter ("
+                        << xcom_cache_spill_size_str->c_str()
+                        << ") is not valid.")
+    error = GCS_NOK;
+    goto end;
+  }
+
 end:
   delete sock_probe_interface;
   return error == GCS_NOK ? false : true;
@@ -671,8 +695,10 @@ std::string gcs_protocol_to_mysql_version(Gcs_protocol_version protocol) {
     case Gcs_protocol_version::V2:
       version = "8.0.16";
       break;
-    case Gcs_protocol_version::UNKNOWN:
     case Gcs_protocol_version::V3:
+      version = "8.0.40";
+      break;
+    case Gcs_protocol_version::UNKNOWN:
     case Gcs_protocol_version::V4:
     case Gcs_protocol_version::V5:
       /* This should not happen... */
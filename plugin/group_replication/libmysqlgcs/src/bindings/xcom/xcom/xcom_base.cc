@@ -316,6 +316,7 @@
 
 #endif
 
+#include <atomic>
 #include <chrono>
 #include <future>
 
@@ -883,9 +884,16 @@ void set_xcom_input_try_pop_cb(xcom_input_try_pop_cb pop) {
  * input_signal_connection_pipe is the connection_descriptor that holds the read
  * side of a pipe connection. It is only allocated when we are able to have
  * a pipe connection.
+ *
+ * input_signal_pending is set by the first producer that signals after
+ * local_server_task woke up, and cleared by local_server_task before it
+ * drains the queue. While it is set, local_server_task is guaranteed to see
+ * every request already in the queue, so producers skip the write. Under load
+ * this turns one write per request into one write per batch of requests.
  */
 
 static connection_descriptor *input_signal_connection{nullptr};
+static std::atomic<bool> input_signal_pending{false};
 
 connection_descriptor *input_signal_connection_pipe{nullptr};
 int pipe_signal_connections[2] = {-1, -1};
@@ -930,6 +938,7 @@ bool_t xcom_input_new_signal_connection(char const *address, xcom_port port) {
   bool_t const SUCCESSFUL = TRUE;
   bool_t const UNSUCCESSFUL = FALSE;
   assert(input_signal_connection == nullptr);
+  input_signal_pending.store(false);
 
   if (input_signal_connection_pipe != nullptr) {
     input_signal_connection =
@@ -987,6 +996,9 @@ bool_t xcom_input_new_signal_connection(char const *address, xcom_port port) {
 bool_t xcom_input_signal() {
   bool_t successful = FALSE;
   if (input_signal_connection != nullptr) {
+    /* local_server_task has not drained the queue since the last signal. */
+    if (input_signal_pending.exchange(true)) return TRUE;
+
     unsigned char tiny_buf[1] = {0};
     int64_t error_code;
     connnection_write_method to_write_function =
@@ -996,6 +1008,7 @@ bool_t xcom_input_signal() {
         socket_write(input_signal_connection, tiny_buf, 1, to_write_function);
 
     successful = (error_code == 1);
+    if (!successful) input_signal_pending.store(false);
   }
   return successful;
 }
@@ -1125,6 +1138,11 @@ int local_server(task_arg arg) {
       TASK_DELAY(0.1);
     }
 
+    /* Producers must signal again for requests we may not see below. The
+       exchange pairs with the one in xcom_input_signal, so every request
+       pushed before a skipped signal is visible to the pop. */
+    input_signal_pending.exchange(false);
+
     /* Pop, dispatch, and reply. */
     ep->request = xcom_try_pop_from_input_cb();
     while (ep->request != nullptr) {
@@ -1730,6 +1748,50 @@ static int wait_for_cache(pax_machine **pm, synode_no synode, double timeout);
 static int prop_started = 0;
 static int prop_finished = 0;
 
+/* Upper bound of the time a proposer waits for more messages to batch */
+#define MAX_BATCH_LINGER 0.005
+/* Fraction of the median consensus time a proposer waits for more messages */
+#define BATCH_LINGER_FRACTION 0.25
+
+/*
+  How long a proposer should wait for more messages before proposing a batch
+  that is not full. Lingering only pays off when other proposals are still
+  in flight, since the new proposal would then be learned and executed after
+  them anyway. An idle group proposes at once.
+*/
+static double batch_linger_time() {
+  if (prop_started - prop_finished <= 1) return 0.0;
+  double linger = median_time() * BATCH_LINGER_FRACTION;
+  return linger < MAX_BATCH_LINGER ? linger : MAX_BATCH_LINGER;
+}
+
+/*
+  Move the first message of the proposer input queue into the batch of
+  client_msg. Returns FALSE if the queue is empty, or if the message cannot
+  be batched, in which case it is left in the queue.
+*/
+static bool_t batch_next_app_data(msg_link *client_msg, size_t *size,
+                                  size_t *nr_batched_app_data) {
+  if (link_empty(&prop_input_queue.data)) return FALSE;
+
+  msg_link *tmp = (msg_link *)link_extract_first(&prop_input_queue.data);
+  app_data_ptr atmp = tmp->p->a;
+  /* Abort batching if config or too big batch */
+  if (is_config(atmp->body.c_t) || is_view(atmp->body.c_t) ||
+      *nr_batched_app_data + 1 > MAX_BATCH_APP_DATA ||
+      *size + app_data_size(atmp) > MAX_BATCH_SIZE) {
+    channel_put_front(&prop_input_queue, &tmp->l);
+    return FALSE;
+  }
+  *size += app_data_size(atmp);
+  (*nr_batched_app_data)++;
+  tmp->p->a = nullptr;           /* Steal this payload */
+  msg_link_delete(&tmp);         /* Get rid of the empty message */
+  atmp->next = client_msg->p->a; /* Add to list of app_data */
+  client_msg->p->a = atmp;
+  return TRUE;
+}
+
 /* Send messages by fetching from the input queue and trying to get it accepted
    by a Paxos instance */
 static int proposer_task(task_arg arg) {
@@ -1745,6 +1807,7 @@ static int proposer_task(task_arg arg) {
   site_def const *site;
   size_t size;
   size_t nr_batched_app_data;
+  double linger_until;
   ENV_INIT
   END_ENV_INIT
   END_ENV;
@@ -1762,6 +1825,7 @@ static int proposer_task(task_arg arg) {
   ep->site = nullptr;
   ep->size = 0;
   ep->nr_batched_app_data = 0;
+  ep->linger_until = 0.0;
 
   while (!xcom_shutdown) { /* Loop until no more work to do */
     /* Wait for client message */
@@ -1780,28 +1844,27 @@ static int proposer_task(task_arg arg) {
         !is_view(ep->client_msg->p->a->body.c_t)) {
       ep->size = app_data_size(ep->client_msg->p->a);
       ep->nr_batched_app_data = 1;
-      while (AUTOBATCH && ep->size <= MAX_BATCH_SIZE &&
-          ep->nr_batched_app_data <= MAX_BATCH_APP_DATA &&
-          !link_empty(&prop_input_queue
-            .data)) { /* Batch payloads into single message */
-        msg_link *tmp;
-        app_data_ptr atmp;
-
-        CHANNEL_GET(&prop_input_queue, &tmp, msg_link);
-        atmp = tmp->p->a;
-        ep->size += app_data_size(atmp);
-        ep->nr_batched_app_data++;
-        /* Abort batching if config or too big batch */
-        if (is_config(atmp->body.c_t) || is_view(atmp->body.c_t) ||
-            ep->nr_batched_app_data > MAX_BATCH_APP_DATA ||
-            ep->size > MAX_BATCH_SIZE) {
-          channel_put_front(&prop_input_queue, &tmp->l);
+      /* Batch payloads into single message */
+      while (AUTOBATCH && batch_next_app_data(ep->client_msg, &ep->size,
+                                              &ep->nr_batched_app_data)) {
+      }
+
+      /*
+        Wait a little for more messages while the batch is not full and
+        earlier proposals are still being decided. Under load this turns
+        many small proposals into fewer full ones, so that the number of
+        messages decided per round trip grows with the load.
+      */
+      ep->linger_until = task_now() + batch_linger_time();
+      while (AUTOBATCH && ep->nr_batched_app_data < MAX_BATCH_APP_DATA &&
+             task_now() < ep->linger_until) {
+        if (link_empty(&prop_input_queue.data)) {
+          TIMED_TASK_WAIT(&prop_input_queue.queue,
+                          ep->linger_until - task_now());
+        } else if (!batch_next_app_data(ep->client_msg, &ep->size,
+                                        &ep->nr_batched_app_data)) {
           break;
         }
-        tmp->p->a = nullptr;               /* Steal this payload */
-        msg_link_delete(&tmp);             /* Get rid of the empty message */
-        atmp->next = ep->client_msg->p->a; /* Add to list of app_data */
-        ep->client_msg->p->a = atmp;
       }
     }
 
@@ -3328,6 +3391,17 @@ static pax_msg *create_learn_msg_for_ignorant_node(pax_machine *p, pax_msg *pm,
   return reply;
 }
 
+/* Answer a request for a message which was evicted to the spill file */
+static pax_msg *create_learn_msg_from_spill(pax_msg *spilled, pax_msg *pm) {
+  CREATE_REPLY(pm);
+  reply->synode = spilled->synode;
+  reply->proposal = spilled->proposal;
+  reply->msg_type = spilled->msg_type;
+  safe_app_data_copy(&reply, spilled->a);
+  if (reply != nullptr) set_learn_type(reply);
+  return reply;
+}
+
 static void teach_ignorant_node(site_def const *site, pax_machine *p,
                                 pax_msg *pm, synode_no synode,
                                 linkage *reply_queue) {
@@ -4829,8 +4903,26 @@ again:
         }
       } else {
         if (/* xcom_booted() && */ ep->behind) {
-          if (/*ep->p->op == prepare_op && */ was_removed_from_cache(
-              ep->p->synode)) {
+          /* If the message was decided and evicted to the spill file, tell
+             the node about it */
+          if (ep->p->op == read_op || ep->p->op == prepare_op ||
+              ep->p->op == accept_op) {
+            pax_msg *spilled = cache_spill_get(ep->p->synode);
+            if (spilled != nullptr) {
+              pax_msg *reply = create_learn_msg_from_spill(spilled, ep->p);
+              delete_pax_msg(spilled);
+              if (reply != nullptr) {
+                SERIALIZE_REPLY(reply);
+                delete_pax_msg(reply); /* Deallocate BEFORE potentially
+                                          blocking call which will lose value
+                                          of reply */
+              }
+            }
+          }
+          if (ep->buf != nullptr) {
+            WRITE_REPLY;
+          } else if (/*ep->p->op == prepare_op && */ was_removed_from_cache(
+                         ep->p->synode)) {
             if (get_maxnodes(ep->site) > 0) {
               {
                 pax_msg *np = nullptr;
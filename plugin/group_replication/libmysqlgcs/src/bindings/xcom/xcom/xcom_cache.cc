@@ -27,8 +27,19 @@
 #include "xcom/xcom_cache.h"
 
 #include <assert.h>
+#include <inttypes.h>
 #include <rpc/rpc.h>
 #include <stdlib.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <deque>
+#include <map>
+#include <string>
+#include <tuple>
 
 #include "xcom/app_data.h"
 #include "xcom/bitset.h"
@@ -87,6 +98,7 @@ static float min_length_threshold = MIN_LENGTH_THRESHOLD;
 static inline int can_deallocate(lru_machine *link_iter);
 static size_t do_shrink_cache(bool force);
 static pax_machine *hash_out(pax_machine *p);
+static inline size_t get_app_msg_size(pax_msg const *p);
 
 void set_max_cache_mode(int x) {
   buckets = BUCKETS << x;
@@ -197,6 +209,207 @@ static int was_machine_executed(pax_machine *p) {
   return not_yet_functional || already_executed;
 }
 
+/*
+  Spill file.
+
+  Decided messages which are evicted from the cache are written to a
+  memory mapped file of m_cache_spill_limit bytes, which is used as a
+  ring buffer. A node which is so far behind that the messages it asks
+  for are no longer in the cache can then still get them from the spill
+  file, instead of being told to die. Messages are stored in their
+  serialized form, and overwritten in the order they were written when
+  the ring wraps around. The spill file is created, allocated and mapped
+  by cache_spill_init when XCom is configured, so that neither the
+  allocation nor the first touch of its pages is paid for by the XCom
+  thread, and removed by cache_spill_deinit. The index of what it holds
+  only lives as long as the cache, it is dropped in deinit_cache.
+*/
+
+#ifndef _WIN32
+struct spill_entry {
+  uint64_t offset;
+  uint32_t length;
+};
+
+using spill_key = std::tuple<uint32_t, uint64_t, node_no>;
+
+static std::string spill_file;
+static int spill_fd = -1;
+static char *spill_map = nullptr;
+static uint64_t spill_capacity = 0;
+static uint64_t spill_pos = 0;
+static std::map<spill_key, spill_entry> spill_index;
+static std::deque<spill_key> spill_order; /* Oldest first */
+
+static spill_key spill_key_of(synode_no synode) {
+  return spill_key(synode.group_id, synode.msgno, synode.node);
+}
+
+/* Forget everything written to the spill file */
+static void spill_reset() {
+  spill_pos = 0;
+  spill_index.clear();
+  spill_order.clear();
+}
+
+void cache_spill_deinit() {
+  if (spill_map != nullptr) munmap(spill_map, spill_capacity);
+  if (spill_fd >= 0) {
+    close(spill_fd);
+    unlink(spill_file.c_str());
+  }
+  spill_fd = -1;
+  spill_map = nullptr;
+  spill_capacity = 0;
+  spill_reset();
+}
+
+int cache_spill_init() {
+  cache_spill_deinit();
+  if (the_app_xcom_cfg == nullptr ||
+      the_app_xcom_cfg->m_cache_spill_limit == 0)
+    return 0;
+
+  char const *file = the_app_xcom_cfg->m_cache_spill_file;
+  uint64_t capacity = the_app_xcom_cfg->m_cache_spill_limit;
+  spill_file = file;
+  spill_fd = open(file, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  /*
+    Allocate the whole file up front where we can, writing to a page of a
+    sparse file that cannot be allocated would raise SIGBUS.
+  */
+#ifdef __linux__
+  int const resize_error =
+      spill_fd < 0 ? -1 : posix_fallocate(spill_fd, 0, (off_t)capacity);
+#else
+  int const resize_error =
+      spill_fd < 0 ? -1 : ftruncate(spill_fd, (off_t)capacity);
+#endif
+  if (resize_error != 0) {
+    G_ERROR("Unable to create the XCom cache spill file %s of %" PRIu64
+            " bytes.",
+            file, capacity);
+    cache_spill_deinit();
+    return 1;
+  }
+  /* Fault the pages in now rather than on the first spill */
+#ifdef MAP_POPULATE
+  int const map_flags = MAP_SHARED | MAP_POPULATE;
+#else
+  int const map_flags = MAP_SHARED;
+#endif
+  void *map =
+      mmap(nullptr, capacity, PROT_READ | PROT_WRITE, map_flags, spill_fd, 0);
+  if (map == MAP_FAILED) {
+    G_ERROR("Unable to map the XCom cache spill file %s of %" PRIu64
+            " bytes.",
+            file, capacity);
+    cache_spill_deinit();
+    return 1;
+  }
+  spill_map = (char *)map;
+  spill_capacity = capacity;
+  G_INFO("Spilling messages evicted from the XCom cache to %s", file);
+  return 0;
+}
+
+static void spill_forget_oldest() {
+  spill_index.erase(spill_order.front());
+  spill_order.pop_front();
+}
+
+/*
+  Write the decided message of p to the spill file, unless it is already
+  there. Return 1 if the message is in the spill file.
+*/
+static int spill_pax_machine(pax_machine *p) {
+  if (spill_map == nullptr || !pm_finished(p) || p->learner.msg == nullptr)
+    return 0;
+  spill_key key = spill_key_of(p->synode);
+  if (spill_index.count(key)) return 1;
+
+  uint32_t buflen = 0;
+  char *buf = nullptr;
+  if (!serialize_msg(p->learner.msg, my_xcom_version, &buflen, &buf)) {
+    X_FREE(buf);
+    return 0;
+  }
+  uint32_t length = buflen - MSG_HDR_SIZE;
+  if (length > spill_capacity / 2) {
+    X_FREE(buf);
+    return 0;
+  }
+
+  /* Wrap around, forgetting what is still stored after the current end */
+  if (spill_pos + length > spill_capacity) {
+    while (!spill_order.empty() &&
+           spill_index[spill_order.front()].offset >= spill_pos)
+      spill_forget_oldest();
+    spill_pos = 0;
+  }
+  /* Forget the messages that will be overwritten */
+  while (!spill_order.empty() &&
+         spill_index[spill_order.front()].offset < spill_pos + length &&
+         spill_index[spill_order.front()].offset >= spill_pos)
+    spill_forget_oldest();
+
+  memcpy(spill_map + spill_pos, MSG_PTR(buf), length);
+  spill_index[key] = {spill_pos, length};
+  spill_order.push_back(key);
+  spill_pos += length;
+  X_FREE(buf);
+  return 1;
+}
+
+pax_msg *cache_spill_get(synode_no synode) {
+  if (spill_map == nullptr) return nullptr;
+  auto it = spill_index.find(spill_key_of(synode));
+  if (it == spill_index.end()) return nullptr;
+
+  pax_msg *p = pax_msg_new_0(synode);
+  if (!deserialize_msg(p, my_xcom_version, spill_map + it->second.offset,
+                       it->second.length)) {
+    delete_pax_msg(p);
+    return nullptr;
+  }
+  p->refcnt = 0;
+  return p;
+}
+
+/*
+  Return true if p may be evicted although some node has not delivered it
+  yet, because it has been written to the spill file. Nodes that ask for it
+  will be served from there.
+*/
+static int can_spill(pax_machine *p) {
+  synode_no delivered = get_delivered_msg();
+  if (spill_map == nullptr || !pm_finished(p) ||
+      p->synode.group_id != delivered.group_id ||
+      p->synode.msgno + MIN_CACHED >= delivered.msgno ||
+      get_app_msg_size(p->learner.msg) > spill_capacity / 4)
+    return 0;
+  return spill_pax_machine(p);
+}
+#else
+static void spill_reset() {}
+
+void cache_spill_deinit() {}
+
+int cache_spill_init() {
+  if (the_app_xcom_cfg == nullptr ||
+      the_app_xcom_cfg->m_cache_spill_limit == 0)
+    return 0;
+  G_ERROR("The XCom cache spill file is not supported on this platform.");
+  return 1;
+}
+
+static int spill_pax_machine(pax_machine *p [[maybe_unused]]) { return 0; }
+
+pax_msg *cache_spill_get(synode_no synode [[maybe_unused]]) { return nullptr; }
+
+static int can_spill(pax_machine *p [[maybe_unused]]) { return 0; }
+#endif
+
 /*
 Get a machine for (re)use.
 The machines are statically allocated, and organized in two lists.
@@ -226,7 +439,10 @@ static lru_machine *lru_get(bool_t force) {
 
     /* Since this machine is in the cache, we need to update
        last_removed_cache */
-    if (retval) last_removed_cache = retval->pax.synode;
+    if (retval) {
+      last_removed_cache = retval->pax.synode;
+      if (was_machine_executed(&retval->pax)) spill_pax_machine(&retval->pax);
+    }
   }
   return retval;
 }
@@ -296,6 +512,7 @@ void deinit_cache() {
   })
 
   reset_cache();
+  spill_reset();
   psi_report_cache_shutdown();
 }
 
@@ -354,11 +571,15 @@ static inline int can_deallocate(lru_machine *link_iter) {
       nullptr) /* Synode does not match any site, OK to deallocate */
     return 1;
   delivered_msg = get_min_delivered_msg(site);
-  if (synode_eq(delivered_msg,
-                null_synode)) /* Missing info from some node, not OK */
-    return 0;
+  /*
+    Missing info from some node, only OK if the message can be served from
+    the spill file. Note that can_spill writes the message to the spill file.
+  */
+  if (synode_eq(delivered_msg, null_synode))
+    return can_spill(&link_iter->pax);
   return link_iter->pax.synode.group_id != delivered_msg.group_id ||
-         (link_iter->pax.synode.msgno + MIN_CACHED) < delivered_msg.msgno;
+         (link_iter->pax.synode.msgno + MIN_CACHED) < delivered_msg.msgno ||
+         can_spill(&link_iter->pax);
 }
 
 static uint64_t cache_size = 0;
@@ -101,6 +101,18 @@ int above_cache_limit();
 uint64_t set_max_cache_size(uint64_t x);
 void set_max_cache_mode(int x);
 int was_removed_from_cache(synode_no x);
+/*
+  Return a copy of the decided message for synode if it was evicted to the
+  spill file, or nullptr. The caller must free it with delete_pax_msg.
+*/
+pax_msg *cache_spill_get(synode_no synode);
+/*
+  Create, allocate and map the spill file configured in the_app_xcom_cfg.
+  Return 0 if it is ready or not configured, 1 on error.
+*/
+int cache_spill_init();
+/* Unmap and remove the spill file */
+void cache_spill_deinit();
 uint16_t check_decrease();
 void do_cache_maintenance();
 
@@ -40,6 +40,8 @@ void init_cfg_app_xcom() {
 
   the_app_xcom_cfg->m_poll_spin_loops = 0;
   the_app_xcom_cfg->m_cache_limit = DEFAULT_CACHE_LIMIT;
+  the_app_xcom_cfg->m_cache_spill_limit = 0;
+  memset(the_app_xcom_cfg->m_cache_spill_file, 0, MAX_CACHE_SPILL_FILE_LEN);
   the_app_xcom_cfg->identity = nullptr;
   memset(the_app_xcom_cfg->ip_port, 0, MAX_IP_PORT_LEN);
 }
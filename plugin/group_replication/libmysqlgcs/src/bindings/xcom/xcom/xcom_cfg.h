@@ -31,6 +31,7 @@
 
 #define DEFAULT_EXPEL_TIMEOUT 5
 #define MAX_IP_PORT_LEN 64
+#define MAX_CACHE_SPILL_FILE_LEN 512
 
 typedef struct cfg_app_xcom {
   /*
@@ -44,6 +45,13 @@ typedef struct cfg_app_xcom {
   */
   uint64_t m_cache_limit;
 
+  /*
+   size and name of the file that decided messages evicted from the cache
+   are spilled to, so that lagging nodes can still get them, 0 if none
+  */
+  uint64_t m_cache_spill_limit;
+  char m_cache_spill_file[MAX_CACHE_SPILL_FILE_LEN];
+
   char ip_port[MAX_IP_PORT_LEN];
   /*
    The (address, incarnation) pair that uniquely identifies this XCom instance.
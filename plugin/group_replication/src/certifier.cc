@@ -23,7 +23,9 @@
 
 #include <assert.h>
 #include <signal.h>
+#include <string.h>
 #include <time.h>
+#include <algorithm>
 #include <map>
 
 #include <mysql/components/services/log_builtins.h>
@@ -652,13 +654,49 @@ void Certifier::update_parallel_applier_indexes(
          parallel_applier_last_sequence_number);
 }
 
+void Certifier::purge_replay_cal_item(replay_cal_hash_item *hash_item,
+                                      int64 shift, int64 limit) {
+  int kept = 0;
+  for (int i = 0; i < hash_item->number; i++) {
+    unsigned char *p = hash_item->values + (i << 3);
+    int64 relative_sequence = (p[6] << 8) + p[7];
+    if (relative_sequence <= limit) continue;
+
+    relative_sequence -= shift;
+    unsigned char *to = hash_item->values + (kept << 3);
+    if (to != p) memcpy(to, p, REPLAY_CAL_KEY_LENGTH);
+    to[6] = (relative_sequence & 0xFF00) >> 8;
+    to[7] = (relative_sequence & 0x00FF);
+    kept++;
+  }
+  hash_item->number = kept;
+}
+
+bool Certifier::rebase_replay_cal_info() {
+  DBUG_TRACE;
+  mysql_mutex_assert_owner(&LOCK_certification_info);
+
+  int64 shift = parallel_applier_last_committed_global -
+                base_parallel_applier_sequence_number;
+  if (shift <= 0) return true;
+
+  size_t used = 0;
+  for (uint16 index : used_replay_cal_items) {
+    replay_cal_hash_item *hash_item = &(replayed_cal_array[index]);
+    purge_replay_cal_item(hash_item, shift, shift);
+    if (hash_item->number > 0) used_replay_cal_items[used++] = index;
+  }
+  used_replay_cal_items.resize(used);
+  base_parallel_applier_sequence_number =
+      parallel_applier_last_committed_global;
+  return false;
+}
+
 bool Certifier::add_item(const char *item,
     int64 transaction_sequence_number,
     int64 *item_previous_sequence_number) {
   DBUG_TRACE;
   mysql_mutex_assert_owner(&LOCK_certification_info);
-  bool found = false;
-  int error = false;
   size_t base_len = strlen(item);
   size_t decoded_len = base64_needed_decoded_length(base_len);
   unsigned char dst[64];
@@ -677,55 +715,59 @@ bool Certifier::add_item(const char *item,
   int64 relative_sequence =
     transaction_sequence_number - base_parallel_applier_sequence_number;
 
+  /*
+    Entries that are not newer than the global last committed are dropped
+    to make room, only when that is not enough is the whole table cleared.
+  */
   if (relative_sequence > MAX_RELATIVE_SEQUENCE_NUMBER) {
-    return true;
+    if (rebase_replay_cal_info()) return true;
+    relative_sequence =
+      transaction_sequence_number - base_parallel_applier_sequence_number;
+    if (relative_sequence > MAX_RELATIVE_SEQUENCE_NUMBER) return true;
   }
 
-  if (hash_item->number > 0) {
-    for (int i = 0; i < hash_item->number; i++) {
-      unsigned char *p = hash_item->values + (i << 3);
-      bool is_equal = true;
-      for (int j = 0; j < 6; j++) {
-        if (remainder[j] != p[j]) {
-          is_equal = false;
-          break;
-        }
-      }
-      if (is_equal) {
-        found_pos = p;
-        found = true;
-        break;
-      }
+  for (int i = 0; i < hash_item->number; i++) {
+    unsigned char *p = hash_item->values + (i << 3);
+    if (memcmp(remainder, p, REPLAY_CAL_KEY_LENGTH) == 0) {
+      found_pos = p;
+      break;
     }
   }
 
-  if (found) {
+  if (found_pos != nullptr) {
     int64 old_relative_sequence = (found_pos[6] << 8) + found_pos[7];
     *item_previous_sequence_number =
       base_parallel_applier_sequence_number + old_relative_sequence;
-    found_pos[6] = (relative_sequence & 0xFF00) >> 8;
-    found_pos[7] = (relative_sequence & 0x00FF);
   } else {
+    /*
+      A full bucket is already in used_replay_cal_items, even if the purge
+      below empties it.
+    */
+    const bool was_empty = hash_item->number == 0;
     if (hash_item->number >= REPLAY_CAL_HASH_ITEMS) {
-      error = true;
-    } else {
-      found_pos = hash_item->values + (hash_item->number << 3);
-      hash_item->number++;
-      for (int j = 0; j < 6; j++) {
-        found_pos[j] = remainder[j];
-      }
-      found_pos[6] = (relative_sequence & 0xFF00) >> 8;
-      found_pos[7] = (relative_sequence & 0x00FF);
+      purge_replay_cal_item(hash_item, 0,
+                            parallel_applier_last_committed_global -
+                                base_parallel_applier_sequence_number);
+      if (hash_item->number >= REPLAY_CAL_HASH_ITEMS) return true;
+      assert(std::count(used_replay_cal_items.begin(),
+                        used_replay_cal_items.end(), index) == 1);
     }
+    if (was_empty) used_replay_cal_items.push_back(index);
+    found_pos = hash_item->values + (hash_item->number << 3);
+    hash_item->number++;
+    memcpy(found_pos, remainder, REPLAY_CAL_KEY_LENGTH);
   }
+  found_pos[6] = (relative_sequence & 0xFF00) >> 8;
+  found_pos[7] = (relative_sequence & 0x00FF);
 
-  return error;
+  return false;
 }
 
 rpl_gno Certifier::certify(Gtid_set *snapshot_version,
                            std::list<const char *> *write_set,
                            bool generate_group_id, const char *member_uuid,
-                           Gtid_log_event *gle, bool local_transaction) {
+                           Gtid_log_event *gle, bool local_transaction,
+                           Transaction_dependencies *dependencies) {
   DBUG_TRACE;
   rpl_gno result = 0;
   bool has_to_flush_last_commited = false;
@@ -733,8 +775,11 @@ rpl_gno Certifier::certify(Gtid_set *snapshot_version,
 
   if (!is_initialized()) return -1; /* purecov: inspected */
 
+  if (dependencies != nullptr) dependencies->parents.clear();
+
   mysql_mutex_lock(&LOCK_certification_info);
   int64 transaction_last_committed = parallel_applier_last_committed_global;
+  const int64 dependencies_barrier = transaction_last_committed;
 
   if (certifying_already_applied_transactions &&
       !group_gtid_extracted->is_subset_not_equals(group_gtid_executed)) {
@@ -887,6 +932,11 @@ rpl_gno Certifier::certify(Gtid_set *snapshot_version,
         if (item_previous_sequence_number > transaction_last_committed &&
             item_previous_sequence_number != parallel_applier_sequence_number)
           transaction_last_committed = item_previous_sequence_number;
+
+        if (dependencies != nullptr &&
+            item_previous_sequence_number > dependencies_barrier &&
+            item_previous_sequence_number != parallel_applier_sequence_number)
+          dependencies->parents.push_back(item_previous_sequence_number);
       }
     }
   }
@@ -919,6 +969,20 @@ rpl_gno Certifier::certify(Gtid_set *snapshot_version,
       need_inc_parallel_applier_sequence_number = true;
     }
 
+    if (dependencies != nullptr) {
+      if (need_inc_parallel_applier_sequence_number) {
+        /* The transaction is applied alone, its last_committed says it. */
+        dependencies->parents.clear();
+      } else {
+        auto &parents = dependencies->parents;
+        std::sort(parents.begin(), parents.end());
+        parents.erase(std::unique(parents.begin(), parents.end()),
+                      parents.end());
+      }
+      dependencies->sequence_number = parallel_applier_sequence_number;
+      dependencies->barrier = dependencies_barrier;
+    }
+
     gle->last_committed = transaction_last_committed;
     gle->sequence_number = parallel_applier_sequence_number;
     assert(gle->last_committed >= 0);
@@ -1133,10 +1197,9 @@ void Certifier::clear_replay_cal_info() {
   DBUG_TRACE;
   mysql_mutex_assert_owner(&LOCK_certification_info);
 
-  for (int i = 0; i < REPLAY_CAL_ARRAY; i++) {
-    replay_cal_hash_item *hash_item = &(replayed_cal_array[i]);
-    hash_item->number = 0;
-  }
+  for (uint16 index : used_replay_cal_items)
+    replayed_cal_array[index].number = 0;
+  used_replay_cal_items.clear();
 }
 
 int Certifier::get_group_stable_transactions_set_string(char **buffer,
@@ -126,6 +126,13 @@ int Applier_handler::handle_event(Pipeline_event *event, Continuation *cont) {
     performed on the previous handler.
   */
   if (event->get_event_type() != binary_log::TRANSACTION_CONTEXT_EVENT) {
+    const Transaction_dependencies &dependencies =
+        event->get_transaction_dependencies();
+    if (!dependencies.parents.empty()) {
+      /* On failure the transaction waits for its last_committed. */
+      channel_interface.add_transaction_dependencies(dependencies);
+    }
+
     error = channel_interface.queue_packet((const char *)p->payload, p->len,
                                            event->get_io_buffered());
 
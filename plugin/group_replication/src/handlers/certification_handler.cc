@@ -245,6 +245,7 @@ int Certification_handler::handle_transaction_id(Pipeline_event *pevent,
   Transaction_context_log_event *tcle = nullptr;
   Log_event *event = nullptr;
   Gtid_log_event *gle = nullptr;
+  Transaction_dependencies dependencies;
 
   /*
     Get transaction context.
@@ -279,7 +280,7 @@ int Certification_handler::handle_transaction_id(Pipeline_event *pevent,
   seq_number =
       cert_module->certify(tcle->get_snapshot_version(), tcle->get_write_set(),
                            !tcle->is_gtid_specified(), tcle->get_server_uuid(),
-                           gle, local_transaction);
+                           gle, local_transaction, &dependencies);
 
   if (local_transaction) {
     /*
@@ -420,6 +421,15 @@ int Certification_handler::handle_transaction_id(Pipeline_event *pevent,
         }
       }
 
+      /*
+        Let the applier channel wait for the transactions this one
+        conflicts with rather than for all up to its last_committed.
+      */
+      if (!dependencies.parents.empty()) {
+        dependencies.gno = gno;
+        pevent->set_transaction_dependencies(std::move(dependencies));
+      }
+
       // Pass transaction to next action.
       next(pevent, cont);
     } else if (seq_number < 0) {
@@ -34,15 +34,22 @@
  * +======================================+
  * | 5.7.14        | 1                    |
  * | 8.0.16        | 2                    |
+ * | 8.0.40        | 3 (or 2)             |
  * +--------------------------------------+
+ *
+ * Protocol 3 is specific to this server: stock 8.0.40 servers only support
+ * protocol 2. It is therefore only used when every member of the group
+ * advertises it, see convert_to_gcs_protocol.
  */
 
 static Member_version const version_5_7_14(0x050714);
 static Member_version const version_8_0_16(0x080016);
+static Member_version const version_8_0_40(0x080040);
 
 /*
  * Protocol 1 maps to version 5.7.14.
  * Protocol 2 maps to version 8.0.16.
+ * Protocol 3 maps to version 8.0.40.
  *
  * When you update this function, remember to update the convert_to_gcs_protocol
  * function accordingly.
@@ -54,12 +61,13 @@ Member_version convert_to_mysql_version(
       return version_5_7_14;
     case Gcs_protocol_version::V2:
       return version_8_0_16;
-    case Gcs_protocol_version::UNKNOWN:
     case Gcs_protocol_version::V3:
+      return version_8_0_40;
+    case Gcs_protocol_version::UNKNOWN:
     case Gcs_protocol_version::V4:
     case Gcs_protocol_version::V5:
       /* This should not happen... */
-      assert(false && "GCS protocol should have been V1 or V2");
+      assert(false && "GCS protocol should have been V1, V2 or V3");
       break;
   }
   return Member_version(0x000000);
@@ -67,17 +75,26 @@ Member_version convert_to_mysql_version(
 
 /*
  * Versions in the domain [5.7.14; 8.0.16[ map to protocol 1.
- * Versions in the domain [8.0.16; my-version] map to protocol 2.
+ * Versions in the domain [8.0.16; 8.0.40[ map to protocol 2.
+ * Versions in the domain [8.0.40; my-version] map to protocol 3 if every
+ * member of the group supports it, and to protocol 2 otherwise.
  *
  * When you update this function, remember to update the
  * convert_to_mysql_version function accordingly.
  */
 Gcs_protocol_version convert_to_gcs_protocol(
-    Member_version const &mysql_version, Member_version const &my_version) {
+    Member_version const &mysql_version, Member_version const &my_version,
+    Gcs_protocol_version const &max_supported_protocol) {
   if (version_5_7_14 <= mysql_version && mysql_version < version_8_0_16) {
     return Gcs_protocol_version::V1;
-  } else if (version_8_0_16 <= mysql_version && mysql_version <= my_version) {
+  } else if (version_8_0_16 <= mysql_version &&
+             mysql_version < version_8_0_40) {
     return Gcs_protocol_version::V2;
+  } else if (version_8_0_40 <= mysql_version && mysql_version <= my_version) {
+    /* Stock 8.0.40 members advertise protocol 2 as their maximum. */
+    return max_supported_protocol >= Gcs_protocol_version::V3
+               ? Gcs_protocol_version::V3
+               : Gcs_protocol_version::V2;
   } else {
     return Gcs_protocol_version::UNKNOWN;
   }
@@ -512,6 +512,9 @@ int group_replication_trans_before_commit(Trans_param *param) {
   });
 #endif
 
+  // Pace the commit rate, if flow control asks to
+  applier_module->get_flow_stat_module()->do_wait();
+
   // Broadcast the Transaction Message
   send_error = gcs_module->send_transaction_message(*transaction_msg);
 
@@ -16,6 +16,7 @@
 #include "plugin/group_replication/include/perfschema/pfs.h"
 #include "mysql/components/my_service.h"
 #include "plugin/group_replication/include/perfschema/table_replication_group_configuration_version.h"
+#include "plugin/group_replication/include/perfschema/table_replication_group_flow_control.h"
 #include "plugin/group_replication/include/perfschema/table_replication_group_member_actions.h"
 #include "plugin/group_replication/include/perfschema/utilities.h"
 
@@ -60,6 +61,11 @@ bool Perfschema_module::initialize() {
   table_replication_group_configuration_version->init();
   m_tables.push_back(std::move(table_replication_group_configuration_version));
 
+  auto table_replication_group_flow_control =
+      std::make_unique<Pfs_table_replication_group_flow_control>();
+  table_replication_group_flow_control->init();
+  m_tables.push_back(std::move(table_replication_group_flow_control));
+
   auto table_replication_group_member_actions =
       std::make_unique<Pfs_table_replication_group_member_actions>();
   table_replication_group_member_actions->init();
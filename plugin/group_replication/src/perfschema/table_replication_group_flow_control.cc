@@ -0,0 +1,240 @@
+/* Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+#include <string>
+#include <vector>
+
+#include "mysql/components/my_service.h"
+
+#include "mysql/components/services/pfs_plugin_table_service.h"
+#include "plugin/group_replication/include/perfschema/table_replication_group_flow_control.h"
+#include "plugin/group_replication/include/perfschema/utilities.h"
+#include "plugin/group_replication/include/plugin.h"
+
+namespace gr {
+namespace perfschema {
+
+/**
+  A row in the replication_group_flow_control table.
+*/
+struct Replication_group_flow_control {
+  std::string member_id;
+  long long transactions_in_applier_queue;
+  double estimated_apply_rate;
+  double predicted_max_rate;
+  double commit_rate_limit;
+  bool is_local;
+};
+
+/**
+  A structure to define a handle for table in plugin/component code.
+*/
+struct Replication_group_flow_control_table_handle {
+  unsigned long long current_row_pos{0};
+  unsigned long long next_row_pos{0};
+
+  std::vector<struct Replication_group_flow_control> rows;
+};
+
+unsigned long long Pfs_table_replication_group_flow_control::get_row_count() {
+  return 0;
+}
+
+int Pfs_table_replication_group_flow_control::rnd_init(
+    PSI_table_handle *handle [[maybe_unused]], bool scan [[maybe_unused]]) {
+  return 0;
+}
+
+int Pfs_table_replication_group_flow_control::rnd_next(
+    PSI_table_handle *handle) {
+  Replication_group_flow_control_table_handle *t =
+      (Replication_group_flow_control_table_handle *)handle;
+  t->current_row_pos = t->next_row_pos;
+  if (t->current_row_pos < t->rows.size()) {
+    t->next_row_pos++;
+    return 0;
+  }
+
+  return PFS_HA_ERR_END_OF_FILE;
+}
+
+int Pfs_table_replication_group_flow_control::rnd_pos(
+    PSI_table_handle *handle) {
+  Replication_group_flow_control_table_handle *t =
+      (Replication_group_flow_control_table_handle *)handle;
+  if (t->current_row_pos >= t->rows.size()) {
+    return PFS_HA_ERR_END_OF_FILE;
+  }
+
+  return 0;
+}
+
+void Pfs_table_replication_group_flow_control::reset_position(
+    PSI_table_handle *handle) {
+  Replication_group_flow_control_table_handle *t =
+      (Replication_group_flow_control_table_handle *)handle;
+  t->current_row_pos = 0;
+  t->next_row_pos = 0;
+}
+
+int Pfs_table_replication_group_flow_control::read_column_value(
+    PSI_table_handle *handle, PSI_field *field, unsigned int index) {
+  Registry_guard guard;
+  my_service<SERVICE_TYPE(pfs_plugin_column_string_v2)> column_string_service{
+      "pfs_plugin_column_string_v2", guard.get_registry()};
+  my_service<SERVICE_TYPE(pfs_plugin_column_bigint_v1)> column_bigint_service{
+      "pfs_plugin_column_bigint_v1", guard.get_registry()};
+  my_service<SERVICE_TYPE(pfs_plugin_column_double_v1)> column_double_service{
+      "pfs_plugin_column_double_v1", guard.get_registry()};
+
+  Replication_group_flow_control_table_handle *t =
+      (Replication_group_flow_control_table_handle *)handle;
+  const Replication_group_flow_control &row = t->rows[t->current_row_pos];
+
+  switch (index) {
+    case 0: {  // member_id
+      column_string_service->set_char_utf8mb4(field, row.member_id.c_str(),
+                                              row.member_id.length());
+      break;
+    }
+    case 1: {  // transactions_in_applier_queue
+      column_bigint_service->set(field,
+                                 {row.transactions_in_applier_queue, false});
+      break;
+    }
+    case 2: {  // estimated_apply_rate, NULL until it is estimated
+      column_double_service->set(
+          field, {row.estimated_apply_rate, row.estimated_apply_rate == 0});
+      break;
+    }
+    case 3: {  // predicted_max_rate, NULL if the member does not limit
+      column_double_service->set(
+          field, {row.predicted_max_rate, row.predicted_max_rate == 0});
+      break;
+    }
+    case 4: {  // commit_rate_limit, NULL if not throttled
+      column_double_service->set(
+          field, {row.commit_rate_limit,
+                  !row.is_local || row.commit_rate_limit == 0});
+      break;
+    }
+    default: {
+      /* purecov: begin inspected */
+      assert(0);
+      break;
+      /* purecov: end */
+    }
+  }
+  return 0;
+}
+
+PSI_table_handle *Pfs_table_replication_group_flow_control::open_table(
+    PSI_pos **pos [[maybe_unused]]) {
+  Replication_group_flow_control_table_handle *handle =
+      new Replication_group_flow_control_table_handle();
+  handle->rows.clear();
+  handle->current_row_pos = 0;
+  handle->next_row_pos = 0;
+
+  /*
+    Protect the access to `applier_module` against concurrent auto-rejoin
+    attempts which may destroy it while the stats are read.
+  */
+  MUTEX_LOCK(lock, get_plugin_applier_module_initialize_terminate_lock());
+  if (!get_plugin_is_stopping() && applier_module != nullptr &&
+      group_member_mgr != nullptr && local_member_info != nullptr) {
+    Flow_stat_module *flow_stat_module = applier_module->get_flow_stat_module();
+    Flow_stat_module_info info;
+    flow_stat_module->get_all_pipeline_stats(info);
+    double commit_rate = flow_stat_module->get_commit_rate();
+    std::string const local_uuid = local_member_info->get_uuid();
+
+    for (auto &it : info) {
+      Group_member_info member_info;
+      if (group_member_mgr->get_group_member_info_by_member_id(
+              Gcs_member_identifier(it.first), member_info))
+        continue; /* The member left the group. */
+
+      struct Replication_group_flow_control row;
+      row.member_id = member_info.get_uuid();
+      row.transactions_in_applier_queue =
+          it.second.get_transactions_waiting_apply();
+      row.estimated_apply_rate = it.second.get_apply_capacity();
+      row.predicted_max_rate = it.second.get_predicted_max_rate();
+      row.is_local = row.member_id == local_uuid;
+      row.commit_rate_limit = row.is_local ? commit_rate : 0;
+      handle->rows.push_back(row);
+    }
+  }
+
+  reset_position((PSI_table_handle *)handle);
+  *pos = reinterpret_cast<PSI_pos *>(&(handle->current_row_pos));
+  return (PSI_table_handle *)handle;
+}
+
+void Pfs_table_replication_group_flow_control::close_table(
+    PSI_table_handle *handle) {
+  Replication_group_flow_control_table_handle *t =
+      (Replication_group_flow_control_table_handle *)handle;
+  delete t;
+}
+
+bool Pfs_table_replication_group_flow_control::deinit() { return false; }
+
+bool Pfs_table_replication_group_flow_control::init() {
+  m_share.m_table_name = "replication_group_flow_control";
+  m_share.m_table_name_length = ::strlen(m_share.m_table_name);
+  m_share.m_table_definition =
+      "member_id CHAR(36) CHARACTER SET ASCII NOT NULL, "
+      "transactions_in_applier_queue BIGINT NOT NULL, "
+      "estimated_apply_rate DOUBLE, "
+      "predicted_max_rate DOUBLE, "
+      "commit_rate_limit DOUBLE";
+  m_share.m_ref_length =
+      sizeof Replication_group_flow_control_table_handle::current_row_pos;
+  m_share.m_acl = READONLY;
+  m_share.get_row_count =
+      Pfs_table_replication_group_flow_control::get_row_count;
+
+  /* Initialize PFS_engine_table_proxy */
+  m_share.m_proxy_engine_table = {
+      Pfs_table_replication_group_flow_control::rnd_next,
+      Pfs_table_replication_group_flow_control::rnd_init,
+      Pfs_table_replication_group_flow_control::rnd_pos,
+      nullptr,  // index_init,
+      nullptr,  // index_read,
+      nullptr,  // index_next,
+      Pfs_table_replication_group_flow_control::read_column_value,
+      Pfs_table_replication_group_flow_control::reset_position,
+      nullptr,  // write_column_value,
+      nullptr,  // write_row_values,
+      nullptr,  // update_column_value,
+      nullptr,  // update_row_values,
+      nullptr,  // delete_row_values,
+      Pfs_table_replication_group_flow_control::open_table,
+      Pfs_table_replication_group_flow_control::close_table};
+  return false;
+}
+
+}  // namespace perfschema
+}  // namespace gr
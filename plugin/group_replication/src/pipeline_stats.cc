@@ -24,6 +24,7 @@
 #include "plugin/group_replication/include/pipeline_stats.h"
 
 #include <time.h>
+#include <algorithm>
 
 #include <mysql/components/services/log_builtins.h>
 #include "my_byteorder.h"
@@ -296,6 +297,11 @@ void Pipeline_stats_member_collector::send_stats_member_message() {
   send_transaction_identifiers = false;
 }
 
+/*
+  Weight of the newest sample in the apply capacity estimate.
+*/
+static const double APPLY_CAPACITY_WEIGHT = 0.3;
+
 Pipeline_member_stats::Pipeline_member_stats()
     : m_transactions_waiting_apply(0),
       m_transactions_applied(0),
@@ -303,7 +309,9 @@ Pipeline_member_stats::Pipeline_member_stats()
       m_transactions_local(0),
       m_delta_transactions_local(0),
       m_transactions_committed_all_members(),
-      m_stamp(0) {}
+      m_stamp(0),
+      m_apply_capacity(0),
+      m_predicted_max_rate(0) {}
 
 Pipeline_member_stats::Pipeline_member_stats(Pipeline_stats_member_message &msg)
     : m_transactions_waiting_apply(msg.get_transactions_waiting_apply()),
@@ -313,7 +321,9 @@ Pipeline_member_stats::Pipeline_member_stats(Pipeline_stats_member_message &msg)
       m_delta_transactions_local(0),
       m_transactions_committed_all_members(
           msg.get_transaction_committed_all_members()),
-      m_stamp(0) {}
+      m_stamp(0),
+      m_apply_capacity(0),
+      m_predicted_max_rate(0) {}
 
 Pipeline_member_stats::Pipeline_member_stats(
     Pipeline_stats_member_collector *pipeline_stats) {
@@ -324,11 +334,13 @@ Pipeline_member_stats::Pipeline_member_stats(
   m_transactions_local = pipeline_stats->get_transactions_local();
   m_delta_transactions_local = 0;
   m_stamp = 0;
+  m_apply_capacity = 0;
+  m_predicted_max_rate = 0;
 }
 
 void Pipeline_member_stats::update_member_stats(
     Pipeline_stats_member_message &msg, uint64 stamp) {
-
+  int32 previous_transactions_waiting_apply = m_transactions_waiting_apply;
   m_transactions_waiting_apply = msg.get_transactions_waiting_apply();
 
   int64 previous_transactions_applied = m_transactions_applied;
@@ -341,6 +353,25 @@ void Pipeline_member_stats::update_member_stats(
   m_delta_transactions_local =
       m_transactions_local - previous_transactions_local;
 
+  /*
+    The applied rate is the member's capacity only when its applier had work
+    during the whole period.
+  */
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if (m_stamp > 0 && previous_transactions_waiting_apply > 0 &&
+      m_transactions_waiting_apply > 0) {
+    double elapsed = std::chrono::duration<double>(now - m_update_time).count();
+    if (elapsed > 0) {
+      double rate = m_delta_transactions_applied / elapsed;
+      m_apply_capacity =
+          m_apply_capacity == 0
+              ? rate
+              : APPLY_CAPACITY_WEIGHT * rate +
+                    (1 - APPLY_CAPACITY_WEIGHT) * m_apply_capacity;
+    }
+  }
+  m_update_time = now;
+
   /*
     Only update the transaction GTIDs if the current stats message contains
     these GTIDs, i.e. if they are "dirty" and in need of an update. Currently
@@ -387,27 +418,52 @@ void Pipeline_member_stats::set_transaction_committed_all_members(char *str,
 
 uint64 Pipeline_member_stats::get_stamp() { return m_stamp; }
 
+double Pipeline_member_stats::get_apply_capacity() { return m_apply_capacity; }
+
+double Pipeline_member_stats::get_predicted_max_rate() {
+  return m_predicted_max_rate;
+}
+
+void Pipeline_member_stats::set_predicted_max_rate(double rate) {
+  m_predicted_max_rate = rate;
+}
+
+const int Flow_stat_module::FLOW_CONTROL_HORIZON = 5;
+const double Flow_stat_module::MIN_COMMIT_RATE = 1;
+const int Flow_stat_module::MAX_COMMIT_WAIT = 1;
+
 Flow_stat_module::Flow_stat_module()
-    : m_stamp(0),
-      seconds_to_skip(1) {
+    : m_stamp(0), seconds_to_skip(1), m_commit_rate(0), m_tokens(0) {
   m_flow_stat_module_info_lock = new Checkable_rwlock(
 #ifdef HAVE_PSI_INTERFACE
       key_GR_RWLOCK_flow_stat_module_info
 #endif
   );
+  mysql_mutex_init(key_GR_LOCK_pipeline_stats_flow_control,
+                   &m_flow_control_lock, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_GR_COND_pipeline_stats_flow_control,
+                  &m_flow_control_cond);
 }
 
 Flow_stat_module::~Flow_stat_module() {
   delete m_flow_stat_module_info_lock;
+  mysql_mutex_destroy(&m_flow_control_lock);
+  mysql_cond_destroy(&m_flow_control_cond);
 }
 
 void Flow_stat_module::flow_stat_step(
     Pipeline_stats_member_collector *member) {
   if (--seconds_to_skip > 0) return;
 
-  seconds_to_skip = 10;
+  bool const predictive = get_flow_control_mode_var() == FCM_PREDICTIVE;
+  seconds_to_skip = predictive ? 1 : 10;
   m_stamp++;
 
+  if (predictive)
+    flow_control_step();
+  else
+    set_commit_rate(0);
+
   /*
     Send statistics to other members
   */
@@ -447,6 +503,139 @@ int Flow_stat_module::handle_stats_data(const uchar *data, size_t len,
   return error;
 }
 
+void Flow_stat_module::flow_control_step() {
+  int64 threshold = get_flow_control_applier_threshold_var();
+  double group_rate = 0;
+  int64 total_local = 0;
+  int64 my_local = 0;
+  int writers = 1;
+  std::string const &my_id =
+      local_member_info->get_gcs_member_id().get_member_id();
+
+  m_flow_stat_module_info_lock->wrlock();
+  for (Flow_stat_module_info::iterator it = m_info.begin(); it != m_info.end();
+       ++it) {
+    Pipeline_member_stats &stats = it->second;
+    double rate = 0;
+
+    /* Members that stopped sending stats no longer count. */
+    if (stats.get_stamp() + 2 < m_stamp) {
+      stats.set_predicted_max_rate(0);
+      continue;
+    }
+
+    /*
+      A member that keeps up with the group does not limit it. One that is
+      behind can take its capacity plus what brings its queue to the
+      threshold within the horizon, less if it is already above it.
+    */
+    if (stats.get_apply_capacity() > 0 &&
+        stats.get_transactions_waiting_apply() > 0) {
+      rate = stats.get_apply_capacity() +
+             static_cast<double>(threshold -
+                                 stats.get_transactions_waiting_apply()) /
+                 FLOW_CONTROL_HORIZON;
+      rate = std::max(rate, MIN_COMMIT_RATE);
+      if (group_rate == 0 || rate < group_rate) group_rate = rate;
+    }
+    stats.set_predicted_max_rate(rate);
+
+    int64 const local =
+        std::max<int64>(stats.get_delta_transactions_local(), 0);
+    total_local += local;
+    if (it->first == my_id)
+      my_local = local;
+    else if (local > 0)
+      writers++;
+  }
+  m_flow_stat_module_info_lock->unlock();
+
+  /*
+    Half of the group rate is split by what each member recently committed,
+    and half evenly among the members that write, this one included. A
+    member that committed little is thus not held at MIN_COMMIT_RATE, and
+    can grow its share when its demand grows.
+  */
+  double rate = 0;
+  if (group_rate > 0) {
+    double share = total_local > 0
+                       ? static_cast<double>(my_local) / total_local
+                       : 1.0 / writers;
+    share = (share + 1.0 / writers) / 2;
+    rate = std::max(group_rate * share, MIN_COMMIT_RATE);
+  }
+  set_commit_rate(rate);
+}
+
+void Flow_stat_module::set_commit_rate(double rate) {
+  mysql_mutex_lock(&m_flow_control_lock);
+  if (m_commit_rate == 0 && rate > 0) {
+    m_tokens = 0;
+    m_refill_time = std::chrono::steady_clock::now();
+  }
+  m_commit_rate = rate;
+  mysql_cond_broadcast(&m_flow_control_cond);
+  mysql_mutex_unlock(&m_flow_control_lock);
+}
+
+double Flow_stat_module::get_commit_rate() {
+  mysql_mutex_lock(&m_flow_control_lock);
+  double rate = m_commit_rate;
+  mysql_mutex_unlock(&m_flow_control_lock);
+  return rate;
+}
+
+void Flow_stat_module::do_wait() {
+  DBUG_TRACE;
+  THD *thd = current_thd;
+  std::chrono::steady_clock::time_point const deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(MAX_COMMIT_WAIT);
+
+  mysql_mutex_lock(&m_flow_control_lock);
+  while (m_commit_rate > 0 && !get_plugin_is_stopping() &&
+         (thd == nullptr || !thd->is_killed())) {
+    /* Allow bursts of a tenth of a second worth of commits. */
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    double burst = std::max(m_commit_rate / 10, 1.0);
+    m_tokens = std::min(
+        burst,
+        m_tokens + m_commit_rate *
+                       std::chrono::duration<double>(now - m_refill_time)
+                           .count());
+    m_refill_time = now;
+    if (m_tokens >= 1) {
+      m_tokens -= 1;
+      break;
+    }
+
+    /*
+      Like the stock flow control, never hold a transaction for more than a
+      period. It still takes its token, owing at most a second of commits.
+    */
+    if (now >= deadline) {
+      m_tokens = std::max(m_tokens - 1, -m_commit_rate);
+      break;
+    }
+
+    ulonglong wait_ns = static_cast<ulonglong>(
+        std::min((1 - m_tokens) / m_commit_rate,
+                 std::chrono::duration<double>(deadline - now).count()) *
+        1000000000ULL);
+    struct timespec abstime;
+    set_timespec_nsec(&abstime, wait_ns);
+    mysql_cond_timedwait(&m_flow_control_cond, &m_flow_control_lock,
+                         &abstime);
+  }
+  mysql_mutex_unlock(&m_flow_control_lock);
+}
+
+void Flow_stat_module::get_all_pipeline_stats(Flow_stat_module_info &info) {
+  m_flow_stat_module_info_lock->rdlock();
+  info = m_info;
+  m_flow_stat_module_info_lock->unlock();
+}
+
 Pipeline_member_stats *Flow_stat_module::get_pipeline_stats(
     const std::string &member_id) {
   Pipeline_member_stats *member_pipeline_stats = nullptr;
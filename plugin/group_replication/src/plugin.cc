@@ -317,6 +317,12 @@ const char *get_single_primary_election_mode_string(int index) {
 
 ulong get_communication_stack_var() { return ov.communication_stack_var; }
 
+ulong get_flow_control_mode_var() { return ov.flow_control_mode_var; }
+
+long get_flow_control_applier_threshold_var() {
+  return ov.flow_control_applier_threshold_var;
+}
+
 bool is_autorejoin_enabled() { return ov.autorejoin_tries_var > 0U; }
 
 uint get_number_of_autorejoin_tries() { return ov.autorejoin_tries_var; }
@@ -2395,6 +2401,11 @@ int build_gcs_parameters(Gcs_interface_parameters &gcs_module_parameters) {
                                       member_expel_timeout_stream_buffer.str());
   gcs_module_parameters.add_parameter(
       "xcom_cache_size", std::to_string(ov.message_cache_size_var));
+  gcs_module_parameters.add_parameter(
+      "xcom_cache_spill_size", std::to_string(ov.message_cache_spill_size_var));
+  gcs_module_parameters.add_parameter(
+      "xcom_cache_spill_file",
+      std::string(mysql_real_data_home) + "#gr_xcom_cache_spill");
 
   gcs_module_parameters.add_parameter(
       "communication_stack", std::to_string(ov.communication_stack_var));
@@ -4197,6 +4208,51 @@ static MYSQL_SYSVAR_ULONG(
     0                           /* block */
 );
 
+static MYSQL_SYSVAR_ULONG(
+    message_cache_spill_size,                              /* name */
+    ov.message_cache_spill_size_var,                       /* var */
+    PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_PERSIST_AS_READ_ONLY, /* optional var */
+    "The size (in bytes) of the file in the data directory that messages "
+    "evicted from Group Replication's internal message cache are kept in, "
+    "so that members which fall behind can still get them. 0 disables it. "
+    "Takes effect on the next START GROUP_REPLICATION.",
+    nullptr,                          /* check func. */
+    nullptr,                          /* update func. */
+    DEFAULT_MESSAGE_CACHE_SPILL_SIZE, /* default */
+    MIN_MESSAGE_CACHE_SPILL_SIZE,     /* min */
+    MAX_MESSAGE_CACHE_SPILL_SIZE,     /* max */
+    0                                 /* block */
+);
+
+static MYSQL_SYSVAR_ENUM(
+    flow_control_mode,        /* name */
+    ov.flow_control_mode_var, /* var */
+    PLUGIN_VAR_OPCMDARG,      /* optional var */
+    "Specifies the mode used on flow control. "
+    "Possible values are DISABLED and PREDICTIVE. With PREDICTIVE the "
+    "members exchange statistics every second and local commits are paced "
+    "to the rate the slowest member is predicted to apply.",
+    nullptr,                         /* check func. */
+    nullptr,                         /* update func. */
+    FCM_DISABLED,                   /* default */
+    &ov.flow_control_mode_typelib_t /* type lib */
+);
+
+static MYSQL_SYSVAR_LONG(
+    flow_control_applier_threshold,        /* name */
+    ov.flow_control_applier_threshold_var, /* var */
+    PLUGIN_VAR_OPCMDARG,                   /* optional var */
+    "Number of waiting transactions in the applier queue that flow control "
+    "lets a member reach before its apply rate limits the group. "
+    "Default: 25000",
+    nullptr,                        /* check func. */
+    nullptr,                        /* update func. */
+    DEFAULT_FLOW_CONTROL_THRESHOLD, /* default */
+    MIN_FLOW_CONTROL_THRESHOLD,     /* min */
+    MAX_FLOW_CONTROL_THRESHOLD,     /* max */
+    0                               /* block */
+);
+
 // Recovery module variables
 
 static MYSQL_SYSVAR_ULONG(
@@ -4972,6 +5028,9 @@ static SYS_VAR *group_replication_system_vars[] = {
     MYSQL_SYSVAR(primary_election_mode),
     MYSQL_SYSVAR(member_expel_timeout),
     MYSQL_SYSVAR(message_cache_size),
+    MYSQL_SYSVAR(message_cache_spill_size),
+    MYSQL_SYSVAR(flow_control_mode),
+    MYSQL_SYSVAR(flow_control_applier_threshold),
     MYSQL_SYSVAR(clone_threshold),
     MYSQL_SYSVAR(donor_threshold),
     MYSQL_SYSVAR(recovery_tls_version),
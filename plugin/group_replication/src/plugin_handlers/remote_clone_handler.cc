@@ -25,6 +25,7 @@
 #include "plugin/group_replication/include/leave_group_on_failure.h"
 #include "plugin/group_replication/include/plugin.h"
 #include "plugin/group_replication/include/plugin_variables/recovery_endpoints.h"
+#include "plugin/group_replication/include/services/system_variable/get_system_variable.h"
 
 void *Remote_clone_handler::launch_thread(void *arg) {
   Remote_clone_handler *thd = static_cast<Remote_clone_handler *>(arg);
@@ -362,6 +363,25 @@ void Remote_clone_handler::get_clone_donors(
   }
 
   delete all_members_info;
+
+  /*
+    A member this server was cloned from can send the pages changed since
+    instead of all data, try it first.
+  */
+  std::string base_uuid;
+  Get_system_variable get_system_variable;
+
+  if (suitable_donors.size() > 1 &&
+      !get_system_variable.get_global_clone_incremental_base(base_uuid) &&
+      !base_uuid.empty()) {
+    auto it = std::find_if(suitable_donors.begin(), suitable_donors.end(),
+                           [&base_uuid](Group_member_info *member) {
+                             return member->get_uuid() == base_uuid;
+                           });
+    if (it != suitable_donors.end()) {
+      suitable_donors.splice(suitable_donors.begin(), suitable_donors, it);
+    }
+  }
 }
 
 int Remote_clone_handler::set_clone_ssl_options(
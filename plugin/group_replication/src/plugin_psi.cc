@@ -53,6 +53,7 @@ PSI_mutex_key key_GR_LOCK_applier_module_run,
     key_GR_LOCK_group_part_handler_abort,
     key_GR_LOCK_group_part_handler_run,
     key_GR_LOCK_pipeline_continuation,
+    key_GR_LOCK_pipeline_stats_flow_control,
     key_GR_LOCK_pipeline_stats_transactions_waiting_apply,
     key_GR_LOCK_plugin_modules_termination,
     key_GR_LOCK_plugin_applier_module_initialize_terminate,
@@ -290,6 +291,9 @@ static PSI_mutex_info all_group_replication_psi_mutex_keys[] = {
      PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
     {&key_GR_LOCK_pipeline_continuation, "LOCK_pipeline_continuation",
      PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
+    {&key_GR_LOCK_pipeline_stats_flow_control,
+     "LOCK_pipeline_stats_flow_control", PSI_FLAG_SINGLETON, 0,
+     PSI_DOCUMENT_ME},
     {&key_GR_LOCK_pipeline_stats_transactions_waiting_apply,
      "LOCK_pipeline_stats_transactions_waiting_apply", PSI_FLAG_SINGLETON, 0,
      PSI_DOCUMENT_ME},
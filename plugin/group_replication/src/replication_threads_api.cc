@@ -23,6 +23,7 @@
 
 #include <sstream>
 
+#include "plugin/group_replication/include/pipeline_interfaces.h"
 #include "plugin/group_replication/include/plugin.h"
 #include "plugin/group_replication/include/replication_threads_api.h"
 
@@ -203,6 +204,14 @@ int Replication_thread_api::queue_packet(const char *buf, ulong event_len,
   return channel_queue_packet(interface_channel, buf, event_len, io_buffered);
 }
 
+int Replication_thread_api::add_transaction_dependencies(
+    const Transaction_dependencies &dependencies) {
+  return channel_add_transaction_dependencies(
+      interface_channel, dependencies.gno, dependencies.sequence_number,
+      dependencies.barrier, dependencies.parents.data(),
+      dependencies.parents.size());
+}
+
 bool Replication_thread_api::is_applier_thread_waiting() {
   return (channel_is_applier_waiting(interface_channel) == 1);
 }
@@ -27,6 +27,7 @@
 // safeguard due unknown gtid_executed or gtid_purged length
 constexpr size_t GTID_VALUES_FETCH_BUFFER_SIZE{500000};
 constexpr size_t BOOL_VALUES_FETCH_BUFFER_SIZE{4};
+constexpr size_t UUID_VALUES_FETCH_BUFFER_SIZE{36};
 
 int Get_system_variable_parameters::get_error() { return m_error; }
 
@@ -125,6 +126,29 @@ int Get_system_variable::get_global_super_read_only(bool &value) {
   return error;
 }
 
+int Get_system_variable::get_global_clone_incremental_base(
+    std::string &donor_uuid) {
+  int error = 1;
+
+  if (nullptr == mysql_thread_handler) {
+    return 1;
+  }
+
+  Get_system_variable_parameters *parameter =
+      new Get_system_variable_parameters(
+          Get_system_variable_parameters::VAR_CLONE_INCREMENTAL_BASE);
+  Mysql_thread_task *task = new Mysql_thread_task(this, parameter);
+  error = mysql_thread_handler->trigger(task);
+  error |= parameter->get_error();
+
+  if (!error) {
+    donor_uuid.assign(parameter->m_result);
+  }
+
+  delete task;
+  return error;
+}
+
 bool Get_system_variable::string_to_bool(const std::string &value) {
   if (value == "ON") {
     return true;
@@ -157,6 +181,11 @@ void Get_system_variable::run(Mysql_thread_body_parameters *parameters) {
           std::string("super_read_only"), param->m_result,
           BOOL_VALUES_FETCH_BUFFER_SIZE));
       break;
+    case Get_system_variable_parameters::VAR_CLONE_INCREMENTAL_BASE:
+      param->set_error(internal_get_system_variable(
+          std::string("innodb_clone_incremental_base"), param->m_result,
+          UUID_VALUES_FETCH_BUFFER_SIZE));
+      break;
     default:
       param->set_error(1);
   }
@@ -277,7 +277,8 @@ static char *group_replication_set_communication_protocol(
   }
 
   Gcs_protocol_version gcs_protocol =
-    convert_to_gcs_protocol(requested_version, my_version);
+    convert_to_gcs_protocol(requested_version, my_version,
+                            gcs_module->get_maximum_protocol_version());
 
   Communication_protocol_action group_action(gcs_protocol);
   Group_action_diagnostics action_diagnostics;
@@ -144,17 +144,9 @@ static mysql_compress_context *compress_context(NET *net) {
   return mysql_compress_ctx;
 }
 
-/** Init with packet info. */
+/** Reset the packet state of a NET with an allocated packet buffer. */
 
-bool my_net_init(NET *net, Vio *vio) {
-  DBUG_TRACE;
-  net->vio = vio;
-  my_net_local_init(net); /* Set some limits */
-  if (!(net->buff = (uchar *)my_malloc(
-            key_memory_NET_buff,
-            (size_t)net->max_packet + NET_HEADER_SIZE + COMP_HEADER_SIZE,
-            MYF(MY_WME))))
-    return true;
+static void net_init_state(NET *net) {
   net->buff_end = net->buff + net->max_packet;
   net->error = NET_ERROR_UNSET;
   net->return_status = nullptr;
@@ -165,6 +157,20 @@ bool my_net_init(NET *net, Vio *vio) {
   net->reading_or_writing = 0;
   net->where_b = net->remain_in_buf = 0;
   net->last_errno = 0;
+}
+
+/** Init with packet info. */
+
+bool my_net_init(NET *net, Vio *vio) {
+  DBUG_TRACE;
+  net->vio = vio;
+  my_net_local_init(net); /* Set some limits */
+  if (!(net->buff = (uchar *)my_malloc(
+            key_memory_NET_buff,
+            (size_t)net->max_packet + NET_HEADER_SIZE + COMP_HEADER_SIZE,
+            MYF(MY_WME))))
+    return true;
+  net_init_state(net);
 #ifdef MYSQL_SERVER
   net->extension = nullptr;
 #else
@@ -188,12 +194,39 @@ bool my_net_init(NET *net, Vio *vio) {
   return false;
 }
 
-void net_end(NET *net) {
-  DBUG_TRACE;
 #ifdef MYSQL_SERVER
+bool my_net_reinit(NET *net, Vio *vio) {
+  DBUG_TRACE;
+  const ulong max_packet = net->max_packet;
+  net->vio = vio;
+  my_net_local_init(net);
+  if (net->max_packet != max_packet) {
+    /* A packet grew the buffer, or net_buffer_length was changed. */
+    my_free(net->buff);
+    net->buff = nullptr;
+    return my_net_init(net, vio);
+  }
+  net_init_state(net);
+  net->extension = nullptr;
+  if (vio) {
+    net->fd = vio_fd(vio);
+    vio_fastsend(vio);
+  }
+  return false;
+}
+
+void net_end_keep_buffer(NET *net) {
+  DBUG_TRACE;
   NET_SERVER *server_extension = static_cast<NET_SERVER *>(net->extension);
   if (server_extension != nullptr)
     mysql_compress_context_deinit(&server_extension->compress_ctx);
+}
+#endif
+
+void net_end(NET *net) {
+  DBUG_TRACE;
+#ifdef MYSQL_SERVER
+  net_end_keep_buffer(net);
 #else
   net_extension_free(net);
 #endif
@@ -977,6 +1010,31 @@ static bool net_write_buff(NET *net, const uchar *packet, size_t len) {
   return false;
 }
 
+/**
+  Record in the network handler that writing to it failed.
+
+  @param  net     NET handler.
+*/
+
+static void net_write_failed(NET *net) {
+#ifdef MYSQL_SERVER
+  /* Socket should be closed. */
+  net->error = NET_ERROR_SOCKET_UNUSABLE;
+#else
+  /* Socket has failed for writing but it might still work for reading. */
+  net->error = NET_ERROR_SOCKET_NOT_WRITABLE;
+#endif
+  /* Interrupted by a timeout? */
+  if (vio_was_timeout(net->vio))
+    net->last_errno = ER_NET_WRITE_INTERRUPTED;
+  else
+    net->last_errno = ER_NET_ERROR_ON_WRITE;
+
+#ifdef MYSQL_SERVER
+  my_error(net->last_errno, MYF(0));
+#endif
+}
+
 /**
   Write a determined number of bytes to a network handler.
 
@@ -1010,28 +1068,113 @@ static bool net_write_raw_loop(NET *net, const uchar *buf, size_t count) {
   }
 
   /* On failure, propagate the error code. */
-  if (count) {
-#ifdef MYSQL_SERVER
-    /* Socket should be closed. */
-    net->error = NET_ERROR_SOCKET_UNUSABLE;
-#else
-    /* Socket has failed for writing but it might still work for reading. */
-    net->error = NET_ERROR_SOCKET_NOT_WRITABLE;
-#endif
-    /* Interrupted by a timeout? */
-    if (vio_was_timeout(net->vio))
-      net->last_errno = ER_NET_WRITE_INTERRUPTED;
-    else
-      net->last_errno = ER_NET_ERROR_ON_WRITE;
+  if (count) net_write_failed(net);
+
+  return count != 0;
+}
+
+/**
+  Write a determined number of bytes of a file to a network handler, without
+  copying them to user space.
+
+  @param  net     NET handler.
+  @param  file    The file to read the data from.
+  @param  offset  Where the data starts in the file.
+  @param  count   The length, in bytes, of the data.
+
+  @return true on error, false on success.
+*/
+
+static bool net_write_file_loop(NET *net, File file, my_off_t offset,
+                                size_t count) {
+  unsigned int retry_count = 0;
+
+  /* Socket can't be used */
+  if (net->error == NET_ERROR_SOCKET_UNUSABLE ||
+      net->error == NET_ERROR_SOCKET_NOT_WRITABLE)
+    return true;
+
+  net->reading_or_writing = 2;
+
+  while (count) {
+    size_t sentcnt = vio_sendfile(net->vio, file, offset, count);
+
+    /* VIO_SOCKET_ERROR (-1) indicates an error. */
+    if (sentcnt == VIO_SOCKET_ERROR) {
+      /* A recoverable I/O error occurred? */
+      if (net_should_retry(net, &retry_count))
+        continue;
+      else
+        break;
+    }
+    /* The file is shorter than expected. */
+    if (sentcnt == 0) break;
 
+    count -= sentcnt;
+    offset += sentcnt;
 #ifdef MYSQL_SERVER
-    my_error(net->last_errno, MYF(0));
+    thd_increment_bytes_sent(sentcnt);
 #endif
   }
 
+  net->reading_or_writing = 0;
+
+  /*
+    On failure, propagate the error code. The packet header promised more
+    bytes than were sent, so the connection cannot be used any more.
+  */
+  if (count) net_write_failed(net);
+
   return count != 0;
 }
 
+bool my_net_write_file(NET *net, const uchar *prefix, size_t prefix_len,
+                       File file, my_off_t offset, size_t length) {
+  uchar buff[NET_HEADER_SIZE];
+  DBUG_TRACE;
+
+  if (unlikely(!net->vio)) /* nowhere to write */
+    return false;
+
+  assert(!net->compress);
+  assert(vio_can_sendfile(net->vio));
+
+  /* turn off non blocking operations */
+  if (!vio_is_blocking(net->vio)) vio_set_blocking_flag(net->vio, true);
+
+  /*
+    Split the payload into packets the way my_net_write() does. Headers and
+    the prefix go through the write buffer, which is flushed before each
+    part of the file is sent so the stream stays in order.
+  */
+  const size_t len = prefix_len + length;
+  size_t sent = 0;
+  for (;;) {
+    const size_t z_size = std::min(len - sent, size_t{MAX_PACKET_LENGTH});
+    int3store(buff, static_cast<uint>(z_size));
+    buff[3] = (uchar)net->pkt_nr++;
+    if (net_write_buff(net, buff, NET_HEADER_SIZE)) return true;
+
+    size_t from_prefix = 0;
+    if (sent < prefix_len) {
+      from_prefix = std::min(prefix_len - sent, z_size);
+      if (net_write_buff(net, prefix + sent, from_prefix)) return true;
+    }
+
+    const size_t from_file = z_size - from_prefix;
+    if (from_file > 0) {
+      const my_off_t file_pos = offset + (sent + from_prefix - prefix_len);
+      if (net_flush(net) || net_write_file_loop(net, file, file_pos, from_file))
+        return true;
+    }
+
+    sent += z_size;
+    /* The last packet is always shorter than MAX_PACKET_LENGTH. */
+    if (z_size < MAX_PACKET_LENGTH) break;
+  }
+  return false;
+}
+
 /* clang-format off */
 /**
   @page page_protocol_basic_compression Compression
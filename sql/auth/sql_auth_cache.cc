@@ -64,6 +64,7 @@
 #include "sql/mdl.h"
 #include "sql/mysqld.h"          // my_localhost
 #include "sql/psi_memory_key.h"  // key_memory_acl_mem
+#include "sql/result_cache.h"    // result_cache
 #include "sql/set_var.h"
 #include "sql/sql_audit.h"
 #include "sql/sql_base.h"   // open_and_lock_tables
@@ -3701,6 +3702,7 @@ bool reload_acl_caches(THD *thd, bool mdl_locked) {
   DBUG_EXECUTE_IF("wl14084_trigger_acl_ddl_timeout", sleep(2););
 
 end:
+  result_cache.invalidate_all();
   /*
     When reload_acl_caches() is called with mdl_locked = true,
     it implies that caller has all required MDLs in place and
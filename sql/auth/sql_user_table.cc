@@ -73,6 +73,7 @@
 #include "sql/mysqld.h"
 #include "sql/rpl_filter.h" /* rpl_filter */
 #include "sql/rpl_rli.h"    /* class Relay_log_info */
+#include "sql/result_cache.h" /* result_cache */
 #include "sql/sql_base.h"   /* close_thread_tables */
 #include "sql/sql_class.h"
 #include "sql/sql_connect.h"
@@ -654,6 +655,8 @@ static bool acl_end_trans_and_close_tables(THD *thd,
     reload_acl_caches(thd, true);
     close_thread_tables(thd);
   }
+  /* Cached results may have been computed with the old privileges. */
+  result_cache.invalidate_all();
   thd->mdl_context.release_transactional_locks();
 
   return result;
@@ -78,6 +78,13 @@ class Basic_seekable_istream : public Basic_istream {
      The total length of the stream.
    */
   virtual my_off_t length() = 0;
+  /**
+     The file the stream reads from, if the bytes of the stream are the bytes
+     of the file at the same offsets, so the file can be read directly.
+
+     @retval -1 The stream has no such file.
+  */
+  virtual File plain_file() const { return -1; }
   ~Basic_seekable_istream() override = default;
 };
 
@@ -120,6 +127,7 @@ class IO_CACHE_istream : public Basic_seekable_istream {
      Get the length of the file.
   */
   my_off_t length() override;
+  File plain_file() const override { return m_io_cache.file; }
 
  private:
   IO_CACHE m_io_cache;
@@ -85,6 +85,7 @@
 #include "partition_info.h"
 #include "prealloced_array.h"
 #include "scope_guard.h"
+#include "sql/binlog/compressing_cache_ostream.h"
 #include "sql/binlog/decompressing_event_object_istream.h"
 #include "sql/binlog/global.h"
 #include "sql/binlog/recovery.h"  // binlog::Binlog_recovery
@@ -107,6 +108,7 @@
 #include "sql/psi_memory_key.h"
 #include "sql/query_options.h"
 #include "sql/raii/sentry.h"  // raii::Sentry<>
+#include "sql/rpl_binlog_event_cache.h"  // binlog_event_cache
 #include "sql/rpl_filter.h"
 #include "sql/rpl_gtid.h"
 #include "sql/rpl_handler.h"  // RUN_HOOK
@@ -419,6 +421,9 @@ class MYSQL_BIN_LOG::Binlog_ofile : public Basic_ostream {
 
     m_pipeline_head = std::move(file_ostream);
 
+    if (m_event_cache != nullptr && !existing)
+      m_event_cache->reset(binlog_name, 0);
+
     /* Setup encryption for new files if needed */
     if (!existing && rpl_encryption.is_enabled()) {
       std::unique_ptr<Binlog_encryption_ostream> encrypted_ostream(
@@ -493,6 +498,7 @@ class MYSQL_BIN_LOG::Binlog_ofile : public Basic_ostream {
   }
 
   void close() {
+    if (m_event_cache != nullptr) m_event_cache->invalidate();
     m_pipeline_head.reset(nullptr);
     m_position = 0;
     m_encrypted_header_size = 0;
@@ -512,6 +518,8 @@ class MYSQL_BIN_LOG::Binlog_ofile : public Basic_ostream {
 
     if (m_pipeline_head->write(buffer, length)) return true;
 
+    if (m_event_cache != nullptr)
+      m_event_cache->append(m_position, buffer, length);
     m_position += length;
     return false;
   }
@@ -529,6 +537,7 @@ class MYSQL_BIN_LOG::Binlog_ofile : public Basic_ostream {
   */
   bool update(const unsigned char *buffer, my_off_t length, my_off_t offset) {
     assert(m_pipeline_head != nullptr);
+    if (m_event_cache != nullptr) m_event_cache->invalidate();
     return m_pipeline_head->seek(offset) ||
            m_pipeline_head->write(buffer, length);
   }
@@ -544,6 +553,7 @@ class MYSQL_BIN_LOG::Binlog_ofile : public Basic_ostream {
   bool truncate(my_off_t offset) {
     assert(m_pipeline_head != nullptr);
 
+    if (m_event_cache != nullptr) m_event_cache->invalidate();
     if (m_pipeline_head->truncate(offset)) return true;
     m_position = offset;
     return false;
@@ -591,12 +601,18 @@ class MYSQL_BIN_LOG::Binlog_ofile : public Basic_ostream {
     Set that the log file is encrypted.
   */
   void set_encrypted() { m_encrypted = true; }
+  /**
+    Copy everything written to the files opened from now on into the given
+    cache of the active binary log, for the dump threads.
+  */
+  void set_event_cache(Binlog_event_cache *cache) { m_event_cache = cache; }
 
  private:
   my_off_t m_position = 0;
   int m_encrypted_header_size = 0;
   std::unique_ptr<Truncatable_ostream> m_pipeline_head;
   bool m_encrypted = false;
+  Binlog_event_cache *m_event_cache = nullptr;
 };
 
 /**
@@ -814,6 +830,7 @@ class binlog_cache_data {
   virtual void reset() {
     compute_statistics();
     remove_pending_event();
+    stop_compression_stream();
 
     if (m_cache.reset()) {
       LogErr(WARNING_LEVEL, ER_BINLOG_CANT_RESIZE_CACHE);
@@ -903,6 +920,23 @@ class binlog_cache_data {
     return is_binlog_empty() || has_empty_transaction();
   }
 
+  /**
+    Start compressing the transaction while it is written to the cache,
+    if @@binlog_transaction_compression_chunk_size allows it. Called
+    before the first event is written to an empty cache.
+  */
+  void start_compression_stream(THD *thd);
+
+  /// Stop compressing while writing, the cache is compressed at commit.
+  void stop_compression_stream() {
+    m_cache.set_tee(nullptr);
+    m_compression_stream.abort();
+  }
+
+  binlog::Compressing_cache_ostream &compression_stream() {
+    return m_compression_stream;
+  }
+
  protected:
   /*
     This structure should have all cache variables/flags that should be restored
@@ -940,6 +974,8 @@ class binlog_cache_data {
   void truncate(my_off_t pos) {
     DBUG_PRINT("info", ("truncating to position %lu", (ulong)pos));
     remove_pending_event();
+    // The stream has compressed bytes that are no longer in the cache.
+    stop_compression_stream();
 
     // TODO: check the return value.
     (void)m_cache.truncate(pos);
@@ -1047,6 +1083,12 @@ class binlog_cache_data {
   */
   Binlog_cache_storage m_cache;
 
+  /*
+    Compresses the bytes written to m_cache while the transaction runs,
+    when it is active.
+  */
+  binlog::Compressing_cache_ostream m_compression_stream;
+
   /*
     Pending binrows event. This event is the event where the rows are currently
     written.
@@ -2082,9 +2124,11 @@ class Binlog_cache_compressor {
   /// transaction has to abort.
   [[NODISCARD]] bool compress() {
     if (!shall_compress()) return false;
-    if (setup_compressor()) return false;
-    if (setup_buffer_sequence()) return false;
-    if (compress_to_buffer_sequence()) return false;
+    if (!finish_compression_stream()) {
+      if (setup_compressor()) return false;
+      if (setup_buffer_sequence()) return false;
+      if (compress_to_buffer_sequence()) return false;
+    }
     Transaction_payload_log_event tple{&m_thd};
     if (get_payload_event_from_buffer_sequence(tple)) return false;
     // Errors occurring above this point prevent us from compressing
@@ -2160,6 +2204,42 @@ class Binlog_cache_compressor {
   ///
   /// @return true on error, false on success.
   [[NODISCARD]] bool setup_buffer_sequence() {
+    setup_buffer_sequence(*m_compressor, m_managed_buffer_sequence);
+    return false;
+  }
+
+  /// Finish the compression done while the transaction was written,
+  /// if it covers the whole cache.
+  ///
+  /// @retval true The compressed transaction is in
+  /// m_managed_buffer_sequence.
+  ///
+  /// @retval false There was no stream, or it failed; the cache has to
+  /// be compressed.
+  [[NODISCARD]] bool finish_compression_stream() {
+    binlog::Compressing_cache_ostream &stream = m_cache.compression_stream();
+    if (!stream.is_active()) return false;
+    if (stream.length() != m_uncompressed_size) {
+      DBUG_PRINT("info", ("compression stream does not match the cache"));
+      stream.abort();
+      return false;
+    }
+    auto *compressor = stream.compressor();
+    {
+      THD_STAGE_GUARD(&m_thd, stage_binlog_transaction_compress);
+      if (stream.finish()) return false;
+    }
+    m_compressed_size = m_managed_buffer_sequence.read_part().size();
+    m_compression_type = compressor->get_type_code();
+    return true;
+  }
+
+ public:
+  /// Configure the buffer sequence that receives the output of the
+  /// given compressor.
+  static void setup_buffer_sequence(
+      binary_log::transaction::compression::Compressor &compressor,
+      Transaction_compression_ctx::Managed_buffer_sequence_t &buffers) {
     mysqlns::buffer::Grow_calculator grow_calculator;
     grow_calculator.set_max_size(
         binary_log::Transaction_payload_event::max_payload_length);
@@ -2167,12 +2247,12 @@ class Binlog_cache_compressor {
                     { grow_calculator.set_max_size(800); });
     grow_calculator.set_grow_factor(2);
     grow_calculator.set_grow_increment(8192);
-    auto compressor_grow_constraint = m_compressor->get_grow_constraint_hint();
+    auto compressor_grow_constraint = compressor.get_grow_constraint_hint();
     grow_calculator = compressor_grow_constraint.combine_with(grow_calculator);
-    m_managed_buffer_sequence.set_grow_calculator(grow_calculator);
-    return false;
+    buffers.set_grow_calculator(grow_calculator);
   }
 
+ private:
   /// Compress the transaction cache using the compressor, and and
   /// store the output in the Managed_buffer_sequence.
   ///
@@ -2267,8 +2347,29 @@ class Binlog_cache_compressor {
 };
 
 bool binlog_cache_data::compress(THD *thd) {
+  // Nothing written to the cache from now on belongs to the transaction.
+  m_cache.set_tee(nullptr);
   Binlog_cache_compressor binlog_cache_compressor(*thd, *this);
-  return binlog_cache_compressor.compress();
+  bool error = binlog_cache_compressor.compress();
+  m_compression_stream.abort();
+  return error;
+}
+
+void binlog_cache_data::start_compression_stream(THD *thd) {
+  assert(m_cache.is_empty());
+  if (opt_binlog_transaction_compression_chunk_size == 0 ||
+      !thd->variables.binlog_trx_compression ||
+      m_compression_stream.is_active())
+    return;
+
+  Transaction_compression_ctx &context =
+      thd->rpl_thd_ctx.transaction_compression_ctx();
+  auto compressor = context.get_compressor(thd);
+  if (compressor == nullptr) return;
+  Binlog_cache_compressor::setup_buffer_sequence(
+      *compressor, context.managed_buffer_sequence());
+  m_compression_stream.begin(compressor, &context.managed_buffer_sequence());
+  m_cache.set_tee(&m_compression_stream);
 }
 
 /**
@@ -3654,6 +3755,8 @@ void MYSQL_BIN_LOG::cleanup() {
     mysql_cond_destroy(&m_prep_xids_cond);
     if (!is_relay_log) {
       Commit_stage_manager::get_instance().deinit();
+    } else {
+      m_relay_log_event_cache.destroy();
     }
   }
 
@@ -3682,6 +3785,10 @@ void MYSQL_BIN_LOG::init_pthread_objects() {
         m_key_LOCK_flush_queue, m_key_LOCK_sync_queue, m_key_LOCK_commit_queue,
         m_key_LOCK_after_commit_queue, m_key_LOCK_done,
         m_key_COND_done, m_key_COND_flush_queue);
+  } else if (m_relay_log_event_cache.init(relay_log_event_cache_size,
+                                          /*for_relay_log=*/true)) {
+    /* Not fatal, the applier reads everything from the relay log file. */
+    LogErr(WARNING_LEVEL, ER_OOM);
   }
 }
 
@@ -3918,6 +4025,14 @@ bool MYSQL_BIN_LOG::open(PSI_file_key log_file_key, const char *log_name,
   */
   if (!is_relay_log) mysql_mutex_lock(&LOCK_sync);
 
+  if (!is_relay_log) {
+    m_binlog_file->set_event_cache(&binlog_event_cache);
+  } else {
+    /* A new size takes effect with the next relay log file. */
+    if (m_relay_log_event_cache.capacity() != relay_log_event_cache_size)
+      m_relay_log_event_cache.resize(relay_log_event_cache_size);
+    m_binlog_file->set_event_cache(&m_relay_log_event_cache);
+  }
   ret = m_binlog_file->open(log_file_key, log_file_name, flags);
 
   if (!is_relay_log) mysql_mutex_unlock(&LOCK_sync);
@@ -4028,6 +4143,17 @@ end:
   return error;
 }
 
+/**
+  Event types the GTID scans of binary and relay logs need to deserialize.
+  The other events are only looked at through their header, or passed
+  undecoded to the transaction boundary parser.
+*/
+static bool is_gtid_scan_event(Log_event_type type) {
+  return type == binary_log::FORMAT_DESCRIPTION_EVENT ||
+         type == binary_log::PREVIOUS_GTIDS_LOG_EVENT ||
+         type == binary_log::GTID_LOG_EVENT;
+}
+
 /**
   Add the GTIDs from the given relaylog file and also
   update the IO thread transaction parser.
@@ -4077,21 +4203,23 @@ static bool read_gtids_and_update_trx_parser_from_relaylog(
   }
 
   Log_event *ev = nullptr;
+  uchar *data = nullptr;
+  uint data_len = 0;
   bool seen_prev_gtids = false;
-  ulong data_len = 0;
 
-  while (!error && (ev = relaylog_file_reader.read_event_object()) != nullptr) {
-    DBUG_PRINT("info", ("Read event of type %s", ev->get_type_str()));
+  while (!error && !relaylog_file_reader.read_event_data_or_object(
+                       is_gtid_scan_event, &data, &data_len, &ev)) {
+    auto type = static_cast<Log_event_type>(data[EVENT_TYPE_OFFSET]);
+    DBUG_PRINT("info", ("Read event of type %s",
+                        Log_event::get_type_str(type)));
 #ifndef NDEBUG
     event_counter++;
 #endif
 
-    data_len = uint4korr(ev->temp_buf + EVENT_LEN_OFFSET);
-
     bool info_error{false};
     binary_log::Log_event_basic_info log_event_info;
     std::tie(info_error, log_event_info) = extract_log_event_basic_info(
-        ev->temp_buf, data_len,
+        reinterpret_cast<const char *>(data), data_len,
         &relaylog_file_reader.format_description_event());
 
     if (info_error || trx_parser->feed_event(log_event_info, false)) {
@@ -4170,7 +4298,7 @@ static bool read_gtids_and_update_trx_parser_from_relaylog(
       }
     }
 
-    switch (ev->get_type_code()) {
+    switch (type) {
       case binary_log::FORMAT_DESCRIPTION_EVENT:
       case binary_log::ROTATE_EVENT:
         // do nothing; just accept this event and go to next
@@ -4262,7 +4390,10 @@ static bool read_gtids_and_update_trx_parser_from_relaylog(
         }
         break;
     }
-    delete ev;
+    if (ev != nullptr)
+      delete ev;
+    else
+      relaylog_file_reader.allocator()->deallocate(data);
   }
 
   if (relaylog_file_reader.has_fatal_error()) {
@@ -4355,15 +4486,24 @@ static enum_read_gtids_from_binlog_status read_gtids_from_binlog(
   }
 
   Log_event *ev = nullptr;
+  uchar *data = nullptr;
+  uint data_len = 0;
   enum_read_gtids_from_binlog_status ret = NO_GTIDS;
   bool done = false;
   bool seen_first_gtid = false;
-  while (!done && (ev = binlog_file_reader.read_event_object()) != nullptr) {
+  /*
+    When all GTIDs are wanted the whole file is read, only the events
+    carrying GTIDs are deserialized.
+  */
+  while (!done && !binlog_file_reader.read_event_data_or_object(
+                      is_gtid_scan_event, &data, &data_len, &ev)) {
+    auto type = static_cast<Log_event_type>(data[EVENT_TYPE_OFFSET]);
 #ifndef NDEBUG
     event_counter++;
 #endif
-    DBUG_PRINT("info", ("Read event of type %s", ev->get_type_str()));
-    switch (ev->get_type_code()) {
+    DBUG_PRINT("info", ("Read event of type %s",
+                        Log_event::get_type_str(type)));
+    switch (type) {
       case binary_log::FORMAT_DESCRIPTION_EVENT:
       case binary_log::ROTATE_EVENT:
         // do nothing; just accept this event and go to next
@@ -4496,7 +4636,10 @@ static enum_read_gtids_from_binlog_status read_gtids_from_binlog(
         if (ret == GOT_PREVIOUS_GTIDS && is_relay_log) done = true;
         break;
     }
-    delete ev;
+    if (ev != nullptr)
+      delete ev;
+    else
+      binlog_file_reader.allocator()->deallocate(data);
     DBUG_PRINT("info", ("done=%d", done));
   }
 
@@ -8890,6 +9033,11 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit) {
                           thd->commit_error));
     return finish_commit(thd);
   }
+  /*
+    The leader reports the stage it executes, so that the time each stage
+    takes shows in the performance schema stage events.
+  */
+  THD_STAGE_INFO(thd, stage_binlog_group_commit_flush);
 
   THD *wait_queue = nullptr, *final_queue = nullptr;
   mysql_mutex_t *leave_mutex_before_commit_stage = nullptr;
@@ -8958,6 +9106,7 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit) {
                           thd->commit_error));
     return finish_commit(thd);
   }
+  THD_STAGE_INFO(thd, stage_binlog_group_commit_sync);
 
   /*
     Shall introduce a delay only if it is going to do sync
@@ -8967,18 +9116,31 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit) {
     it is considered as a special case and delay will be executed
     for every group just like how it is done when sync_binlog= 1.
   */
-  if (!flush_error && (sync_counter + 1 >= get_sync_period()))
+  if (!flush_error && (sync_counter + 1 >= get_sync_period())) {
+    ulong count = opt_binlog_group_commit_sync_no_delay_count;
+    long usec = opt_binlog_group_commit_sync_delay;
+    if (opt_binlog_group_commit_sync_delay_adaptive)
+      Commit_stage_manager::get_instance().adaptive_sync_delay(&count, &usec);
     Commit_stage_manager::get_instance().wait_count_or_timeout(
-        opt_binlog_group_commit_sync_no_delay_count,
-        opt_binlog_group_commit_sync_delay, Commit_stage_manager::SYNC_STAGE);
+        count, usec, Commit_stage_manager::SYNC_STAGE);
+  }
 
   final_queue = Commit_stage_manager::get_instance().fetch_queue_acquire_lock(
       Commit_stage_manager::SYNC_STAGE);
 
   if (flush_error == 0 && total_bytes > 0) {
     DEBUG_SYNC(thd, "before_sync_binlog_file");
+    ulonglong sync_start = my_micro_time();
     std::pair<bool, bool> result = sync_binlog_file(false);
     sync_error = result.first;
+    if (result.second) {
+      ulong group_size = 0;
+      for (THD *tmp_thd = final_queue; tmp_thd != nullptr;
+           tmp_thd = tmp_thd->next_to_commit)
+        group_size++;
+      Commit_stage_manager::get_instance().update_sync_statistics(
+          group_size, my_micro_time() - sync_start);
+    }
   }
 
   if (update_binlog_end_pos_after_sync && flush_error == 0 && sync_error == 0) {
@@ -9028,6 +9190,7 @@ commit_stage:
                             thd->commit_error));
       return finish_commit(thd);
     }
+    THD_STAGE_INFO(thd, stage_binlog_group_commit_commit);
     THD *commit_queue =
         Commit_stage_manager::get_instance().fetch_queue_acquire_lock(
             Commit_stage_manager::COMMIT_STAGE);
@@ -9089,6 +9252,8 @@ commit_stage:
   const auto [check_rotate, force_rotate] =
       Binlog_group_commit_ctx::aggregate_rotate_settings(final_queue);
 
+  THD_STAGE_INFO(thd, stage_waiting_for_handler_commit);
+
   DEBUG_SYNC(thd, "before_signal_done");
   /* Commit done so signal all waiting threads */
   Commit_stage_manager::get_instance().signal_done(final_queue);
@@ -9496,6 +9661,7 @@ static int binlog_start_trans_and_stmt(THD *thd, Log_event *start_event) {
       query = begin;
     }
 
+    if (is_transactional) cache_data->start_compression_stream(thd);
     Query_log_event qinfo(thd, query, qlen, is_transactional, false, true, 0,
                           true);
     if (cache_data->write_event(&qinfo)) return 1;
@@ -48,6 +48,7 @@
 #include "mysql/udf_registration_types.h"
 #include "mysql_com.h"          // Item_result
 #include "sql/binlog_reader.h"  // Binlog_file_reader
+#include "sql/rpl_binlog_event_cache.h"
 #include "sql/rpl_commit_stage_manager.h"
 #include "sql/rpl_trx_tracking.h"
 #include "sql/tc_log.h"            // TC_LOG
@@ -150,6 +151,8 @@ class MYSQL_BIN_LOG : public TC_LOG {
   char db[NAME_LEN + 1];
   bool write_error, inited;
   Binlog_ofile *m_binlog_file;
+  /// Tail of the active relay log, read by the applier. Unused by binlogs.
+  Binlog_event_cache m_relay_log_event_cache;
 
   /** Instrumentation key to use for file io in @c log_file */
   PSI_file_key m_log_file_key;
@@ -1008,6 +1011,14 @@ class MYSQL_BIN_LOG : public TC_LOG {
   mysql_mutex_t *get_binlog_end_pos_lock() { return &LOCK_binlog_end_pos; }
   void lock_binlog_end_pos() { mysql_mutex_lock(&LOCK_binlog_end_pos); }
   void unlock_binlog_end_pos() { mysql_mutex_unlock(&LOCK_binlog_end_pos); }
+  /**
+    The cache of the tail of the active relay log, filled by the receiver
+    thread. Disabled when @@relay_log_event_cache_size is 0.
+  */
+  Binlog_event_cache *get_relay_log_event_cache() {
+    assert(is_relay_log);
+    return &m_relay_log_event_cache;
+  }
 
   /**
     Deep copy global_sid_map and gtid_executed.
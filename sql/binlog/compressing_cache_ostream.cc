@@ -0,0 +1,300 @@
+/*
+   Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "sql/binlog/compressing_cache_ostream.h"
+
+#include <deque>
+
+#include "my_dbug.h"
+#include "my_sys.h"
+#include "my_thread.h"
+#include "mysql/components/services/log_builtins.h"
+#include "mysql/psi/mysql_thread.h"
+#include "mysqld_error.h"
+
+ulonglong opt_binlog_transaction_compression_chunk_size = 0;
+ulong opt_binlog_transaction_compression_threads = 0;
+
+namespace binlog {
+
+using binary_log::transaction::compression::Compress_status;
+
+static PSI_mutex_key key_LOCK_compression_queue;
+static PSI_mutex_key key_LOCK_compression_job;
+static PSI_cond_key key_COND_compression_queue;
+static PSI_cond_key key_COND_compression_job;
+static PSI_thread_key key_thread_binlog_compression;
+
+#ifdef HAVE_PSI_INTERFACE
+static PSI_mutex_info compression_mutexes[] = {
+    {&key_LOCK_compression_queue, "LOCK_binlog_compression_queue",
+     PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
+    {&key_LOCK_compression_job, "Compression_job::lock", 0, 0,
+     PSI_DOCUMENT_ME}};
+
+static PSI_cond_info compression_conds[] = {
+    {&key_COND_compression_queue, "COND_binlog_compression_queue",
+     PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
+    {&key_COND_compression_job, "Compression_job::cond", 0, 0,
+     PSI_DOCUMENT_ME}};
+
+static PSI_thread_info compression_threads[] = {
+    {&key_thread_binlog_compression, "binlog_compression", "bl_compress",
+     PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME}};
+
+static void init_compression_psi_keys() {
+  const char *category = "sql";
+  int count = static_cast<int>(array_elements(compression_mutexes));
+  mysql_mutex_register(category, compression_mutexes, count);
+
+  count = static_cast<int>(array_elements(compression_conds));
+  mysql_cond_register(category, compression_conds, count);
+
+  count = static_cast<int>(array_elements(compression_threads));
+  mysql_thread_register(category, compression_threads, count);
+}
+#endif /* HAVE_PSI_INTERFACE */
+
+/*
+  Chunks waiting for a compression thread. Sessions have at most one
+  chunk each in the queue, so it is bounded by the number of sessions.
+*/
+static mysql_mutex_t LOCK_compression_queue;
+static mysql_cond_t COND_compression_queue;
+static std::deque<Compression_job *> compression_queue;
+static bool compression_threads_stopping = false;
+static std::vector<my_thread_handle> compression_thread_ids;
+/// True between compression_threads_init and compression_threads_deinit.
+static bool compression_queue_inited = false;
+
+Compression_job::Compression_job() {
+  mysql_mutex_init(key_LOCK_compression_job, &lock, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_compression_job, &cond);
+}
+
+Compression_job::~Compression_job() {
+  assert(done);
+  mysql_cond_destroy(&cond);
+  mysql_mutex_destroy(&lock);
+}
+
+void Compression_job::run() {
+  compressor->feed(data.data(), data.size());
+  bool error = compressor->compress(*out) != Compress_status::success;
+
+  mysql_mutex_lock(&lock);
+  failed = error;
+  done = true;
+  mysql_cond_signal(&cond);
+  mysql_mutex_unlock(&lock);
+}
+
+extern "C" {
+static void *compression_thread(void *) {
+  my_thread_init();
+
+  mysql_mutex_lock(&LOCK_compression_queue);
+  for (;;) {
+    while (compression_queue.empty() && !compression_threads_stopping)
+      mysql_cond_wait(&COND_compression_queue, &LOCK_compression_queue);
+    // Chunks still queued at shutdown are compressed before leaving.
+    if (compression_queue.empty()) break;
+    Compression_job *job = compression_queue.front();
+    compression_queue.pop_front();
+    mysql_mutex_unlock(&LOCK_compression_queue);
+
+    job->run();
+
+    mysql_mutex_lock(&LOCK_compression_queue);
+  }
+  mysql_mutex_unlock(&LOCK_compression_queue);
+
+  my_thread_end();
+  my_thread_exit(nullptr);
+  return nullptr;
+}
+}  // extern "C"
+
+bool compression_threads_init() {
+  if (opt_binlog_transaction_compression_threads == 0) return false;
+
+#ifdef HAVE_PSI_INTERFACE
+  init_compression_psi_keys();
+#endif
+  mysql_mutex_init(key_LOCK_compression_queue, &LOCK_compression_queue,
+                   MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_compression_queue, &COND_compression_queue);
+  compression_threads_stopping = false;
+  compression_queue_inited = true;
+
+  my_thread_attr_t attr;
+  if (my_thread_attr_init(&attr)) return true;
+  int error = 0;
+#ifndef _WIN32
+  error = pthread_attr_setscope(&attr, PTHREAD_SCOPE_SYSTEM);
+#endif
+  for (ulong i = 0;
+       error == 0 && i < opt_binlog_transaction_compression_threads; i++) {
+    my_thread_handle id;
+    error = mysql_thread_create(key_thread_binlog_compression, &id, &attr,
+                                compression_thread, nullptr);
+    if (error == 0) compression_thread_ids.push_back(id);
+  }
+  (void)my_thread_attr_destroy(&attr);
+
+  if (error != 0) {
+    LogErr(ERROR_LEVEL, ER_CANT_CREATE_THREAD, error);
+    return true;
+  }
+  return false;
+}
+
+void compression_threads_deinit() {
+  if (!compression_queue_inited) return;
+
+  mysql_mutex_lock(&LOCK_compression_queue);
+  compression_threads_stopping = true;
+  mysql_cond_broadcast(&COND_compression_queue);
+  mysql_mutex_unlock(&LOCK_compression_queue);
+
+  for (my_thread_handle &id : compression_thread_ids)
+    my_thread_join(&id, nullptr);
+  compression_thread_ids.clear();
+
+  compression_queue_inited = false;
+  mysql_cond_destroy(&COND_compression_queue);
+  mysql_mutex_destroy(&LOCK_compression_queue);
+}
+
+/**
+  Queue a chunk for the compression threads.
+
+  @retval false  the chunk was queued
+  @retval true   there are no threads, the caller compresses the chunk
+*/
+static bool queue_compression_job(Compression_job *job) {
+  if (!compression_queue_inited) return true;
+
+  mysql_mutex_lock(&LOCK_compression_queue);
+  bool stopping = compression_threads_stopping;
+  if (!stopping) {
+    compression_queue.push_back(job);
+    mysql_cond_signal(&COND_compression_queue);
+  }
+  mysql_mutex_unlock(&LOCK_compression_queue);
+  return stopping;
+}
+
+Compressing_cache_ostream::~Compressing_cache_ostream() { abort(); }
+
+void Compressing_cache_ostream::begin(Compressor_ptr_t compressor,
+                                      Managed_buffer_sequence_t *out) {
+  DBUG_TRACE;
+  assert(!is_active());
+  m_compressor = std::move(compressor);
+  m_out = out;
+  m_length = 0;
+  m_failed = false;
+  m_chunk.clear();
+  // The size of the transaction is not known until it commits.
+  m_compressor->set_pledged_input_size(Compressor_t::pledged_input_size_unset);
+}
+
+bool Compressing_cache_ostream::write(const unsigned char *buffer,
+                                      my_off_t length) {
+  if (!is_active()) return false;
+  m_length += length;
+  if (m_failed) return false;
+
+  m_chunk.insert(m_chunk.end(), buffer, buffer + length);
+  if (m_chunk.size() >= opt_binlog_transaction_compression_chunk_size)
+    compress_chunk();
+  return false;
+}
+
+void Compressing_cache_ostream::compress_chunk() {
+  wait_for_job();
+  if (m_failed || m_chunk.empty()) return;
+
+  if (m_job == nullptr) m_job = std::make_unique<Compression_job>();
+  m_job->compressor = m_compressor.get();
+  m_job->out = m_out;
+  m_job->failed = false;
+  /*
+    The job takes the bytes and hands back its previous buffer, so the
+    two buffers are reused for the whole transaction.
+  */
+  m_job->data.swap(m_chunk);
+  m_chunk.clear();
+
+  if (opt_binlog_transaction_compression_threads > 0) {
+    m_job->done = false;
+    if (!queue_compression_job(m_job.get())) return;
+    m_job->done = true;
+  }
+  m_job->run();
+  m_failed = m_job->failed;
+}
+
+void Compressing_cache_ostream::wait_for_job() {
+  if (m_job == nullptr) return;
+
+  mysql_mutex_lock(&m_job->lock);
+  while (!m_job->done) mysql_cond_wait(&m_job->cond, &m_job->lock);
+  mysql_mutex_unlock(&m_job->lock);
+  if (m_job->failed) m_failed = true;
+}
+
+bool Compressing_cache_ostream::finish() {
+  DBUG_TRACE;
+  assert(is_active());
+  wait_for_job();
+
+  if (!m_failed) {
+    if (!m_chunk.empty()) m_compressor->feed(m_chunk.data(), m_chunk.size());
+    if (m_compressor->finish(*m_out) == Compress_status::success) {
+      m_compressor.reset();
+      m_out = nullptr;
+      m_chunk.clear();
+      return false;
+    }
+    DBUG_PRINT("info", ("streamed compression failed in Compressor::finish"));
+  }
+  abort();
+  return true;
+}
+
+void Compressing_cache_ostream::abort() {
+  if (!is_active()) return;
+  wait_for_job();
+  m_compressor->reset();
+  m_out->reset();
+  m_compressor.reset();
+  m_out = nullptr;
+  m_length = 0;
+  m_failed = false;
+  m_chunk.clear();
+}
+
+}  // namespace binlog
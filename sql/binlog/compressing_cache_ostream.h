@@ -0,0 +1,173 @@
+/*
+   Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef BINLOG_COMPRESSING_CACHE_OSTREAM_H
+#define BINLOG_COMPRESSING_CACHE_OSTREAM_H
+
+#include <memory>
+#include <vector>
+
+#include "libbinlogevents/include/compression/compressor.h"
+#include "my_inttypes.h"
+#include "mysql/psi/mysql_cond.h"
+#include "mysql/psi/mysql_mutex.h"
+#include "sql/basic_ostream.h"
+
+/// @addtogroup Replication
+/// @{
+///
+/// @file compressing_cache_ostream.h
+///
+/// Compression of a transaction while it is written to the binlog cache.
+
+/// @@binlog_transaction_compression_chunk_size, 0 disables streaming.
+extern ulonglong opt_binlog_transaction_compression_chunk_size;
+/// @@binlog_transaction_compression_threads
+extern ulong opt_binlog_transaction_compression_threads;
+
+namespace binlog {
+
+/// A chunk of a transaction handed to the compression threads.
+struct Compression_job {
+  using Compressor_t = binary_log::transaction::compression::Compressor;
+  using Managed_buffer_sequence_t = Compressor_t::Managed_buffer_sequence_t;
+
+  Compression_job();
+  ~Compression_job();
+  Compression_job(const Compression_job &) = delete;
+  Compression_job &operator=(const Compression_job &) = delete;
+
+  /// Compress the chunk into the output of the transaction.
+  void run();
+
+  Compressor_t *compressor{nullptr};
+  Managed_buffer_sequence_t *out{nullptr};
+  std::vector<unsigned char> data;
+  /// Protects done.
+  mysql_mutex_t lock;
+  mysql_cond_t cond;
+  bool done{true};
+  bool failed{false};
+};
+
+/// Output stream that compresses the bytes of a transaction as they
+/// are written to the binlog cache, instead of reading the whole
+/// cache back and compressing it at commit.
+///
+/// Bytes are collected in chunks of
+/// @@binlog_transaction_compression_chunk_size. Each full chunk is fed
+/// to the session compressor, either by one of the
+/// @@binlog_transaction_compression_threads, while the session goes on
+/// executing the transaction, or by the session itself when there are
+/// no threads. Chunks of a transaction are compressed in order, at most
+/// one at a time, into the same compression frame, so the result is
+/// the same as compressing the cache at once, and the session only has
+/// to compress the last chunk and end the frame at commit.
+///
+/// The stream is abandoned whenever the cache is changed in a way it
+/// cannot follow, e.g. by ROLLBACK TO SAVEPOINT, and the transaction
+/// is then compressed from the cache as before.
+///
+/// Only compression is streamed. The result is still written as one
+/// Transaction_payload_log_event, which readers of the binlog, the
+/// applier included, read whole before Payload_event_buffer_istream
+/// decompresses it.
+class Compressing_cache_ostream : public Basic_ostream {
+ public:
+  using Compressor_t = binary_log::transaction::compression::Compressor;
+  using Compressor_ptr_t = std::shared_ptr<Compressor_t>;
+  using Managed_buffer_sequence_t = Compressor_t::Managed_buffer_sequence_t;
+
+  Compressing_cache_ostream() = default;
+  ~Compressing_cache_ostream() override;
+  Compressing_cache_ostream(const Compressing_cache_ostream &) = delete;
+  Compressing_cache_ostream &operator=(const Compressing_cache_ostream &) =
+      delete;
+
+  /// Start compressing a transaction, before its first byte is
+  /// written to the cache.
+  ///
+  /// @param compressor Compressor of the session. Nobody else may use
+  /// it until finish or abort is called.
+  ///
+  /// @param out Storage for compressed bytes, with the same
+  /// restriction.
+  void begin(Compressor_ptr_t compressor, Managed_buffer_sequence_t *out);
+
+  /// Append bytes written to the cache. Errors are not reported, they
+  /// only make finish fail, since the cache itself is intact.
+  ///
+  /// @retval false always
+  bool write(const unsigned char *buffer, my_off_t length) override;
+
+  bool is_active() const { return m_compressor != nullptr; }
+
+  /// Number of bytes written since begin.
+  my_off_t length() const { return m_length; }
+
+  /// Return the compressor used by the stream.
+  Compressor_t *compressor() const { return m_compressor.get(); }
+
+  /// Compress the remaining bytes and end the frame.
+  ///
+  /// @retval false Success; the output holds the compressed
+  /// transaction.
+  ///
+  /// @retval true Error; the stream was aborted.
+  [[NODISCARD]] bool finish();
+
+  /// Stop compressing, dropping whatever was produced.
+  void abort();
+
+ private:
+  /// Hand the collected bytes over to be compressed.
+  void compress_chunk();
+
+  /// Wait until the previous chunk is compressed.
+  void wait_for_job();
+
+  Compressor_ptr_t m_compressor;
+  Managed_buffer_sequence_t *m_out{nullptr};
+  my_off_t m_length{0};
+  bool m_failed{false};
+  /// Bytes not handed over yet.
+  std::vector<unsigned char> m_chunk;
+  /// Chunk being compressed, allocated on first use.
+  std::unique_ptr<Compression_job> m_job;
+};
+
+/// Start @@binlog_transaction_compression_threads threads.
+///
+/// @retval false Success
+/// @retval true Error, a thread could not be created
+bool compression_threads_init();
+
+/// Stop the threads, after they compressed the queued chunks.
+void compression_threads_deinit();
+
+}  // namespace binlog
+
+/// @}
+
+#endif  // BINLOG_COMPRESSING_CACHE_OSTREAM_H
@@ -190,6 +190,13 @@ class Basic_binlog_ifile : public Basic_seekable_istream {
      raw binlog events.
   */
   my_off_t length() override;
+  /**
+     The binlog file, if it is neither encrypted nor compressed, so that
+     positions in the binlog are offsets in the file.
+  */
+  File plain_file() const override {
+    return m_istream != nullptr ? m_istream->plain_file() : -1;
+  }
 
  protected:
   /**
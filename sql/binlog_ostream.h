@@ -180,8 +180,17 @@ class Binlog_cache_storage : public Basic_ostream {
 
   bool write(const unsigned char *buffer, my_off_t length) override {
     assert(m_pipeline_head != nullptr);
-    return m_pipeline_head->write(buffer, length);
+    if (m_pipeline_head->write(buffer, length)) return true;
+    if (m_tee != nullptr) (void)m_tee->write(buffer, length);
+    return false;
   }
+  /**
+     Also pass every byte written to the cache to the given stream. Errors
+     of the stream are ignored.
+
+     @param[in] tee  The stream, or nullptr to stop passing bytes.
+  */
+  void set_tee(Basic_ostream *tee) { m_tee = tee; }
   /**
      Truncates some data at the end of the binlog cache.
 
@@ -235,6 +244,7 @@ class Binlog_cache_storage : public Basic_ostream {
 
  private:
   Truncatable_ostream *m_pipeline_head = nullptr;
+  Basic_ostream *m_tee = nullptr;
   IO_CACHE_binlog_cache_storage m_file;
 };
 
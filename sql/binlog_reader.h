@@ -83,7 +83,10 @@ class Binlog_event_data_istream {
                        ALLOCATOR *allocator, bool verify_checksum,
                        enum_binlog_checksum_alg checksum_alg) {
     DBUG_TRACE;
-    if (read_event_header() || check_event_header()) return true;
+    if (m_header_read_ahead)
+      m_header_read_ahead = false;
+    else if (read_event_header() || check_event_header())
+      return true;
 
     unsigned char *event_data = allocator->allocate(m_event_length);
     if (event_data == nullptr)
@@ -98,6 +101,28 @@ class Binlog_event_data_istream {
     return false;
   }
 
+  /**
+     Read and check the header of the next event ahead of the rest of it, so
+     that the caller can choose how to read the event, e.g. by its length.
+     The next read_event_data() continues after the header.
+
+     @param[out] header The LOG_EVENT_MINIMAL_HEADER_LEN bytes of the header
+     @retval false Success
+     @retval true Error
+  */
+  bool read_event_header_ahead(const unsigned char **header) {
+    if (!m_header_read_ahead) {
+      if (read_event_header() || check_event_header()) return true;
+      m_header_read_ahead = true;
+    }
+    *header = m_header;
+    return false;
+  }
+  /** Whether a header was read ahead and its event not read yet. */
+  bool has_header_read_ahead() const { return m_header_read_ahead; }
+  /** Forget the header read ahead, when the stream is repositioned. */
+  void drop_header_read_ahead() { m_header_read_ahead = false; }
+
  protected:
   unsigned char m_header[LOG_EVENT_MINIMAL_HEADER_LEN];
   /**
@@ -154,6 +179,7 @@ class Binlog_event_data_istream {
   Basic_istream *m_istream = nullptr;
   unsigned int m_max_event_size;
   unsigned int m_event_length = 0;
+  bool m_header_read_ahead = false;
 
   /**
      Fill the event data into the given buffer and verify checksum if
@@ -349,13 +375,34 @@ class Basic_binlog_file_reader : public IBasic_binlog_file_reader {
 
   bool is_open() const { return m_ifile.is_open(); }
   my_off_t position() const override { return m_ifile.position(); }
-  bool seek(my_off_t pos) { return m_ifile.seek(pos); }
+  bool seek(my_off_t pos) {
+    m_data_istream.drop_header_read_ahead();
+    return m_ifile.seek(pos);
+  }
+
+  /**
+     Wrapper of EVENT_DATA_ISTREAM::read_event_header_ahead.
+  */
+  bool read_event_header(const unsigned char **header) {
+    if (!m_data_istream.has_header_read_ahead())
+      m_event_start_pos = position();
+    return m_data_istream.read_event_header_ahead(header);
+  }
+  /**
+     Position of the next event: the read position, or the start of the
+     event whose header was read by read_event_header().
+  */
+  my_off_t next_event_pos() const {
+    return m_data_istream.has_header_read_ahead() ? m_event_start_pos
+                                                  : position();
+  }
 
   /**
      Wrapper of EVENT_DATA_ISTREAM::read_event_data.
   */
   bool read_event_data(unsigned char **data, unsigned int *length) {
-    m_event_start_pos = position();
+    if (!m_data_istream.has_header_read_ahead())
+      m_event_start_pos = position();
     return m_data_istream.read_event_data(data, length, &m_allocator,
                                           m_verify_checksum,
                                           m_fde.footer()->checksum_alg);
@@ -364,13 +411,80 @@ class Basic_binlog_file_reader : public IBasic_binlog_file_reader {
      wrapper of EVENT_OBJECT_ISTREAM::read_event_object.
   */
   Log_event *read_event_object() override {
-    m_event_start_pos = position();
+    if (!m_data_istream.has_header_read_ahead())
+      m_event_start_pos = position();
     Log_event *ev = m_object_istream.read_event_object(m_fde, m_verify_checksum,
                                                        &m_allocator);
     if (ev && ev->get_type_code() == binary_log::FORMAT_DESCRIPTION_EVENT)
       m_fde = dynamic_cast<Format_description_event &>(*ev);
     return ev;
   }
+  /**
+     Deserialize the event at the current position from a copy of its data
+     that was not read from the file, e.g. found in memory, and move the
+     read position past it as if it had been read.
+
+     @param[in] data    event data, allocated with allocator(). It is owned
+                        by the returned event, or freed on error.
+     @param[in] length  length of the event data
+     @retval nullptr Error
+  */
+  Log_event *read_event_object(unsigned char *data, unsigned int length) {
+    DBUG_TRACE;
+    m_event_start_pos = position();
+    Log_event *ev = nullptr;
+    if (m_error.set_type(binlog_event_deserialize(data, length, &m_fde,
+                                                  m_verify_checksum, &ev))) {
+      m_allocator.deallocate(data);
+      return nullptr;
+    }
+    ev->register_temp_buf(reinterpret_cast<char *>(data),
+                          ALLOCATOR::DELEGATE_MEMORY_TO_EVENT_OBJECT);
+    if (seek(m_event_start_pos + length)) {
+      delete ev;
+      return nullptr;
+    }
+    if (ev->get_type_code() == binary_log::FORMAT_DESCRIPTION_EVENT)
+      m_fde = dynamic_cast<Format_description_event &>(*ev);
+    return ev;
+  }
+
+  /**
+     Read the next event, but deserialize it only if its type is accepted
+     by the given predicate. Scans looking for a few event types, e.g.
+     GTIDs, so skip decoding the bulk of the file, row events.
+
+     @param[in]  decode  returns true for the event types to deserialize
+     @param[out] data    event data
+     @param[out] length  length of the event data
+     @param[out] ev      the event object owning data, or nullptr if the
+                         event was not deserialized. The caller then owns
+                         data and releases it with allocator().
+     @retval false Success
+     @retval true  Error or end of file, see has_fatal_error()
+  */
+  template <class PREDICATE>
+  bool read_event_data_or_object(const PREDICATE &decode, unsigned char **data,
+                                 unsigned int *length, Log_event **ev) {
+    *ev = nullptr;
+    if (read_event_data(data, length)) return true;
+
+    auto type = static_cast<Log_event_type>((*data)[EVENT_TYPE_OFFSET]);
+    if (!decode(type)) return false;
+
+    // The checksum was verified while reading the data.
+    if (m_error.set_type(
+            binlog_event_deserialize(*data, *length, &m_fde, false, ev))) {
+      m_allocator.deallocate(*data);
+      *data = nullptr;
+      return true;
+    }
+    (*ev)->register_temp_buf(reinterpret_cast<char *>(*data),
+                             ALLOCATOR::DELEGATE_MEMORY_TO_EVENT_OBJECT);
+    if (type == binary_log::FORMAT_DESCRIPTION_EVENT)
+      m_fde = dynamic_cast<Format_description_event &>(**ev);
+    return false;
+  }
 
   bool has_fatal_error() const override { return m_error.has_fatal_error(); }
   /**
@@ -38,12 +38,27 @@
 #include "violite.h"
 
 THD *Channel_info::create_thd() {
-  DBUG_EXECUTE_IF("simulate_resource_failure", return nullptr;);
+  THD *thd = thd_to_reuse;
+  thd_to_reuse = nullptr;
+
+  DBUG_EXECUTE_IF("simulate_resource_failure", {
+    delete thd;
+    return nullptr;
+  });
 
   Vio *vio_tmp = create_and_init_vio();
-  if (vio_tmp == nullptr) return nullptr;
+  if (vio_tmp == nullptr) {
+    delete thd;
+    return nullptr;
+  }
+
+  if (thd != nullptr) {
+    thd->init_for_reuse();
+    thd->get_protocol_classic()->reinit_net(vio_tmp);
+    return thd;
+  }
 
-  THD *thd = new (std::nothrow) THD;
+  thd = new (std::nothrow) THD;
   if (thd == nullptr) {
     vio_delete(vio_tmp);
     return nullptr;
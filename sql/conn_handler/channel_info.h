@@ -47,6 +47,12 @@ typedef Vio Vio;
 class Channel_info {
   ulonglong prior_thr_create_utime;
 
+  /**
+    THD reset by THD::reset_for_reuse(), to be initialized by create_thd()
+    instead of a new one.
+  */
+  THD *thd_to_reuse;
+
  protected:
   /**
     Create and initialize a Vio object.
@@ -55,7 +61,7 @@ class Channel_info {
   */
   virtual Vio *create_and_init_vio() const = 0;
 
-  Channel_info() : prior_thr_create_utime(0) {}
+  Channel_info() : prior_thr_create_utime(0), thd_to_reuse(nullptr) {}
 
  public:
   virtual ~Channel_info() = default;
@@ -68,6 +74,15 @@ class Channel_info {
   */
   virtual THD *create_thd();
 
+  /**
+    Let create_thd() initialize a THD reset by THD::reset_for_reuse()
+    rather than allocate one. create_thd() takes ownership of it, and
+    destroys it if it fails.
+
+    @param thd  THD to reuse.
+  */
+  void set_thd_to_reuse(THD *thd) { thd_to_reuse = thd; }
+
   /**
     Send error back to the client and close the channel.
 
@@ -68,8 +68,9 @@ class Per_thread_connection_handler : public Connection_handler {
   static ulong blocked_pthread_count;  // Protected by LOCK_thread_cache.
   static ulong slow_launch_threads;
   static bool shrink_cache;  // Protected by LOCK_thread_cache
-  // System variable
+  // System variables
   static ulong max_blocked_pthreads;
+  static bool reuse_sessions;
 
   static void init();
   static void destroy();
@@ -119,4 +120,60 @@ class One_thread_connection_handler : public Connection_handler {
   uint get_max_threads() const override { return 1; }
 };
 
+struct SHOW_VAR;
+struct THD_event_functions;
+
+/**
+  This class represents the connection handling functionality of a
+  pool of worker threads shared by all connections.
+
+  Connections are spread over thread_pool_size thread groups. Idle
+  connections are parked in the epoll set of their group, and a listener
+  thread per group queues a connection once its client sends a command.
+  Workers of the group then execute one command at a time, allowing about
+  one active worker per group (plus thread_pool_oversubscribe). Commands
+  of connections inside a transaction are queued with high priority so
+  that the locks they hold are released early.
+
+  A worker reporting a wait through thd_wait_begin() no longer counts as
+  active, so another worker may run. A timer thread checks every
+  thread_pool_stall_limit milliseconds that each group with queued work
+  made progress, and lets one more worker run in groups that did not. It
+  also closes connections idle for longer than their wait_timeout.
+*/
+class Thread_pool_connection_handler : public Connection_handler {
+  Thread_pool_connection_handler(const Thread_pool_connection_handler &);
+  Thread_pool_connection_handler &operator=(
+      const Thread_pool_connection_handler &);
+
+ public:
+  // System variables
+  static uint size;
+  static uint stall_limit;
+  static uint oversubscribe;
+  static uint max_threads;
+  static uint idle_timeout;
+
+  // Status variables, queue, wait and stall statistics of the thread groups.
+  static SHOW_VAR status_vars[];
+
+  // Wait notifications the pool needs to replace waiting workers.
+  static THD_event_functions event_functions;
+
+  Thread_pool_connection_handler() = default;
+  ~Thread_pool_connection_handler() override;
+
+  /**
+    Create the thread groups. Threads are started on demand.
+
+    @return true if initialization failed, false otherwise.
+  */
+  bool init();
+
+ protected:
+  bool add_connection(Channel_info *channel_info) override;
+
+  uint get_max_threads() const override { return max_threads; }
+};
+
 #endif  // CONNECTION_HANDLER_IMPL_INCLUDED
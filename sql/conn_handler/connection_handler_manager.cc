@@ -158,6 +158,18 @@ bool Connection_handler_manager::init() {
     case SCHEDULER_NO_THREADS:
       connection_handler = new (std::nothrow) One_thread_connection_handler();
       break;
+    case SCHEDULER_THREAD_POOL: {
+      Thread_pool_connection_handler *thread_pool =
+          new (std::nothrow) Thread_pool_connection_handler();
+      if (thread_pool != nullptr && thread_pool->init()) {
+        delete thread_pool;
+        thread_pool = nullptr;
+      }
+      if (thread_pool != nullptr)
+        event_functions = &Thread_pool_connection_handler::event_functions;
+      connection_handler = thread_pool;
+      break;
+    }
     default:
       assert(false);
   }
@@ -67,6 +67,7 @@
 ulong Per_thread_connection_handler::blocked_pthread_count = 0;
 ulong Per_thread_connection_handler::slow_launch_threads = 0;
 ulong Per_thread_connection_handler::max_blocked_pthreads = 0;
+bool Per_thread_connection_handler::reuse_sessions = false;
 bool Per_thread_connection_handler::shrink_cache = false;
 std::list<Channel_info *>
     *Per_thread_connection_handler ::waiting_channel_info_list = nullptr;
@@ -249,6 +250,8 @@ static void *handle_connection(void *arg) {
       Connection_handler_manager::get_instance();
   Channel_info *channel_info = static_cast<Channel_info *>(arg);
   bool pthread_reused [[maybe_unused]] = false;
+  /* THD of the previous connection, reset for the next one. */
+  THD *thd_to_reuse = nullptr;
 
   if (my_thread_init()) {
     connection_errors_internal++;
@@ -261,7 +264,10 @@ static void *handle_connection(void *arg) {
   }
 
   for (;;) {
+    if (thd_to_reuse != nullptr) channel_info->set_thd_to_reuse(thd_to_reuse);
     THD *thd = init_new_thd(channel_info);
+    const bool thd_reused = thd != nullptr && thd == thd_to_reuse;
+    thd_to_reuse = nullptr;
     if (thd == nullptr) {
       connection_errors_internal++;
       handler_manager->inc_aborted_connects();
@@ -290,6 +296,8 @@ static void *handle_connection(void *arg) {
     /* Save it within THD, so it can be inspected */
     thd->set_psi(psi);
 #endif /* HAVE_PSI_THREAD_INTERFACE */
+    /* The memory of a reused THD is owned by the previous instrumentation. */
+    if (thd_reused) thd->claim_memory_ownership(true);
     mysql_thread_set_psi_id(thd->thread_id());
     mysql_thread_set_psi_THD(thd);
     MYSQL_SOCKET socket = thd->get_protocol_classic()->get_vio()->mysql_socket;
@@ -307,13 +315,28 @@ static void *handle_connection(void *arg) {
     close_connection(thd, 0, false, false);
 
     thd->get_stmt_da()->reset_diagnostics_area();
-    thd->release_resources();
+    /*
+      Keep the THD for the next connection of this pthread if it may block
+      in the thread cache. Like release_resources(), the reset is done
+      before the THD is removed from the THD list, as shutdown waits for
+      the list to be empty.
+    */
+    const bool reuse_thd =
+        Per_thread_connection_handler::reuse_sessions &&
+        Per_thread_connection_handler::max_blocked_pthreads > 0 &&
+        thd->is_reusable();
+    if (reuse_thd)
+      thd->reset_for_reuse();
+    else
+      thd->release_resources();
 
     // Clean up errors now, before possibly waiting for a new connection.
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
     ERR_remove_thread_state(0);
 #endif /* OPENSSL_VERSION_NUMBER < 0x10100000L */
     thd_manager->remove_thd(thd);
+    /* remove_thd() finds the THD by its id, release it only now. */
+    if (reuse_thd) thd_manager->release_thread_id(thd->thread_id());
     Connection_handler_manager::dec_connection_count();
 
 #ifdef HAVE_PSI_THREAD_INTERFACE
@@ -322,7 +345,10 @@ static void *handle_connection(void *arg) {
     mysql_thread_set_psi_THD(nullptr);
 #endif /* HAVE_PSI_THREAD_INTERFACE */
 
-    delete thd;
+    if (reuse_thd)
+      thd_to_reuse = thd;
+    else
+      delete thd;
 
 #ifdef HAVE_PSI_THREAD_INTERFACE
     /* Delete the instrumentation for the job that just completed. */
@@ -345,6 +371,8 @@ static void *handle_connection(void *arg) {
     }
   }
 
+  delete thd_to_reuse;
+
   my_thread_end();
   my_thread_exit(nullptr);
   return nullptr;
@@ -0,0 +1,937 @@
+/*
+   Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+*/
+
+#include "my_config.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <new>
+#include <unordered_set>
+
+#ifdef HAVE_EPOLL
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "my_dbug.h"
+#include "my_inttypes.h"
+#include "my_loglevel.h"
+#include "my_macros.h"
+#include "my_psi_config.h"
+#include "my_systime.h"  // my_micro_time
+#include "my_thread.h"
+#include "mysql/components/services/bits/psi_thread_bits.h"
+#include "mysql/components/services/log_builtins.h"
+#include "mysql/psi/mysql_cond.h"
+#include "mysql/psi/mysql_mutex.h"
+#include "mysql/psi/mysql_socket.h"
+#include "mysql/psi/mysql_thread.h"
+#include "mysql/status_var.h"  // SHOW_VAR
+#include "mysql_com.h"
+#include "mysqld_error.h"                   // ER_*
+#include "sql/conn_handler/channel_info.h"  // Channel_info
+#include "sql/conn_handler/connection_handler_impl.h"
+#include "sql/conn_handler/connection_handler_manager.h"  // Connection_handler_manager
+#include "sql/log.h"                                      // Error_log_throttle
+#include "sql/mysqld.h"                                   // connection_attrib
+#include "sql/mysqld_thd_manager.h"                       // Global_THD_manager
+#include "sql/protocol_classic.h"
+#include "sql/resourcegroups/platform/thread_attrs_api.h"  // num_vcpus
+#include "sql/sql_class.h"                                 // THD
+#include "sql/sql_connect.h"                               // close_connection
+#include "sql/sql_error.h"
+#include "sql/sql_parse.h"             // do_command
+#include "sql/sql_thd_internal_api.h"  // thd_set_thread_stack
+#include "violite.h"
+
+// Initialize static members
+uint Thread_pool_connection_handler::size = 0;
+uint Thread_pool_connection_handler::stall_limit = 500;
+uint Thread_pool_connection_handler::oversubscribe = 3;
+uint Thread_pool_connection_handler::max_threads = 100000;
+uint Thread_pool_connection_handler::idle_timeout = 60;
+
+// Error log throttle for the thread creation failure of the pool threads.
+static Error_log_throttle create_worker_err_log_throttle(
+    Log_throttle ::LOG_THROTTLE_WINDOW_SIZE, ERROR_LEVEL, 0,
+    "connection_handler",
+    "Error log throttle: %10lu"
+    " 'Can't create thread to"
+    " handle new connection'"
+    " error(s) suppressed");
+
+#ifdef HAVE_PSI_INTERFACE
+static PSI_mutex_key key_LOCK_thread_group;
+static PSI_mutex_key key_LOCK_thread_pool_timer;
+
+static PSI_mutex_info all_thread_pool_mutexes[] = {
+    {&key_LOCK_thread_group, "LOCK_thread_group", 0, 0, PSI_DOCUMENT_ME},
+    {&key_LOCK_thread_pool_timer, "LOCK_thread_pool_timer", PSI_FLAG_SINGLETON,
+     0, PSI_DOCUMENT_ME}};
+
+static PSI_cond_key key_COND_thread_group;
+static PSI_cond_key key_COND_thread_pool_timer;
+
+static PSI_cond_info all_thread_pool_conds[] = {
+    {&key_COND_thread_group, "COND_thread_group", 0, 0, PSI_DOCUMENT_ME},
+    {&key_COND_thread_pool_timer, "COND_thread_pool_timer", PSI_FLAG_SINGLETON,
+     0, PSI_DOCUMENT_ME}};
+
+static PSI_thread_key key_thread_pool_worker;
+static PSI_thread_key key_thread_pool_listener;
+static PSI_thread_key key_thread_pool_timer;
+
+static PSI_thread_info all_thread_pool_threads[] = {
+    {&key_thread_pool_worker, "thread_pool_worker", "tp_worker", 0, 0,
+     PSI_DOCUMENT_ME},
+    {&key_thread_pool_listener, "thread_pool_listener", "tp_listen", 0, 0,
+     PSI_DOCUMENT_ME},
+    {&key_thread_pool_timer, "thread_pool_timer", "tp_timer",
+     PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME}};
+#endif
+
+namespace {
+
+struct Thread_group;
+
+/**
+  A client connection served by the pool. It is owned by the worker
+  running it, or by the queue or the epoll set of its group.
+*/
+struct Pool_connection {
+  Pool_connection(Channel_info *info, Thread_group *owner)
+      : channel_info(info), group(owner) {}
+
+  /// Connection data, until a worker creates the session.
+  Channel_info *channel_info;
+  Thread_group *group;
+  THD *thd{nullptr};
+  /// Instrumentation of the session, attached to the worker running it.
+  PSI_thread *psi{nullptr};
+  int fd{-1};
+  /// Whether thd_prepare_connection() succeeded.
+  bool logged_in{false};
+  /// Whether fd was added to the epoll set of the group.
+  bool in_epoll{false};
+  /// Whether the next command is queued with high priority.
+  bool high_priority{false};
+  /// Time the connection was queued.
+  ulonglong queue_time{0};
+
+  // Protected by the mutex of the group.
+  /// Whether the connection waits in the epoll set for its next command.
+  bool parked{false};
+  /// Time after which a parked connection is closed.
+  ulonglong idle_deadline{0};
+  /// Whether the timer shut the connection down for being idle too long.
+  bool timed_out{false};
+};
+
+struct Thread_group {
+  bool init();
+  void destroy();
+
+  /**
+    Stop the listener and wait until all workers exited. All connections
+    must have been closed.
+  */
+  void stop();
+
+  bool queue_empty() const {
+    return high_priority_queue.empty() && queue.empty();
+  }
+
+  /** Whether one more worker may run a queued command. */
+  bool can_run() const {
+    return stalled ||
+           active_thread_count <= Thread_pool_connection_handler::oversubscribe;
+  }
+
+  /** Queue a connection and get a worker for it. Mutex must be held. */
+  void enqueue(Pool_connection *connection);
+
+  /**
+    Block until a command may be run, or the worker should exit.
+
+    @param was_active  whether the worker ran a command before
+
+    @retval nullptr  the worker should exit
+    @retval !nullptr the connection to run a command of
+  */
+  Pool_connection *get_connection(bool was_active);
+
+  /**
+    Wait in the epoll set for the next command of the connection.
+
+    @retval false  parked
+    @retval true   epoll failed, the connection must be closed
+  */
+  bool park(Pool_connection *connection, ulong wait_timeout);
+
+  /** Forget a connection being closed. */
+  void remove(Pool_connection *connection);
+
+  /** Wake an idle worker or create one. Mutex must be held. */
+  void wake_or_create_worker();
+
+  /** Start the listener, unless running. Mutex must be held. */
+  bool start_listener();
+
+  /** Called by the timer, see Thread_pool_connection_handler. */
+  void check_stall(ulonglong now);
+
+  mysql_mutex_t mutex;
+  /// Idle workers wait here, and stop() for workers to exit.
+  mysql_cond_t cond;
+  int epoll_fd{-1};
+  /// Written to by stop() to end the listener.
+  int shutdown_pipe[2]{-1, -1};
+  bool listener_started{false};
+  my_thread_handle listener;
+
+  // Protected by mutex.
+  std::deque<Pool_connection *> high_priority_queue;
+  std::deque<Pool_connection *> queue;
+  std::unordered_set<Pool_connection *> connections;
+  uint thread_count{0};
+  /// Workers running a command, and not waiting in thd_wait_begin().
+  uint active_thread_count{0};
+  /// Workers waiting for a command to run.
+  uint idle_thread_count{0};
+  /// Whether the timer found no progress, one more worker may run.
+  bool stalled{false};
+  bool stopping{false};
+  /// Commands taken from the queues, and the count at the last check.
+  ulonglong dequeued{0};
+  ulonglong last_dequeued{0};
+
+  // Statistics, protected by mutex.
+  ulonglong queued_events{0};
+  /// Total time, in microseconds, commands were queued.
+  ulonglong queue_wait_time{0};
+  ulonglong waits{0};
+  ulonglong stalls{0};
+};
+
+}  // namespace
+
+static Thread_group *thread_groups = nullptr;
+static uint thread_group_count = 0;
+static std::atomic<uint> next_thread_group{0};
+/// Workers of all groups, limited by thread_pool_max_threads.
+static std::atomic<uint> pool_thread_count{0};
+
+static mysql_mutex_t LOCK_thread_pool_timer;
+static mysql_cond_t COND_thread_pool_timer;
+static bool timer_started = false;  // Protected by LOCK_thread_pool_timer
+static bool timer_stopping = false;  // Protected by LOCK_thread_pool_timer
+static my_thread_handle timer_handle;
+
+/// Group of the worker running a command in this thread.
+static thread_local Thread_group *current_group = nullptr;
+/// Whether the worker reported a wait that did not end yet.
+static thread_local bool current_worker_waiting = false;
+
+extern "C" {
+static void *worker_thread(void *arg);
+static void *listener_thread(void *arg);
+}
+
+bool Thread_group::init() {
+  mysql_mutex_init(key_LOCK_thread_group, &mutex, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_thread_group, &cond);
+#ifdef HAVE_EPOLL
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd < 0 || pipe(shutdown_pipe) != 0) return true;
+
+  struct epoll_event event {};
+  event.events = EPOLLIN;
+  event.data.ptr = nullptr;
+  return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, shutdown_pipe[0], &event) != 0;
+#else
+  return true;
+#endif
+}
+
+void Thread_group::destroy() {
+#ifdef HAVE_EPOLL
+  if (epoll_fd >= 0) close(epoll_fd);
+  if (shutdown_pipe[0] >= 0) close(shutdown_pipe[0]);
+  if (shutdown_pipe[1] >= 0) close(shutdown_pipe[1]);
+#endif
+  mysql_mutex_destroy(&mutex);
+  mysql_cond_destroy(&cond);
+}
+
+void Thread_group::stop() {
+  mysql_mutex_lock(&mutex);
+  assert(connections.empty());
+  stopping = true;
+  mysql_cond_broadcast(&cond);
+  mysql_mutex_unlock(&mutex);
+
+#ifdef HAVE_EPOLL
+  if (listener_started) {
+    const char stop = 0;
+    while (write(shutdown_pipe[1], &stop, 1) < 0 && errno == EINTR) {
+    }
+    my_thread_join(&listener, nullptr);
+  }
+#endif
+
+  mysql_mutex_lock(&mutex);
+  while (thread_count > 0) mysql_cond_wait(&cond, &mutex);
+  mysql_mutex_unlock(&mutex);
+}
+
+void Thread_group::enqueue(Pool_connection *connection) {
+  mysql_mutex_assert_owner(&mutex);
+  connection->queue_time = my_micro_time();
+  if (connection->high_priority)
+    high_priority_queue.push_back(connection);
+  else
+    queue.push_back(connection);
+  queued_events++;
+  wake_or_create_worker();
+}
+
+void Thread_group::wake_or_create_worker() {
+  mysql_mutex_assert_owner(&mutex);
+  if (!can_run()) return;
+
+  if (idle_thread_count > 0) {
+    mysql_cond_signal(&cond);
+    return;
+  }
+
+  if (pool_thread_count >= Thread_pool_connection_handler::max_threads) return;
+
+  my_thread_handle id;
+  int error = mysql_thread_create(key_thread_pool_worker, &id,
+                                  &connection_attrib, worker_thread, this);
+  if (error) {
+    connection_errors_internal++;
+    if (!create_worker_err_log_throttle.log())
+      LogErr(ERROR_LEVEL, ER_CONN_PER_THREAD_NO_THREAD, error);
+    return;
+  }
+  thread_count++;
+  pool_thread_count++;
+  Global_THD_manager::get_instance()->inc_thread_created();
+}
+
+Pool_connection *Thread_group::get_connection(bool was_active) {
+  Pool_connection *connection = nullptr;
+
+  mysql_mutex_lock(&mutex);
+  if (was_active) active_thread_count--;
+  while (!stopping) {
+    if (!queue_empty() && can_run()) {
+      std::deque<Pool_connection *> &from =
+          high_priority_queue.empty() ? queue : high_priority_queue;
+      connection = from.front();
+      from.pop_front();
+      queue_wait_time += my_micro_time() - connection->queue_time;
+      dequeued++;
+      stalled = false;
+      active_thread_count++;
+      break;
+    }
+
+    struct timespec abstime;
+    set_timespec(&abstime, Thread_pool_connection_handler::idle_timeout);
+    idle_thread_count++;
+    int error = mysql_cond_timedwait(&cond, &mutex, &abstime);
+    idle_thread_count--;
+    // Keep a worker, so that the group does not depend on creating one.
+    if (is_timeout(error) && queue_empty() && thread_count > 1) break;
+  }
+
+  if (connection == nullptr) {
+    thread_count--;
+    pool_thread_count--;
+    if (stopping) mysql_cond_broadcast(&cond);
+  }
+  mysql_mutex_unlock(&mutex);
+  return connection;
+}
+
+bool Thread_group::park(Pool_connection *connection,
+                        ulong wait_timeout [[maybe_unused]]) {
+#ifdef HAVE_EPOLL
+  mysql_mutex_lock(&mutex);
+  connection->parked = true;
+  connection->idle_deadline = my_micro_time() + wait_timeout * 1000000ULL;
+  mysql_mutex_unlock(&mutex);
+
+  struct epoll_event event {};
+  event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+  event.data.ptr = connection;
+  /*
+    Once armed, the connection may be run by another worker before
+    epoll_ctl() returns, so in_epoll is set before.
+  */
+  const int op = connection->in_epoll ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+  connection->in_epoll = true;
+  if (epoll_ctl(epoll_fd, op, connection->fd, &event) == 0) return false;
+
+  connection->in_epoll = (op == EPOLL_CTL_MOD);
+  mysql_mutex_lock(&mutex);
+  connection->parked = false;
+  mysql_mutex_unlock(&mutex);
+#endif
+  return true;
+}
+
+void Thread_group::remove(Pool_connection *connection) {
+#ifdef HAVE_EPOLL
+  if (connection->in_epoll) {
+    struct epoll_event event {};
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, connection->fd, &event);
+    connection->in_epoll = false;
+  }
+#endif
+  mysql_mutex_lock(&mutex);
+  connections.erase(connection);
+  mysql_mutex_unlock(&mutex);
+}
+
+bool Thread_group::start_listener() {
+  mysql_mutex_assert_owner(&mutex);
+  if (listener_started) return false;
+
+  int error = mysql_thread_create(key_thread_pool_listener, &listener, nullptr,
+                                  listener_thread, this);
+  if (error) {
+    connection_errors_internal++;
+    if (!create_worker_err_log_throttle.log())
+      LogErr(ERROR_LEVEL, ER_CONN_PER_THREAD_NO_THREAD, error);
+    return true;
+  }
+  listener_started = true;
+  return false;
+}
+
+void Thread_group::check_stall(ulonglong now) {
+  mysql_mutex_lock(&mutex);
+  if (!queue_empty() && dequeued == last_dequeued) {
+    stalled = true;
+    stalls++;
+    wake_or_create_worker();
+  }
+  last_dequeued = dequeued;
+
+  /*
+    The command read blocks for at most wait_timeout in the per-thread
+    handler. Parked connections have no reader, so the timer shuts their
+    reading side down, and the worker woken up closes them.
+  */
+  for (Pool_connection *connection : connections) {
+    if (connection->parked && !connection->timed_out &&
+        connection->idle_deadline <= now) {
+      connection->timed_out = true;
+#ifdef HAVE_EPOLL
+      shutdown(connection->fd, SHUT_RD);
+#endif
+    }
+  }
+  mysql_mutex_unlock(&mutex);
+}
+
+/**
+  Attach the session of a connection to the current worker.
+
+  @param connection   connection to run a command of
+  @param stack_start  start of the stack of the worker
+*/
+static void attach_session(Pool_connection *connection,
+                           const char *stack_start) {
+  THD *thd = connection->thd;
+  thd_set_thread_stack(thd, stack_start);
+  thd->store_globals();
+#ifdef HAVE_PSI_THREAD_INTERFACE
+  PSI_THREAD_CALL(set_thread)(connection->psi);
+  PSI_THREAD_CALL(set_thread_os_id)(connection->psi);
+#endif
+  mysql_socket_set_thread_owner(
+      thd->get_protocol_classic()->get_vio()->mysql_socket);
+}
+
+/**
+  Detach the session of a connection from the current worker.
+
+  @param connection  connection a command was run of
+  @param worker_psi  instrumentation of the worker itself
+*/
+static void detach_session(Pool_connection *connection,
+                           PSI_thread *worker_psi [[maybe_unused]]) {
+  connection->thd->restore_globals();
+#ifdef HAVE_PSI_THREAD_INTERFACE
+  PSI_THREAD_CALL(set_thread)(worker_psi);
+#endif
+}
+
+/**
+  Create the session of a new connection and authenticate the user.
+
+  @retval false  session created and attached, logged_in tells if the
+                 user was authenticated
+  @retval true   out of resources, the connection was closed
+*/
+static bool start_session(Pool_connection *connection,
+                          const char *stack_start) {
+  Channel_info *channel_info = connection->channel_info;
+  THD *thd = channel_info->create_thd();
+  if (thd == nullptr) {
+    channel_info->send_error_and_close_channel(ER_OUT_OF_RESOURCES, 0, false);
+    return true;
+  }
+  delete channel_info;
+  connection->channel_info = nullptr;
+
+  thd->set_new_thread_id();
+  connection->thd = thd;
+  connection->fd = mysql_socket_getfd(
+      thd->get_protocol_classic()->get_vio()->mysql_socket);
+#ifdef HAVE_PSI_THREAD_INTERFACE
+  connection->psi = PSI_THREAD_CALL(new_thread)(
+      key_thread_one_connection, 0 /* no sequence number */, thd,
+      thd->thread_id());
+  thd->set_psi(connection->psi);
+#endif
+  attach_session(connection, stack_start);
+  Global_THD_manager::get_instance()->add_thd(thd);
+
+  if (thd_prepare_connection(thd))
+    Connection_handler_manager::get_instance()->inc_aborted_connects();
+  else
+    connection->logged_in = true;
+  return false;
+}
+
+/**
+  Close the attached session of a connection.
+
+  @param connection  connection to close, deleted by this function
+  @param worker_psi  instrumentation of the worker itself
+*/
+static void end_session(Pool_connection *connection,
+                        PSI_thread *worker_psi [[maybe_unused]]) {
+  THD *thd = connection->thd;
+  connection->group->remove(connection);
+
+  if (connection->logged_in) end_connection(thd);
+  close_connection(thd, 0, false, false);
+
+  thd->get_stmt_da()->reset_diagnostics_area();
+  thd->release_resources();
+  Global_THD_manager::get_instance()->remove_thd(thd);
+  Connection_handler_manager::dec_connection_count();
+
+#ifdef HAVE_PSI_THREAD_INTERFACE
+  /* Decouple THD and the thread instrumentation. */
+  thd->set_psi(nullptr);
+  mysql_thread_set_psi_THD(nullptr);
+#endif /* HAVE_PSI_THREAD_INTERFACE */
+
+  thd->restore_globals();
+  delete thd;
+
+#ifdef HAVE_PSI_THREAD_INTERFACE
+  /* Delete the instrumentation of the session. */
+  PSI_THREAD_CALL(delete_current_thread)();
+  PSI_THREAD_CALL(set_thread)(worker_psi);
+#endif /* HAVE_PSI_THREAD_INTERFACE */
+
+  delete connection;
+}
+
+/**
+  Run the next command of a connection, then park it until the client
+  sends another one.
+*/
+static void handle_event(Pool_connection *connection, const char *stack_start,
+                         PSI_thread *worker_psi) {
+  Thread_group *group = connection->group;
+  bool close;
+
+  if (connection->thd == nullptr) {
+    if (start_session(connection, stack_start)) {
+      connection_errors_internal++;
+      Connection_handler_manager::get_instance()->inc_aborted_connects();
+      Connection_handler_manager::dec_connection_count();
+      group->remove(connection);
+      delete connection->channel_info;
+      delete connection;
+      return;
+    }
+    close = !connection->logged_in;
+  } else {
+    attach_session(connection, stack_start);
+    close = do_command(connection->thd);
+  }
+
+  THD *thd = connection->thd;
+  if (close || !thd_connection_alive(thd)) {
+    end_session(connection, worker_psi);
+    return;
+  }
+
+  connection->high_priority =
+      thd->in_active_multi_stmt_transaction() || thd->locked_tables_mode;
+  Vio *vio = thd->get_protocol_classic()->get_vio();
+  const bool has_data = vio->has_data(vio);
+  const ulong wait_timeout = thd->variables.net_wait_timeout;
+  detach_session(connection, worker_psi);
+
+  if (has_data) {
+    // The next command is already buffered, e.g. by SSL.
+    mysql_mutex_lock(&group->mutex);
+    group->enqueue(connection);
+    mysql_mutex_unlock(&group->mutex);
+  } else if (group->park(connection, wait_timeout)) {
+    attach_session(connection, stack_start);
+    end_session(connection, worker_psi);
+  }
+}
+
+extern "C" {
+static void *worker_thread(void *arg) {
+  Thread_group *group = static_cast<Thread_group *>(arg);
+  Pool_connection *connection = nullptr;
+
+  if (my_thread_init()) {
+    connection_errors_internal++;
+    mysql_mutex_lock(&group->mutex);
+    group->thread_count--;
+    pool_thread_count--;
+    if (group->stopping) mysql_cond_broadcast(&group->cond);
+    mysql_mutex_unlock(&group->mutex);
+    my_thread_exit(nullptr);
+    return nullptr;
+  }
+
+#ifdef HAVE_PSI_THREAD_INTERFACE
+  PSI_thread *worker_psi = PSI_THREAD_CALL(get_thread)();
+#else
+  PSI_thread *worker_psi = nullptr;
+#endif
+
+  /*
+    Sessions check for stack overruns from the start of the stack of the
+    worker running them, which is the address of connection.
+  */
+  bool was_active = false;
+  while ((connection = group->get_connection(was_active)) != nullptr) {
+    current_group = group;
+    handle_event(connection, (char *)&connection, worker_psi);
+    current_group = nullptr;
+    was_active = true;
+  }
+
+  my_thread_end();
+  my_thread_exit(nullptr);
+  return nullptr;
+}
+
+static void *listener_thread(void *arg [[maybe_unused]]) {
+#ifdef HAVE_EPOLL
+  Thread_group *group = static_cast<Thread_group *>(arg);
+  static const int MAX_EVENTS = 64;
+  struct epoll_event events[MAX_EVENTS];
+  bool stop = false;
+
+  if (my_thread_init()) return nullptr;
+
+  while (!stop) {
+    int count = epoll_wait(group->epoll_fd, events, MAX_EVENTS, -1);
+    if (count < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+
+    mysql_mutex_lock(&group->mutex);
+    for (int i = 0; i < count; i++) {
+      Pool_connection *connection =
+          static_cast<Pool_connection *>(events[i].data.ptr);
+      if (connection == nullptr) {
+        stop = true;
+        continue;
+      }
+      if (!connection->parked) continue;
+      connection->parked = false;
+      group->enqueue(connection);
+    }
+    mysql_mutex_unlock(&group->mutex);
+  }
+
+  my_thread_end();
+#endif
+  return nullptr;
+}
+
+static void *timer_thread(void *) {
+  if (my_thread_init()) return nullptr;
+
+  mysql_mutex_lock(&LOCK_thread_pool_timer);
+  while (!timer_stopping) {
+    struct timespec abstime;
+    set_timespec_nsec(&abstime,
+                      Thread_pool_connection_handler::stall_limit * 1000000ULL);
+    mysql_cond_timedwait(&COND_thread_pool_timer, &LOCK_thread_pool_timer,
+                         &abstime);
+    if (timer_stopping) break;
+    mysql_mutex_unlock(&LOCK_thread_pool_timer);
+
+    const ulonglong now = my_micro_time();
+    for (uint i = 0; i < thread_group_count; i++)
+      thread_groups[i].check_stall(now);
+
+    mysql_mutex_lock(&LOCK_thread_pool_timer);
+  }
+  mysql_mutex_unlock(&LOCK_thread_pool_timer);
+
+  my_thread_end();
+  return nullptr;
+}
+}  // extern "C"
+
+static void thread_pool_wait_begin(THD *, int) {
+  Thread_group *group = current_group;
+  if (group == nullptr || current_worker_waiting) return;
+  current_worker_waiting = true;
+
+  mysql_mutex_lock(&group->mutex);
+  group->active_thread_count--;
+  group->waits++;
+  if (!group->queue_empty()) group->wake_or_create_worker();
+  mysql_mutex_unlock(&group->mutex);
+}
+
+static void thread_pool_wait_end(THD *) {
+  Thread_group *group = current_group;
+  if (group == nullptr || !current_worker_waiting) return;
+  current_worker_waiting = false;
+
+  mysql_mutex_lock(&group->mutex);
+  group->active_thread_count++;
+  mysql_mutex_unlock(&group->mutex);
+}
+
+/*
+  THD::awake() shuts down the socket of a killed connection, which wakes
+  it up if it is parked, so there is nothing to do after a kill.
+*/
+THD_event_functions Thread_pool_connection_handler::event_functions = {
+    thread_pool_wait_begin, thread_pool_wait_end, nullptr};
+
+bool Thread_pool_connection_handler::init() {
+#ifdef HAVE_EPOLL
+#ifdef HAVE_PSI_INTERFACE
+  int count = static_cast<int>(array_elements(all_thread_pool_mutexes));
+  mysql_mutex_register("sql", all_thread_pool_mutexes, count);
+
+  count = static_cast<int>(array_elements(all_thread_pool_conds));
+  mysql_cond_register("sql", all_thread_pool_conds, count);
+
+  count = static_cast<int>(array_elements(all_thread_pool_threads));
+  mysql_thread_register("sql", all_thread_pool_threads, count);
+#endif
+
+  if (size == 0) size = std::max(resourcegroups::platform::num_vcpus(), 1U);
+
+  thread_groups = new (std::nothrow) Thread_group[size];
+  if (thread_groups == nullptr) return true;
+
+  mysql_mutex_init(key_LOCK_thread_pool_timer, &LOCK_thread_pool_timer,
+                   MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_thread_pool_timer, &COND_thread_pool_timer);
+
+  for (uint i = 0; i < size; i++) {
+    thread_group_count = i + 1;
+    if (thread_groups[i].init()) return true;
+  }
+  return false;
+#else
+  LogErr(ERROR_LEVEL, ER_WRONG_VALUE_FOR_VAR, "thread_handling",
+         "pool-of-threads");
+  return true;
+#endif
+}
+
+Thread_pool_connection_handler::~Thread_pool_connection_handler() {
+  if (thread_groups == nullptr) return;
+
+  mysql_mutex_lock(&LOCK_thread_pool_timer);
+  timer_stopping = true;
+  mysql_cond_signal(&COND_thread_pool_timer);
+  mysql_mutex_unlock(&LOCK_thread_pool_timer);
+  if (timer_started) my_thread_join(&timer_handle, nullptr);
+
+  for (uint i = 0; i < thread_group_count; i++) {
+    thread_groups[i].stop();
+    thread_groups[i].destroy();
+  }
+  delete[] thread_groups;
+  thread_groups = nullptr;
+  thread_group_count = 0;
+
+  mysql_mutex_destroy(&LOCK_thread_pool_timer);
+  mysql_cond_destroy(&COND_thread_pool_timer);
+}
+
+bool Thread_pool_connection_handler::add_connection(
+    Channel_info *channel_info) {
+  DBUG_TRACE;
+  int error = 0;
+
+  mysql_mutex_lock(&LOCK_thread_pool_timer);
+  if (!timer_started) {
+    error = mysql_thread_create(key_thread_pool_timer, &timer_handle, nullptr,
+                                timer_thread, nullptr);
+    timer_started = (error == 0);
+  }
+  mysql_mutex_unlock(&LOCK_thread_pool_timer);
+
+  if (error) {
+    connection_errors_internal++;
+    if (!create_worker_err_log_throttle.log())
+      LogErr(ERROR_LEVEL, ER_CONN_PER_THREAD_NO_THREAD, error);
+    channel_info->send_error_and_close_channel(ER_CANT_CREATE_THREAD, error,
+                                               true);
+    Connection_handler_manager::dec_connection_count();
+    return true;
+  }
+
+  Thread_group *group =
+      &thread_groups[next_thread_group++ % thread_group_count];
+  Pool_connection *connection =
+      new (std::nothrow) Pool_connection(channel_info, group);
+  if (connection == nullptr) {
+    connection_errors_internal++;
+    channel_info->send_error_and_close_channel(ER_OUT_OF_RESOURCES, 0, false);
+    Connection_handler_manager::dec_connection_count();
+    return true;
+  }
+
+  mysql_mutex_lock(&group->mutex);
+  if (group->start_listener()) {
+    mysql_mutex_unlock(&group->mutex);
+    delete connection;
+    channel_info->send_error_and_close_channel(ER_CANT_CREATE_THREAD, 0, true);
+    Connection_handler_manager::dec_connection_count();
+    return true;
+  }
+  group->connections.insert(connection);
+  group->enqueue(connection);
+  mysql_mutex_unlock(&group->mutex);
+  return false;
+}
+
+/**
+  Sum a statistic over the thread groups.
+
+  @param stat  returns the statistic of a group, whose mutex is held
+*/
+static int show_thread_group_stat(SHOW_VAR *var, char *buff,
+                                  ulonglong (*stat)(const Thread_group &)) {
+  var->type = SHOW_LONGLONG;
+  var->value = buff;
+  ulonglong sum = 0;
+  for (uint i = 0; i < thread_group_count; i++) {
+    mysql_mutex_lock(&thread_groups[i].mutex);
+    sum += stat(thread_groups[i]);
+    mysql_mutex_unlock(&thread_groups[i].mutex);
+  }
+  *reinterpret_cast<ulonglong *>(buff) = sum;
+  return 0;
+}
+
+static int show_active_threads(THD *, SHOW_VAR *var, char *buff) {
+  return show_thread_group_stat(var, buff, [](const Thread_group &group) {
+    return static_cast<ulonglong>(group.active_thread_count);
+  });
+}
+
+static int show_idle_threads(THD *, SHOW_VAR *var, char *buff) {
+  return show_thread_group_stat(var, buff, [](const Thread_group &group) {
+    return static_cast<ulonglong>(group.idle_thread_count);
+  });
+}
+
+static int show_queue_length(THD *, SHOW_VAR *var, char *buff) {
+  return show_thread_group_stat(var, buff, [](const Thread_group &group) {
+    return static_cast<ulonglong>(group.high_priority_queue.size() +
+                                  group.queue.size());
+  });
+}
+
+static int show_queue_wait_time(THD *, SHOW_VAR *var, char *buff) {
+  return show_thread_group_stat(var, buff, [](const Thread_group &group) {
+    return group.queue_wait_time;
+  });
+}
+
+static int show_queued_events(THD *, SHOW_VAR *var, char *buff) {
+  return show_thread_group_stat(var, buff, [](const Thread_group &group) {
+    return group.queued_events;
+  });
+}
+
+static int show_stalls(THD *, SHOW_VAR *var, char *buff) {
+  return show_thread_group_stat(
+      var, buff, [](const Thread_group &group) { return group.stalls; });
+}
+
+static int show_threads(THD *, SHOW_VAR *var, char *buff) {
+  return show_thread_group_stat(var, buff, [](const Thread_group &group) {
+    return static_cast<ulonglong>(group.thread_count);
+  });
+}
+
+static int show_waits(THD *, SHOW_VAR *var, char *buff) {
+  return show_thread_group_stat(
+      var, buff, [](const Thread_group &group) { return group.waits; });
+}
+
+SHOW_VAR Thread_pool_connection_handler::status_vars[] = {
+    {"active_threads", (char *)&show_active_threads, SHOW_FUNC,
+     SHOW_SCOPE_GLOBAL},
+    {"idle_threads", (char *)&show_idle_threads, SHOW_FUNC, SHOW_SCOPE_GLOBAL},
+    {"queue_length", (char *)&show_queue_length, SHOW_FUNC, SHOW_SCOPE_GLOBAL},
+    {"queue_wait_time", (char *)&show_queue_wait_time, SHOW_FUNC,
+     SHOW_SCOPE_GLOBAL},
+    {"queued_events", (char *)&show_queued_events, SHOW_FUNC,
+     SHOW_SCOPE_GLOBAL},
+    {"stalls", (char *)&show_stalls, SHOW_FUNC, SHOW_SCOPE_GLOBAL},
+    {"threads", (char *)&show_threads, SHOW_FUNC, SHOW_SCOPE_GLOBAL},
+    {"waits", (char *)&show_waits, SHOW_FUNC, SHOW_SCOPE_GLOBAL},
+    {NullS, NullS, SHOW_LONG, SHOW_SCOPE_GLOBAL}};
@@ -100,6 +100,7 @@
 #include "sql/psi_memory_key.h"
 #include "sql/query_options.h"
 #include "sql/record_buffer.h"  // Record_buffer
+#include "sql/result_cache.h"   // result_cache
 #include "sql/rpl_filter.h"
 #include "sql/rpl_gtid.h"
 #include "sql/rpl_handler.h"                       // RUN_HOOK
@@ -1811,6 +1812,7 @@ end:
   if (is_real_trans) {
     trn_ctx->cleanup();
     thd->tx_priority = 0;
+    result_cache.end_transaction(thd, error == 0);
   }
 
   if (need_clear_owned_gtid) {
@@ -2094,6 +2096,7 @@ int ha_rollback_trans(THD *thd, bool all) {
   if (is_real_trans) {
     trn_ctx->cleanup();
     thd->tx_priority = 0;
+    result_cache.end_transaction(thd, false);
   }
 
   if (all) thd->transaction_rollback_request = false;
@@ -7958,6 +7961,18 @@ int handler::ha_external_lock(THD *thd, int lock_type) {
       The lock type is needed by MRR when creating a clone of this handler
       object.
     */
+    if (table_share->tmp_table == NO_TMP_TABLE) {
+      /*
+        Tell the query result cache about writes: the transaction will
+        change the table when it commits, and the statement may already
+        have changed it if it was autocommitted.
+      */
+      if (lock_type == F_WRLCK)
+        result_cache.note_write_lock(thd, table_share);
+      else if (lock_type == F_UNLCK && m_lock_type == F_WRLCK)
+        result_cache.invalidate_table(table_share->db.str,
+                                      table_share->table_name.str);
+    }
     m_lock_type = lock_type;
     cached_table_flags = table_flags();
   }
@@ -4350,8 +4350,20 @@ class Cmp_longlong {
   }
 };
 
+/**
+  Hash an integer in IN value list format. Values which are equal according
+  to cmp_longlong() have the same bit pattern, so the signedness is ignored.
+*/
+static inline size_t hash_longlong(const in_longlong::packed_longlong &a) {
+  // Fibonacci hashing: spread the bits of the value over the upper bits
+  const ulonglong h = static_cast<ulonglong>(a.val) * 0x9E3779B97F4A7C15ULL;
+  return static_cast<size_t>(h ^ (h >> 32));
+}
+
 void in_longlong::sort_array() {
   std::sort(base.begin(), base.begin() + m_used_size, Cmp_longlong());
+  m_hash_index.build(m_used_size,
+                     [this](uint pos) { return hash_longlong(base[pos]); });
 }
 
 bool in_longlong::find_item(Item *item) {
@@ -4359,6 +4371,11 @@ bool in_longlong::find_item(Item *item) {
   packed_longlong result;
   val_item(item, &result);
   if (item->null_value) return false;
+  if (m_hash_index.is_built()) {
+    return m_hash_index.find(hash_longlong(result), [&](uint pos) {
+      return cmp_longlong(&base[pos], &result) == 0;
+    });
+  }
   return std::binary_search(base.begin(), base.begin() + m_used_size, result,
                             Cmp_longlong());
 }
@@ -4367,6 +4384,16 @@ bool in_longlong::compare_elems(uint pos1, uint pos2) const {
   return cmp_longlong(&base[pos1], &base[pos2]) != 0;
 }
 
+bool in_longlong::is_successor(uint pos) const {
+  const packed_longlong &prev = base[pos - 1];
+  const packed_longlong &cur = base[pos];
+  if (prev.unsigned_flag != cur.unsigned_flag) return false;
+  if (cur.unsigned_flag)
+    return static_cast<ulonglong>(prev.val) + 1 ==
+           static_cast<ulonglong>(cur.val);
+  return prev.val != LLONG_MAX && prev.val + 1 == cur.val;
+}
+
 class Cmp_row {
  public:
   bool operator()(const cmp_item_row *a, const cmp_item_row *b) {
@@ -4397,7 +4424,8 @@ in_string::in_string(MEM_ROOT *mem_root, uint elements, const CHARSET_INFO *cs)
       tmp(buff, sizeof(buff), &my_charset_bin),
       base_objects(mem_root, elements),
       base_pointers(mem_root, elements),
-      collation(cs) {
+      collation(cs),
+      m_hash_index(mem_root) {
   for (uint ix = 0; ix < elements; ++ix) {
     base_pointers[ix] = &base_objects[ix];
   }
@@ -4442,16 +4470,38 @@ class Cmp_string {
 };
 }  // namespace
 
+static size_t hash_string_in(const CHARSET_INFO *cs, const String *x) {
+  uint64 nr1 = 1, nr2 = 4;
+  cs->coll->hash_sort(cs, pointer_cast<const uchar *>(x->ptr()), x->length(),
+                      &nr1, &nr2);
+  return static_cast<size_t>(nr1);
+}
+
 // Sort string pointers, not string objects.
 void in_string::sort_array() {
   std::sort(base_pointers.begin(), base_pointers.begin() + m_used_size,
             Cmp_string(collation));
+  /*
+    Binary collations hash the bytes directly, which is much cheaper than the
+    comparisons it saves. For other collations, computing the weights for
+    hashing costs about as much as the binary search.
+  */
+  if (my_binary_compare(collation)) {
+    m_hash_index.build(m_used_size, [this](uint pos) {
+      return hash_string_in(collation, base_pointers[pos]);
+    });
+  }
 }
 
 bool in_string::find_item(Item *item) {
   if (m_used_size == 0) return false;
   const String *str = eval_string_arg(collation, item, &tmp);
   if (str == nullptr) return false;
+  if (m_hash_index.is_built()) {
+    return m_hash_index.find(hash_string_in(collation, str), [&](uint pos) {
+      return srtcmp_in(collation, base_pointers[pos], str) == 0;
+    });
+  }
   return std::binary_search(base_pointers.begin(),
                             base_pointers.begin() + m_used_size, str,
                             Cmp_string(collation));
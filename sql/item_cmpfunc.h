@@ -1588,7 +1588,8 @@ class in_vector {
 
   /**
     Calls item->val_int() or item->val_str() etc.
-    and then does binary_search if the value is non-null.
+    and then does binary_search, or a hash lookup for long lists,
+    if the value is non-null.
     @param  item to evaluate, and lookup in the IN-list.
     @return true if evaluated value of the item was found.
    */
@@ -1618,6 +1619,13 @@ class in_vector {
   /** Compare values number pos1 and pos2 for equality */
   virtual bool compare_elems(uint pos1, uint pos2) const = 0;
 
+  /**
+    Check whether value number pos is the integer that follows value number
+    pos - 1 in the sorted vector, so that both can be looked up with a
+    single closed range on an integer column.
+  */
+  virtual bool is_successor(uint pos [[maybe_unused]]) const { return false; }
+
   virtual bool is_row_result() const { return false; }
 
   /**
@@ -1641,6 +1649,71 @@ class in_vector {
   virtual void sort_array() = 0;
 };
 
+/**
+  Open addressing hash index over the sorted elements of an in_vector, used
+  to look up values in long IN lists in constant time instead of by binary
+  search. Each slot holds the position of an element plus one, or zero if
+  the slot is empty. The number of slots is a power of two, at least twice
+  the number of elements, so probe sequences stay short.
+*/
+class in_hash_index {
+ public:
+  /// Minimum number of elements for which the index is built.
+  static constexpr uint MIN_ELEMENTS = 32;
+
+  explicit in_hash_index(MEM_ROOT *mem_root) : m_slots(mem_root) {}
+
+  /**
+    Build the index, or leave it empty if there are too few elements or if
+    memory could not be allocated.
+
+    @param count  Number of elements
+    @param hash   Functor returning the hash value of the element at a
+                  given position
+  */
+  template <class Hash>
+  void build(uint count, Hash hash) {
+    m_slots.clear();
+    if (count < MIN_ELEMENTS) return;
+    size_t num_slots = 1;
+    while (num_slots < 2 * size_t{count}) num_slots <<= 1;
+    m_slots.resize(num_slots, 0);
+    if (m_slots.size() != num_slots) {  // OOM, fall back to binary search
+      m_slots.clear();
+      return;
+    }
+    for (uint pos = 0; pos < count; pos++) {
+      size_t slot = hash(pos) & (num_slots - 1);
+      while (m_slots[slot] != 0) slot = (slot + 1) & (num_slots - 1);
+      m_slots[slot] = pos + 1;
+    }
+  }
+
+  /// @returns true if the index has been built.
+  bool is_built() const { return !m_slots.empty(); }
+
+  /**
+    Look up a value in the index.
+
+    @param hash_value  Hash value of the value to look up
+    @param matches     Functor returning true if the element at a given
+                       position is equal to the value
+    @returns true if the value was found
+  */
+  template <class Matches>
+  bool find(size_t hash_value, Matches matches) const {
+    const size_t mask = m_slots.size() - 1;
+    for (size_t slot = hash_value & mask; m_slots[slot] != 0;
+         slot = (slot + 1) & mask) {
+      if (matches(m_slots[slot] - 1)) return true;
+    }
+    return false;
+  }
+
+ private:
+  Mem_root_array<uint> m_slots;
+};
+
 class in_string final : public in_vector {
   char buff[STRING_BUFFER_USUAL_SIZE];
   String tmp;
@@ -1648,6 +1721,8 @@ class in_string final : public in_vector {
   // String objects are not sortable, sort pointers instead.
   Mem_root_array<String *> base_pointers;
   const CHARSET_INFO *collation;
+  /// Only built for binary collations, see sort_array().
+  in_hash_index m_hash_index;
 
  public:
   in_string(MEM_ROOT *mem_root, uint elements, const CHARSET_INFO *cs);
@@ -1675,10 +1750,11 @@ class in_longlong : public in_vector {
 
  protected:
   Mem_root_array<packed_longlong> base;
+  in_hash_index m_hash_index;
 
  public:
   in_longlong(MEM_ROOT *mem_root, uint elements)
-      : in_vector(elements), base(mem_root, elements) {}
+      : in_vector(elements), base(mem_root, elements), m_hash_index(mem_root) {}
   Item_basic_constant *create_item(MEM_ROOT *mem_root) const override {
     /*
       We've created a signed INT, this may not be correct in the
@@ -1692,6 +1768,7 @@ class in_longlong : public in_vector {
   }
   bool find_item(Item *item) override;
   bool compare_elems(uint pos1, uint pos2) const override;
+  bool is_successor(uint pos) const override;
 
  private:
   void set(uint pos, Item *item) override { val_item(item, &base[pos]); }
@@ -1706,6 +1783,8 @@ class in_datetime_as_longlong final : public in_longlong {
   Item_basic_constant *create_item(MEM_ROOT *mem_root) const override {
     return new (mem_root) Item_temporal(MYSQL_TYPE_DATETIME, 0LL);
   }
+  // Packed temporal values do not follow each other as integers
+  bool is_successor(uint) const override { return false; }
 
  private:
   void val_item(Item *item, packed_longlong *result) override;
@@ -1718,6 +1797,8 @@ class in_time_as_longlong final : public in_longlong {
   Item_basic_constant *create_item(MEM_ROOT *mem_root) const override {
     return new (mem_root) Item_temporal(MYSQL_TYPE_TIME, 0LL);
   }
+  // Packed temporal values do not follow each other as integers
+  bool is_successor(uint) const override { return false; }
 
  private:
   void val_item(Item *item, packed_longlong *result) override;
@@ -1737,6 +1818,8 @@ class in_datetime final : public in_longlong {
   Item_basic_constant *create_item(MEM_ROOT *mem_root) const override {
     return new (mem_root) Item_temporal(MYSQL_TYPE_DATETIME, 0LL);
   }
+  // Packed temporal values do not follow each other as integers
+  bool is_successor(uint) const override { return false; }
 
  private:
   void set(uint pos, Item *item) override;
@@ -2767,6 +2767,13 @@ void Item_sum_hybrid::clear() {
   null_value = true;
   m_cnt = 0;
   m_saved_last_value_at = 0;
+  clear_sliding();
+}
+
+void Item_sum_hybrid::clear_sliding() {
+  for (const Frame_extremum &e : m_frame_extrema)
+    m_free_extrema.push_back(e.m_value);
+  m_frame_extrema.clear();
 }
 
 void Item_sum_hybrid::update_after_wf_arguments_changed(THD *) {
@@ -2802,7 +2809,30 @@ bool Item_sum_hybrid::check_wf_semantics1(THD *thd, Query_block *select,
     }
   }
   if (!m_optimize) {
-    r->row_optimizable = false;
+    /*
+      Without a usable ordering, a moving ROWS frame can still be evaluated
+      incrementally: rows leave the frame in the order they entered it, so a
+      monotonic queue of candidates (see #m_frame_extrema) yields the MIN/MAX
+      of each frame with amortized O(1) work per row. If the frame's start
+      never moves, the running MIN/MAX computed by add() is enough.
+    */
+    const PT_frame *f = m_window->frame();
+    if (f->m_query_expression == WFU_ROWS && r->row_optimizable) {
+      if (f->m_from->m_border_type != WBT_UNBOUNDED_PRECEDING) {
+        m_sliding = true;
+        m_frame_candidate = Item_cache::get_cache(args[0]);
+        if (m_frame_candidate == nullptr) return true;
+        m_frame_candidate->setup(args[0]);
+        m_frame_cmp = new (thd->mem_root) Arg_comparator();
+        if (m_frame_cmp == nullptr ||
+            m_frame_cmp->set_cmp_func(
+                this, pointer_cast<Item **>(&m_frame_candidate),
+                pointer_cast<Item **>(&arg_cache), false))
+          return true;
+      }
+    } else {
+      r->row_optimizable = false;
+    }
     r->range_optimizable = false;
   }
   return result;
@@ -3058,6 +3088,10 @@ void Item_sum_hybrid::cleanup() {
   DBUG_TRACE;
   Item_sum::cleanup();
   if (cmp != nullptr) cmp->cleanup();
+  if (m_frame_cmp != nullptr) m_frame_cmp->cleanup();
+  // The queued caches were allocated during execution
+  m_frame_extrema.clear();
+  m_free_extrema.clear();
   /*
     by default it is true to avoid true reporting by
     Item_func_not_all/Item_func_nop_all if this item was never called.
@@ -3104,6 +3138,8 @@ static bool min_max_best_so_far(int comparison_result, bool is_min) {
 }
 
 bool Item_sum_hybrid::add() {
+  if (m_sliding) return add_sliding();
+
   arg_cache->cache_value();
   if (current_thd->is_error()) {
     return true;
@@ -3120,6 +3156,56 @@ bool Item_sum_hybrid::add() {
   return false;
 }
 
+bool Item_sum_hybrid::add_sliding() {
+  if (m_window->do_inverse()) {
+    /*
+      The row leaving the frame is the oldest row in it. Its candidate, if it
+      is still queued, is at the front; otherwise it was NULL or dominated by
+      a later row.
+    */
+    if (!m_frame_extrema.empty() &&
+        m_frame_extrema.front().m_rowno == m_window->rowno_being_visited()) {
+      m_free_extrema.push_back(m_frame_extrema.front().m_value);
+      m_frame_extrema.pop_front();
+    }
+  } else {
+    arg_cache->cache_value();
+    if (current_thd->is_error()) return true;
+
+    if (!arg_cache->null_value) {
+      // Drop candidates which can no longer be the frame's MIN/MAX
+      while (!m_frame_extrema.empty()) {
+        m_frame_candidate = m_frame_extrema.back().m_value;
+        if (min_max_best_so_far(m_frame_cmp->compare(), m_is_min)) break;
+        m_free_extrema.push_back(m_frame_candidate);
+        m_frame_extrema.pop_back();
+      }
+
+      Item_cache *cache;
+      if (m_free_extrema.empty()) {
+        cache = Item_cache::get_cache(args[0]);
+        if (cache == nullptr) return true;
+        cache->setup(args[0]);
+      } else {
+        cache = m_free_extrema.back();
+        m_free_extrema.pop_back();
+      }
+      cache->store_and_cache(arg_cache);
+      if (current_thd->is_error()) return true;
+      m_frame_extrema.push_back({m_window->rowno_being_visited(), cache});
+    }
+  }
+
+  if (m_frame_extrema.empty()) {
+    null_value = true;
+  } else {
+    value->store_and_cache(m_frame_extrema.front().m_value);
+    if (current_thd->is_error()) return true;
+    null_value = false;
+  }
+  return false;
+}
+
 String *Item_sum_bit::val_str(String *str) {
   if (m_is_window_function) {
     /*
@@ -32,6 +32,7 @@
 #include <climits>
 #include <cmath>
 #include <cstdio>
+#include <deque>
 #include <map>
 #include <memory>
 #include <optional>
@@ -1582,6 +1583,50 @@ class Item_sum_hybrid : public Item_sum {
   */
   int64 m_saved_last_value_at;
 
+  /**
+    Set to true when MIN/MAX is evaluated over a moving ROWS frame with
+    inversion, by maintaining the candidate extrema of the frame in
+    #m_frame_extrema. This gives amortized O(1) work per row instead of
+    re-scanning the whole frame for every row.
+  */
+  bool m_sliding{false};
+
+  /// A candidate for the MIN/MAX value of the current frame.
+  struct Frame_extremum {
+    int64 m_rowno;        ///< Partition relative row number of the value
+    Item_cache *m_value;  ///< Copy of the argument value at m_rowno
+  };
+
+  /**
+    Execution state (windowing, sliding mode): a monotonic queue of candidate
+    values of the current frame, ordered by row number. Each value is
+    strictly better than all values after it, so the front holds the MIN/MAX
+    of the frame. A row leaving the frame is always the oldest one, so it is
+    either at the front or was already dropped.
+  */
+  std::deque<Frame_extremum> m_frame_extrema;
+
+  /// Caches no longer in #m_frame_extrema, kept for reuse.
+  std::vector<Item_cache *> m_free_extrema;
+
+  /// The candidate compared against arg_cache by #m_frame_cmp.
+  Item_cache *m_frame_candidate{nullptr};
+
+  /// Compares #m_frame_candidate with arg_cache in sliding mode.
+  Arg_comparator *m_frame_cmp{nullptr};
+
+  /**
+    Add (or, when inverting, remove) the current row to the monotonic queue
+    of frame extrema, and set the value of the function to the front of the
+    queue.
+
+    @return true on error
+  */
+  bool add_sliding();
+
+  /** Empty the queue of frame extrema, keeping the caches for reuse. */
+  void clear_sliding();
+
   /**
     This function implements the optimized version of retrieving min/max
     value. When we have "ordered ASC" results in a window, min will always
@@ -57,12 +57,14 @@ using std::vector;
 template <bool Reverse>
 IndexScanIterator<Reverse>::IndexScanIterator(THD *thd, TABLE *table, int idx,
                                               bool use_order,
+                                              bool force_keyread,
                                               double expected_rows,
                                               ha_rows *examined_rows)
     : TableRowIterator(thd, table),
       m_record(table->record[0]),
       m_idx(idx),
       m_use_order(use_order),
+      m_force_keyread(force_keyread),
       m_expected_rows(expected_rows),
       m_examined_rows(examined_rows) {}
 
@@ -76,7 +78,8 @@ IndexScanIterator<Reverse>::~IndexScanIterator() {
 template <bool Reverse>
 bool IndexScanIterator<Reverse>::Init() {
   if (!table()->file->inited) {
-    if (table()->covering_keys.is_set(m_idx) && !table()->no_keyread) {
+    if ((m_force_keyread || table()->covering_keys.is_set(m_idx)) &&
+        !table()->no_keyread) {
       table()->set_keyread(true);
     }
 
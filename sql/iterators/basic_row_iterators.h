@@ -106,6 +106,10 @@ class IndexScanIterator final : public TableRowIterator {
   // but do not actually care about the order. In particular, partitioned
   // tables can use this to deliver more efficient scans.
   //
+  // If force_keyread is true, only the columns in the index are read even if
+  // the index is not covering. The caller is responsible for fetching the
+  // full rows later, if needed (see SortingIterator).
+  //
   // “expected_rows” is used for scaling the record buffer.
   // If zero or less, no record buffer will be set up.
   //
@@ -113,7 +117,8 @@ class IndexScanIterator final : public TableRowIterator {
   //
   // "examined_rows", if not nullptr, is incremented for each successful Read().
   IndexScanIterator(THD *thd, TABLE *table, int idx, bool use_order,
-                    double expected_rows, ha_rows *examined_rows);
+                    bool force_keyread, double expected_rows,
+                    ha_rows *examined_rows);
   ~IndexScanIterator() override;
 
   bool Init() override;
@@ -123,6 +128,7 @@ class IndexScanIterator final : public TableRowIterator {
   uchar *const m_record;
   const int m_idx;
   const bool m_use_order;
+  const bool m_force_keyread;
   const double m_expected_rows;
   ha_rows *const m_examined_rows;
   bool m_first = true;
@@ -200,6 +206,9 @@ class SortBufferIndirectIterator final : public RowIterator {
   ~SortBufferIndirectIterator() override;
   bool Init() override;
   int Read() override;
+  /// Skip the given number of rows without fetching them. Must be called
+  /// after Init(). Returns the number of rows skipped.
+  ha_rows SkipRows(ha_rows rows);
   void SetNullRowFlag(bool) override {
     // Handled by SortingIterator.
     assert(false);
@@ -273,6 +282,9 @@ class SortFileIndirectIterator final : public RowIterator {
 
   bool Init() override;
   int Read() override;
+  /// Skip the given number of rows without fetching them. Must be called
+  /// after Init(). Returns the number of rows skipped.
+  ha_rows SkipRows(ha_rows rows);
   void SetNullRowFlag(bool) override {
     // Handled by SortingIterator.
     assert(false);
@@ -138,6 +138,14 @@ bool SortFileIndirectIterator::Init() {
   return false;
 }
 
+ha_rows SortFileIndirectIterator::SkipRows(ha_rows rows) {
+  for (ha_rows row_idx = 0; row_idx < rows; ++row_idx) {
+    if (my_b_read(m_io_cache, m_ref_pos, m_sum_ref_length))
+      return row_idx; /* End of file */
+  }
+  return rows;
+}
+
 static int HandleError(THD *thd, TABLE *table, int error) {
   if (thd->killed) {
     thd->send_kill_message();
@@ -397,6 +405,13 @@ int SortBufferIndirectIterator::Read() {
   }
 }
 
+ha_rows SortBufferIndirectIterator::SkipRows(ha_rows rows) {
+  const ha_rows remaining = (m_cache_end - m_cache_pos) / m_sum_ref_length;
+  const ha_rows skipped_rows = std::min(rows, remaining);
+  m_cache_pos += skipped_rows * m_sum_ref_length;
+  return skipped_rows;
+}
+
 SortingIterator::SortingIterator(THD *thd, Filesort *filesort,
                                  unique_ptr_destroy_only<RowIterator> source,
                                  ha_rows num_rows_estimate,
@@ -446,7 +461,9 @@ bool SortingIterator::Init() {
   // Prepare the result iterator for actually reading the data. Read()
   // will proxy to it.
   Mem_root_array<TABLE *> tables(thd()->mem_root, m_filesort->tables);
-  if (m_sort_result.io_cache && my_b_inited(m_sort_result.io_cache)) {
+  const bool result_in_file =
+      m_sort_result.io_cache && my_b_inited(m_sort_result.io_cache);
+  if (result_in_file) {
     // Test if ref-records was used
     if (m_fs_info.using_addon_fields()) {
       DBUG_PRINT("info", ("using SortFileIterator"));
@@ -497,7 +514,19 @@ bool SortingIterator::Init() {
     }
   }
 
-  return m_result_iterator->Init();
+  if (m_result_iterator->Init()) return true;
+
+  if (m_offset > 0) {
+    // Skip the OFFSET rows by their row IDs, so that they are never read
+    // from the table.
+    assert(!m_fs_info.using_addon_fields());
+    const ha_rows skipped_rows =
+        result_in_file
+            ? m_result_iterator_holder.sort_file_indirect.SkipRows(m_offset)
+            : m_result_iterator_holder.sort_buffer_indirect.SkipRows(m_offset);
+    if (m_skipped_rows != nullptr) *m_skipped_rows += skipped_rows;
+  }
+  return false;
 }
 
 void SortingIterator::SetNullRowFlag(bool is_null_row) {
@@ -102,6 +102,15 @@ class SortingIterator final : public RowIterator {
 
   const Filesort *filesort() const { return m_filesort; }
 
+  /// Skip the first rows of the sorted result in Init(), adding the number
+  /// of skipped rows to *skipped_rows. Only possible when sorting row IDs,
+  /// so that the skipped rows are never read from the table. Used by
+  /// LIMIT ... OFFSET directly on top of the sort.
+  void set_offset(ha_rows offset, ha_rows *skipped_rows) {
+    m_offset = offset;
+    m_skipped_rows = skipped_rows;
+  }
+
  private:
   int DoSort();
   void ReleaseBuffers();
@@ -127,6 +136,8 @@ class SortingIterator final : public RowIterator {
 
   const ha_rows m_num_rows_estimate;
   const table_map m_tables_to_get_rowid_for;
+  ha_rows m_offset = 0;
+  ha_rows *m_skipped_rows = nullptr;
   ha_rows *m_examined_rows;
 
   // Holds one out of all RowIterator implementations we need so that it is
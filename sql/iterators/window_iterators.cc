@@ -574,7 +574,7 @@ bool process_wfs_needing_partition_cardinality(
   defined on the window.
 
   Moving (sliding) frames can be executed using a naive or optimized strategy
-  for aggregate window functions, like SUM or AVG (but not MAX, or MIN).
+  for aggregate window functions, like SUM, AVG, MIN or MAX.
   In the naive approach, for each row considered for processing from the buffer,
   we visit all the rows defined in the frame for that row, essentially leading
   to N*M complexity, where N is the number of rows in the result set, and M is
@@ -584,7 +584,10 @@ bool process_wfs_needing_partition_cardinality(
   the previous aggregate state, but compute the *inverse* function to eliminate
   the contribution to the aggregate by the row(s) leaving the frame, and then
   use the normal aggregate function to add the contribution of the rows moving
-  into the frame. The present method contains code paths for both strategies.
+  into the frame. MIN and MAX have no inverse function; for ROWS frames they
+  instead keep a monotonic queue of candidate values, from which the rows
+  leaving the frame are dropped, cf. Item_sum_hybrid::add_sliding. The present
+  method contains code paths for both strategies.
 
   For integral data types, this is safe in the sense that the result will be the
   same if no overflow occurs during normal evaluation. For floating numbers,
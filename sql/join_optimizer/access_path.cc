@@ -407,11 +407,11 @@ unique_ptr_destroy_only<RowIterator> CreateIteratorFromAccessPath(
         if (param.reverse) {
           iterator = NewIterator<IndexScanIterator<true>>(
               thd, mem_root, param.table, param.idx, param.use_order,
-              path->num_output_rows(), examined_rows);
+              param.force_keyread, path->num_output_rows(), examined_rows);
         } else {
           iterator = NewIterator<IndexScanIterator<false>>(
               thd, mem_root, param.table, param.idx, param.use_order,
-              path->num_output_rows(), examined_rows);
+              param.force_keyread, path->num_output_rows(), examined_rows);
         }
         break;
       }
@@ -897,10 +897,21 @@ unique_ptr_destroy_only<RowIterator> CreateIteratorFromAccessPath(
         } else if (join != nullptr) {
           send_records = &join->send_records;
         }
+        ha_rows limit = param.limit;
+        ha_rows offset = param.offset;
+        if (offset > 0 && param.child->type == AccessPath::SORT &&
+            param.child->sort().force_sort_rowids && !param.count_all_rows &&
+            !param.reject_multiple_rows) {
+          // Let the sort skip the OFFSET rows by row ID, so that they are
+          // never read from the table.
+          down_cast<SortingIterator *>(job.children[0]->real_iterator())
+              ->set_offset(offset, send_records);
+          if (limit != HA_POS_ERROR) limit = limit > offset ? limit - offset : 0;
+          offset = 0;
+        }
         iterator = NewIterator<LimitOffsetIterator>(
-            thd, mem_root, std::move(job.children[0]), param.limit,
-            param.offset, param.count_all_rows, param.reject_multiple_rows,
-            send_records);
+            thd, mem_root, std::move(job.children[0]), limit, offset,
+            param.count_all_rows, param.reject_multiple_rows, send_records);
         break;
       }
       case AccessPath::STREAM: {
@@ -867,6 +867,9 @@ struct AccessPath {
       int idx;
       bool use_order;
       bool reverse;
+      // Read only the columns in the index even if it is not covering, as
+      // the full rows are fetched later by row ID (late materialization).
+      bool force_keyread;
     } index_scan;
     struct {
       TABLE *table;
@@ -1255,6 +1258,7 @@ inline AccessPath *NewIndexScanAccessPath(THD *thd, TABLE *table, int idx,
   path->index_scan().idx = idx;
   path->index_scan().use_order = use_order;
   path->index_scan().reverse = reverse;
+  path->index_scan().force_keyread = false;
   return path;
 }
 
@@ -2340,6 +2340,7 @@ bool CostingReceiver::ProposeIndexScan(
   path.index_scan().idx = key_idx;
   path.index_scan().use_order = true;
   path.index_scan().reverse = reverse;
+  path.index_scan().force_keyread = false;
   path.count_examined_rows = true;
   path.ordering_state = m_orderings->SetOrder(ordering_idx);
 
@@ -5500,6 +5501,145 @@ AccessPath MakeSortPathForDistinct(
   return sort_path;
 }
 
+/**
+  Checks whether an item can be evaluated on an index-only scan of the given
+  index, that is, whether all the columns it references are in the index.
+  Items that may read anything else, such as subqueries, stored programs and
+  full-text functions, are rejected.
+ */
+bool IsEvaluableOnIndex(Item *item, const TABLE *table, uint key_idx) {
+  if (item->has_subquery() || item->has_stored_program()) return false;
+  return !WalkItem(item, enum_walk::PREFIX, [table, key_idx](Item *sub_item) {
+    if (sub_item->type() == Item::FIELD_ITEM) {
+      const Field *field = down_cast<Item_field *>(sub_item)->field;
+      return field->table != table || !field->part_of_key.is_set(key_idx);
+    }
+    return is_function_of_type(sub_item, Item_func::FT_FUNC);
+  });
+}
+
+/**
+  Creates a late materialization (deferred join) alternative for ORDER BY with
+  LIMIT on a single table: Instead of sorting full rows read by a table scan,
+  scan a secondary index that holds all the columns needed by the WHERE
+  condition and the sort key, sort only the row IDs, and fetch the full rows
+  from the clustered index only for the rows that are actually returned. For
+  wide rows and a small LIMIT, this reads much less data than scanning and
+  sorting the full rows.
+
+  @returns the SORT path, with LIMIT_OFFSET on top if there is an OFFSET, or
+  nullptr if root_path is not a (filtered) table scan, or no secondary index
+  holds the required columns.
+ */
+AccessPath *MakeLateMaterializationSortPath(THD *thd, AccessPath *root_path,
+                                            ORDER *order, ha_rows limit_rows,
+                                            ha_rows offset_rows) {
+  AccessPath *filter_path = nullptr;
+  AccessPath *scan_path = root_path;
+  if (scan_path->type == AccessPath::FILTER) {
+    if (scan_path->filter().materialize_subqueries) return nullptr;
+    filter_path = scan_path;
+    scan_path = scan_path->filter().child;
+  }
+  if (scan_path->type != AccessPath::TABLE_SCAN) return nullptr;
+
+  // Rows are fetched by primary key lookups, which must be cheap, and any
+  // row locks must be taken on the full rows that are read.
+  TABLE *table = scan_path->table_scan().table;
+  if (table->s->tmp_table != NO_TMP_TABLE || table->no_keyread ||
+      table->s->primary_key == MAX_KEY ||
+      !table->file->primary_key_is_clustered() ||
+      table->reginfo.lock_type > TL_READ) {
+    return nullptr;
+  }
+
+  const double num_rows = scan_path->num_output_rows_before_filter;
+  int best_key_idx = -1;
+  double best_cost = DBL_MAX;
+  for (uint key_idx = 0; key_idx < table->s->keys; ++key_idx) {
+    // If the index is covering, a regular index-only scan is better.
+    if (key_idx == table->s->primary_key ||
+        !table->keys_in_use_for_query.is_set(key_idx) ||
+        table->covering_keys.is_set(key_idx) ||
+        (table->key_info[key_idx].flags &
+         (HA_FULLTEXT | HA_SPATIAL | HA_MULTI_VALUED_KEY)) != 0) {
+      continue;
+    }
+    if (filter_path != nullptr &&
+        !IsEvaluableOnIndex(filter_path->filter().condition, table, key_idx)) {
+      continue;
+    }
+    bool sort_key_in_index = true;
+    for (ORDER *ord = order; ord != nullptr; ord = ord->next) {
+      if (!IsEvaluableOnIndex(*ord->item, table, key_idx)) {
+        sort_key_in_index = false;
+        break;
+      }
+    }
+    if (!sort_key_in_index) continue;
+
+    const double cost =
+        table->file->index_scan_cost(key_idx, /*ranges=*/1.0, num_rows)
+            .total_cost();
+    if (cost < best_cost) {
+      best_key_idx = key_idx;
+      best_cost = cost;
+    }
+  }
+  if (best_key_idx == -1) return nullptr;
+
+  AccessPath *index_path = new (thd->mem_root) AccessPath(*scan_path);
+  index_path->type = AccessPath::INDEX_SCAN;
+  index_path->index_scan().table = table;
+  index_path->index_scan().idx = best_key_idx;
+  index_path->index_scan().use_order = false;
+  index_path->index_scan().reverse = false;
+  index_path->index_scan().force_keyread = true;
+  index_path->init_cost = index_path->init_once_cost = 0.0;
+  index_path->cost = index_path->cost_before_filter = best_cost;
+
+  AccessPath *sort_child = index_path;
+  if (filter_path != nullptr) {
+    sort_child = new (thd->mem_root) AccessPath(*filter_path);
+    sort_child->filter().child = index_path;
+    const double cost_difference = index_path->cost - scan_path->cost;
+    sort_child->cost += cost_difference;
+    sort_child->cost_before_filter += cost_difference;
+  }
+
+  AccessPath *sort_path = new (thd->mem_root) AccessPath;
+  sort_path->type = AccessPath::SORT;
+  sort_path->count_examined_rows = false;
+  sort_path->sort().child = sort_child;
+  sort_path->sort().filesort = nullptr;
+  sort_path->sort().remove_duplicates = false;
+  sort_path->sort().unwrap_rollup = false;
+  sort_path->sort().limit = limit_rows;
+  sort_path->sort().order = order;
+  sort_path->sort().force_sort_rowids = true;
+  EstimateSortCost(sort_path);
+
+  // The OFFSET rows are skipped by row ID (see SortingIterator::set_offset()),
+  // so only the rows that are returned are fetched from the table.
+  const double num_fetched_rows =
+      std::max(sort_path->num_output_rows() - offset_rows, 0.0);
+  const double fetch_cost =
+      table->file
+          ->read_cost(table->s->primary_key, num_fetched_rows, num_fetched_rows)
+          .total_cost();
+
+  AccessPath *path = sort_path;
+  if (offset_rows != 0) {
+    path = NewLimitOffsetAccessPath(thd, sort_path, limit_rows, offset_rows,
+                                    /*count_all_rows=*/false,
+                                    /*reject_multiple_rows=*/false,
+                                    /*send_records_override=*/nullptr);
+  }
+  path->cost += fetch_cost;
+  path->cost_before_filter = path->cost;
+  return path;
+}
+
 JoinHypergraph::Node *FindNodeWithTable(JoinHypergraph *graph, TABLE *table) {
   for (JoinHypergraph::Node &node : graph->nodes) {
     if (node.table == table) {
@@ -5707,6 +5847,19 @@ Prealloced_array<AccessPath *, 4> ApplyDistinctAndOrder(
         const bool push_limit_to_filesort =
             limit_rows != HA_POS_ERROR && !join->calc_found_rows;
 
+        // Also consider sorting row IDs from an index-only scan and fetching
+        // the full rows afterwards, for ORDER BY with LIMIT on a single table.
+        if (push_limit_to_filesort && !need_rowid && !force_sort_rowids &&
+            !receiver.HasSecondaryEngineCostHook()) {
+          AccessPath *late_path = MakeLateMaterializationSortPath(
+              thd, root_path, join->order.order, limit_rows, offset_rows);
+          if (late_path != nullptr) {
+            receiver.ProposeAccessPath(late_path, &new_root_candidates,
+                                       /*obsolete_orderings=*/0,
+                                       "late materialization");
+          }
+        }
+
         root_path = GetSafePathToSort(thd, join, root_path, need_rowid);
 
         AccessPath *sort_path = new (thd->mem_root) AccessPath;
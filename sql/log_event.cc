@@ -3259,9 +3259,17 @@ int Log_event::apply_event(Relay_log_info *rli) {
   worker =
       (Relay_log_info *)(rli->last_assigned_worker = get_slave_worker(rli));
 
+  if (!rli_thd->is_error() && !rli->abort_slave &&
+      !is_mts_db_partitioned(rli))
+    static_cast<Mts_submode_logical_clock *>(rli->current_mts_submode)
+        ->get_writeset_tracker()
+        ->add_event(rli, this);
+
   if (rli->last_assigned_worker) {
-     rli->last_assigned_worker->is_wait_last_commited = rli->is_wait_last_commited;
-     rli->last_assigned_worker->last_commmitted_seq = rli->last_commmitted_seq;
+    rli->last_assigned_worker->last_commmitted_seq.store(
+        rli->last_commmitted_seq, std::memory_order_release);
+    rli->last_assigned_worker->is_wait_last_commited.store(
+        rli->is_wait_last_commited, std::memory_order_release);
   }
 
 
@@ -9340,6 +9348,9 @@ int Rows_log_event::do_scan_and_update(Relay_log_info const *rli) {
   int idempotent_errors = 0;
   int i = 0;
   bool is_pk_present{false};
+  bool record_positions{false};
+  Hash_slave_row_positions *row_positions =
+      &const_cast<Relay_log_info *>(rli)->hash_row_positions;
 
   saved_last_m_curr_row = m_curr_row;
   saved_last_m_curr_row_end = m_curr_row_end;
@@ -9357,6 +9368,9 @@ int Rows_log_event::do_scan_and_update(Relay_log_info const *rli) {
   is_pk_present = (table->s->primary_key < MAX_KEY) &&
                   (m_key_index == table->s->primary_key);
 
+  record_positions =
+      m_key_index == MAX_KEY && opt_replica_rows_hash_index_max_rows > 0;
+
   /*
      Scan the table only once and compare against entries in hash.
      When a match is found, apply the changes.
@@ -9369,6 +9383,13 @@ int Rows_log_event::do_scan_and_update(Relay_log_info const *rli) {
     if (error) DBUG_PRINT("info", ("error: %s", HA_ERR(error)));
     switch (error) {
       case 0: {
+        bool applied = false;
+        /*
+          Record the position of the rows the scan goes through, so that
+          later events read them directly.
+        */
+        if (record_positions) table->file->position(table->record[0]);
+
         entry = m_hash.get(table, &this->m_local_cols);
         /**
           The do..while loop takes care of the scenario of same row being
@@ -9387,6 +9408,7 @@ int Rows_log_event::do_scan_and_update(Relay_log_info const *rli) {
         */
         do {
           store_record(table, record[1]);
+          applied = false;
 
           /**
              If there are collisions we need to be sure that this is
@@ -9437,11 +9459,20 @@ int Rows_log_event::do_scan_and_update(Relay_log_info const *rli) {
                 goto close_table;
 
               do_post_row_operations(rli, error);
-            }
+            } else
+              applied = true;
           }
         } while (this->get_general_type_code() ==
                      binary_log::UPDATE_ROWS_EVENT &&
                  !is_pk_present && (entry = m_hash.get(table, &m_local_cols)));
+
+        if (record_positions &&
+            !(applied &&
+              get_general_type_code() == binary_log::DELETE_ROWS_EVENT)) {
+          /* record[1] has the row as it is in the table, unless changed. */
+          if (!applied) restore_record(table, record[1]);
+          row_positions->add(table, &this->m_local_cols, table->file->ref);
+        }
       } break;
 
       case HA_ERR_RECORD_DELETED:
@@ -9506,6 +9537,19 @@ int Rows_log_event::do_hash_scan_and_update(Relay_log_info const *rli) {
   DBUG_TRACE;
   assert(m_table && m_table->in_use != nullptr);
 
+  /*
+    Rows of a table without a usable key may be found at a position known
+    from earlier events. Once a row of the event needs the scan, the next
+    rows wait for it too, so that rows are still applied in order. Nothing
+    is recorded while @@replica_rows_hash_index_max_rows is 0.
+  */
+  if (m_key_index == MAX_KEY && m_hash.is_empty() &&
+      opt_replica_rows_hash_index_max_rows > 0) {
+    bool found = false;
+    int error = do_hash_row_at_position(rli, &found);
+    if (error || found) return error;
+  }
+
   // HASHING PART
 
   /* unpack the BI (and AI, if it exists) and add it to the hash map. */
@@ -9523,6 +9567,78 @@ int Rows_log_event::do_hash_scan_and_update(Relay_log_info const *rli) {
   return this->do_scan_and_update(rli);
 }
 
+int Rows_log_event::do_hash_row_at_position(Relay_log_info const *rli,
+                                            bool *found) {
+  DBUG_TRACE;
+  TABLE *table = m_table;
+  Hash_slave_row_positions *row_positions =
+      &const_cast<Relay_log_info *>(rli)->hash_row_positions;
+  const uchar *saved_m_curr_row = m_curr_row;
+  std::vector<std::string> positions;
+  uint key = 0;
+  int error = 0;
+
+  *found = false;
+
+  /* unpack the before image */
+  prepare_record(table, &this->m_local_cols, false);
+  if ((error = unpack_current_row(rli, &m_cols, false /*is not AI*/)))
+    return error;
+
+  if (!row_positions->find(table, &this->m_local_cols, &key, &positions) ||
+      positions.empty())
+    return 0;
+
+  /** save a copy so that we can compare against it later */
+  store_record(table, record[1]);
+
+  if ((error = table->file->ha_rnd_init(false))) {
+    table->file->print_error(error, MYF(0));
+    return error;
+  }
+
+  uchar *pos = nullptr;
+  for (std::string &position : positions) {
+    pos = pointer_cast<uchar *>(&position[0]);
+    error = table->file->ha_rnd_pos(table->record[0], pos);
+    if (!error && !record_compare(table, &this->m_local_cols)) {
+      *found = true;
+      break;
+    }
+    if (error && error != HA_ERR_KEY_NOT_FOUND &&
+        error != HA_ERR_RECORD_DELETED && error != HA_ERR_END_OF_FILE)
+      break;
+    /* The row was deleted or changed since its position was recorded. */
+    row_positions->remove(table, key, pos);
+    error = 0;
+  }
+
+  if (*found) {
+    error = do_apply_row(rli);
+    if (!error) {
+      row_positions->remove(table, key, pos);
+      if (get_general_type_code() == binary_log::UPDATE_ROWS_EVENT)
+        row_positions->add(table, &this->m_local_cols, pos);
+    }
+  } else if (error) {
+    DBUG_PRINT("info", ("Failed to read record"
+                        " (ha_rnd_pos returns %d)",
+                        error));
+    table->file->print_error(error, MYF(0));
+  }
+
+  if (!error)
+    error = close_record_scan();
+  else
+    (void)close_record_scan();
+
+  if (*found) {
+    int unpack_error = skip_after_image_for_update_event(rli, saved_m_curr_row);
+    if (!error) error = unpack_error;
+  }
+  return error;
+}
+
 int Rows_log_event::do_table_scan_and_update(Relay_log_info const *rli) {
   int error = 0;
   const uchar *saved_m_curr_row = m_curr_row;
@@ -9863,6 +9979,14 @@ int Rows_log_event::do_apply_event(Relay_log_info const *rli) {
     table_def *table_def = nullptr;
     TABLE *conv_table = nullptr;
     rli->get_table_data(table, &table_def, &conv_table);
+
+    if (is_mts_worker(thd)) {
+      Relay_log_info *c_rli = static_cast<const Slave_worker *>(rli)->c_rli;
+      if (!is_mts_db_partitioned(c_rli))
+        static_cast<Mts_submode_logical_clock *>(c_rli->current_mts_submode)
+            ->get_writeset_tracker()
+            ->note_table(rli, this, table);
+    }
     m_column_view = cs::util::ReplicatedColumnsViewFactory::
         get_columns_view_with_inbound_filters(thd, table, table_def);
 
@@ -12403,6 +12527,13 @@ int Write_rows_log_event::do_exec_row(const Relay_log_info *const rli) {
     my_error(ER_UNKNOWN_ERROR, MYF(0));
   }
 
+  if (!error && opt_replica_rows_hash_index_max_rows > 0) {
+    /* Later events of a table without a usable key may change the row. */
+    m_table->file->position(m_table->record[0]);
+    const_cast<Relay_log_info *>(rli)->hash_row_positions.add_written(
+        m_table, m_table->file->ref);
+  }
+
   return error;
 }
 
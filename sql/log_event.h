@@ -2381,12 +2381,12 @@ class Table_map_log_event : public binary_log::Table_map_event,
 
   ~Table_map_log_event() override;
 
-#ifndef MYSQL_SERVER
   table_def *create_table_def() {
     assert(m_colcnt > 0);
     return new table_def(m_coltype, m_colcnt, m_field_metadata,
                          m_field_metadata_size, m_null_bits, m_flags);
   }
+#ifndef MYSQL_SERVER
   static bool rewrite_db_in_buffer(char **buf, ulong *event_len,
                                    const Format_description_event &fde);
 #endif
@@ -2717,6 +2717,10 @@ class Rows_log_event : public virtual binary_log::Rows_event, public Log_event {
   MY_BITMAP const *get_cols() const { return &m_cols; }
   MY_BITMAP const *get_cols_ai() const { return &m_cols_ai; }
   const Table_id &get_table_id() const { return m_table_id; }
+  /** The rows of the event, in packed format. */
+  const uchar *get_rows_buf() const { return m_rows_buf; }
+  /** One-after the end of the rows of the event. */
+  const uchar *get_rows_end() const { return m_rows_cur; }
 
 #if defined(MYSQL_SERVER)
   /**
@@ -3137,6 +3141,17 @@ class Rows_log_event : public virtual binary_log::Rows_event, public Log_event {
     @returns 0 on success. Otherwise, the error code.
   */
   int do_scan_and_update(Relay_log_info const *rli);
+
+  /**
+    Tries to apply the current row of a HASH_SCAN over a table without a
+    usable key by reading the row at a position recorded by the applier in
+    Relay_log_info::hash_row_positions, instead of hashing it for a scan.
+
+    @param      rli    The reference to the relay log info object.
+    @param[out] found  true if the row was found and applied.
+    @returns 0 on success. Otherwise, the error code.
+  */
+  int do_hash_row_at_position(Relay_log_info const *rli, bool *found);
 #endif /* defined(MYSQL_SERVER) */
 
   friend class Old_rows_log_event;
@@ -776,6 +776,7 @@ MySQL clients support the protocol:
 #include "sql/auth/sql_security_ctx.h"
 #include "sql/auto_thd.h"   // Auto_THD
 #include "sql/binlog.h"     // mysql_bin_log
+#include "sql/binlog/compressing_cache_ostream.h"
 #include "sql/bootstrap.h"  // bootstrap
 #include "sql/check_stack.h"
 #include "sql/conn_handler/connection_acceptor.h"  // Connection_acceptor
@@ -816,11 +817,14 @@ MySQL clients support the protocol:
 #include "sql/range_optimizer/range_optimizer.h"    // range_optimizer_init
 #include "sql/replication.h"                        // thd_enter_cond
 #include "sql/resourcegroups/resource_group_mgr.h"  // init, post_init
+#include "sql/result_cache.h"  // result_cache
 #ifdef _WIN32
 #include "sql/restart_monitor_win.h"
 #endif
 #include "my_openssl_fips.h"  // OPENSSL_ERROR_LENGTH, set_fips_mode
 #include "sql/rpl_async_conn_failover_configuration_propagation.h"
+#include "sql/rpl_binlog_event_cache.h"
+#include "sql/rpl_commit_stage_manager.h"  // Commit_stage_manager
 #include "sql/rpl_filter.h"
 #include "sql/rpl_gtid.h"
 #include "sql/rpl_gtid_persist.h"  // Gtid_table_persistor
@@ -1355,6 +1359,7 @@ ulong binlog_stmt_cache_size = 0;
 int32 opt_binlog_max_flush_queue_time = 0;
 long opt_binlog_group_commit_sync_delay = 0;
 ulong opt_binlog_group_commit_sync_no_delay_count = 0;
+bool opt_binlog_group_commit_sync_delay_adaptive = false;
 ulonglong max_binlog_stmt_cache_size = 0;
 ulong refresh_version; /* Increments on each reload */
 std::atomic<query_id_t> atomic_global_query_id{1};
@@ -2656,6 +2661,9 @@ static void clean_up(bool print_message) {
   delegates_destroy();
   xa::Transaction_cache::dispose();
   MDL_context_backup_manager::destroy();
+  result_cache.destroy();
+  binlog_event_cache.destroy();
+  binlog::compression_threads_deinit();
   table_def_free();
   mdl_destroy();
   key_caches.delete_elements();
@@ -6234,6 +6242,18 @@ static int init_server_components() {
     unireg_abort(MYSQLD_ABORT_EXIT);
   }
 
+  if (result_cache.init()) {
+    LogErr(ERROR_LEVEL, ER_OOM);
+    unireg_abort(MYSQLD_ABORT_EXIT);
+  }
+
+  if (binlog_event_cache.init(binlog_dump_cache_size)) {
+    LogErr(ERROR_LEVEL, ER_OOM);
+    unireg_abort(MYSQLD_ABORT_EXIT);
+  }
+
+  if (binlog::compression_threads_init()) unireg_abort(MYSQLD_ABORT_EXIT);
+
   /*
     initialize delegates for extension observers, errors have already
     been reported in the function
@@ -9382,6 +9402,24 @@ static int show_aborted_connects(THD *, SHOW_VAR *var, char *buff) {
   return 0;
 }
 
+static int show_binlog_group_commit_adaptive_sync_delay(THD *, SHOW_VAR *var,
+                                                        char *buff) {
+  var->type = SHOW_LONGLONG;
+  var->value = buff;
+  *(reinterpret_cast<ulonglong *>(buff)) =
+      Commit_stage_manager::get_instance().get_adaptive_sync_delay();
+  return 0;
+}
+
+static int show_binlog_group_commit_sync_time(THD *, SHOW_VAR *var,
+                                              char *buff) {
+  var->type = SHOW_LONGLONG;
+  var->value = buff;
+  *(reinterpret_cast<ulonglong *>(buff)) =
+      Commit_stage_manager::get_instance().get_average_sync_time();
+  return 0;
+}
+
 static int show_acl_cache_items_count(THD *, SHOW_VAR *var, char *buff) {
   var->type = SHOW_LONG;
   var->value = buff;
@@ -9680,6 +9718,16 @@ SHOW_VAR status_vars[] = {
      SHOW_SCOPE_GLOBAL},
     {"Binlog_cache_use", (char *)&binlog_cache_use, SHOW_LONG,
      SHOW_SCOPE_GLOBAL},
+    {"Binlog_dump_cache_hits", (char *)&show_binlog_dump_cache_hits,
+     SHOW_FUNC, SHOW_SCOPE_GLOBAL},
+    {"Binlog_dump_cache_misses", (char *)&show_binlog_dump_cache_misses,
+     SHOW_FUNC, SHOW_SCOPE_GLOBAL},
+    {"Binlog_group_commit_adaptive_sync_delay",
+     (char *)&show_binlog_group_commit_adaptive_sync_delay, SHOW_FUNC,
+     SHOW_SCOPE_GLOBAL},
+    {"Binlog_group_commit_sync_time",
+     (char *)&show_binlog_group_commit_sync_time, SHOW_FUNC,
+     SHOW_SCOPE_GLOBAL},
     {"Binlog_stmt_cache_disk_use", (char *)&binlog_stmt_cache_disk_use,
      SHOW_LONG, SHOW_SCOPE_GLOBAL},
     {"Binlog_stmt_cache_use", (char *)&binlog_stmt_cache_use, SHOW_LONG,
@@ -9849,6 +9897,10 @@ SHOW_VAR status_vars[] = {
     {"Queries", (char *)&show_queries, SHOW_FUNC, SHOW_SCOPE_ALL},
     {"Questions", (char *)offsetof(System_status_var, questions),
      SHOW_LONGLONG_STATUS, SHOW_SCOPE_ALL},
+    {"Result_cache_hits", (char *)&show_result_cache_hits, SHOW_FUNC,
+     SHOW_SCOPE_GLOBAL},
+    {"Result_cache_inserts", (char *)&show_result_cache_inserts, SHOW_FUNC,
+     SHOW_SCOPE_GLOBAL},
     {"Secondary_engine_execution_count",
      (char *)offsetof(System_status_var, secondary_engine_execution_count),
      SHOW_LONGLONG_STATUS, SHOW_SCOPE_ALL},
@@ -9994,6 +10046,8 @@ SHOW_VAR status_vars[] = {
      SHOW_SCOPE_GLOBAL},
     {"Tc_log_page_waits", (char *)&tc_log_page_waits, SHOW_LONG,
      SHOW_SCOPE_GLOBAL},
+    {"Threadpool", (char *)Thread_pool_connection_handler::status_vars,
+     SHOW_ARRAY, SHOW_SCOPE_GLOBAL},
     {"Threads_cached",
      (char *)&Per_thread_connection_handler::blocked_pthread_count,
      SHOW_LONG_NOFLUSH, SHOW_SCOPE_GLOBAL},
@@ -11819,6 +11873,8 @@ PSI_mutex_key key_relay_log_info_run_lock;
 PSI_mutex_key key_mutex_slave_parallel_pend_jobs;
 PSI_mutex_key key_mutex_slave_parallel_worker_count;
 PSI_mutex_key key_mutex_slave_parallel_worker;
+PSI_mutex_key key_mutex_mta_writeset_layouts;
+PSI_mutex_key key_mutex_mta_transaction_dependencies;
 PSI_mutex_key key_structure_guard_mutex;
 PSI_mutex_key key_TABLE_SHARE_LOCK_ha_data;
 PSI_mutex_key key_LOCK_query_plan;
@@ -11908,6 +11964,8 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_mutex_slave_parallel_pend_jobs, "Relay_log_info::pending_jobs_lock", 0, 0, PSI_DOCUMENT_ME},
   { &key_mutex_slave_parallel_worker_count, "Relay_log_info::exit_count_lock", 0, 0, PSI_DOCUMENT_ME},
   { &key_mutex_slave_parallel_worker, "Worker_info::jobs_lock", 0, 0, PSI_DOCUMENT_ME},
+  { &key_mutex_mta_writeset_layouts, "Mta_writeset_tracker::layouts_lock", 0, 0, PSI_DOCUMENT_ME},
+  { &key_mutex_mta_transaction_dependencies, "Mta_transaction_dependencies::lock", 0, 0, PSI_DOCUMENT_ME},
   { &key_TABLE_SHARE_LOCK_ha_data, "TABLE_SHARE::LOCK_ha_data", 0, 0, PSI_DOCUMENT_ME},
   { &key_LOCK_error_messages, "LOCK_error_messages", PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
   { &key_LOCK_log_throttle_qni, "LOCK_log_throttle_qni", PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
@@ -12241,6 +12299,9 @@ PSI_stage_info stage_rpl_failover_updating_source_member_details= { 0, "Updating
 PSI_stage_info stage_rpl_failover_wait_before_next_fetch= { 0, "Wait before trying to fetch next membership changes from source", 0, PSI_DOCUMENT_ME};
 PSI_stage_info stage_communication_delegation= { 0, "Connection delegated to Group Replication", 0, PSI_DOCUMENT_ME};
 PSI_stage_info stage_wait_on_commit_ticket= { 0, "Waiting for Binlog Group Commit ticket", 0, PSI_DOCUMENT_ME};
+PSI_stage_info stage_binlog_group_commit_flush= { 0, "Flushing binary log group", 0, PSI_DOCUMENT_ME};
+PSI_stage_info stage_binlog_group_commit_sync= { 0, "Syncing binary log group", 0, PSI_DOCUMENT_ME};
+PSI_stage_info stage_binlog_group_commit_commit= { 0, "Committing binary log group", 0, PSI_DOCUMENT_ME};
 /* clang-format on */
 
 extern PSI_stage_info stage_waiting_for_disk_space;
@@ -12345,7 +12406,10 @@ PSI_stage_info *all_server_stages[] = {
     &stage_rpl_failover_updating_source_member_details,
     &stage_rpl_failover_wait_before_next_fetch,
     &stage_communication_delegation,
-    &stage_wait_on_commit_ticket};
+    &stage_wait_on_commit_ticket,
+    &stage_binlog_group_commit_flush,
+    &stage_binlog_group_commit_sync,
+    &stage_binlog_group_commit_commit};
 
 PSI_socket_key key_socket_tcpip;
 PSI_socket_key key_socket_unix;
@@ -339,6 +339,7 @@ extern ulonglong max_binlog_cache_size, max_binlog_stmt_cache_size;
 extern int32 opt_binlog_max_flush_queue_time;
 extern long opt_binlog_group_commit_sync_delay;
 extern ulong opt_binlog_group_commit_sync_no_delay_count;
+extern bool opt_binlog_group_commit_sync_delay_adaptive;
 extern ulong max_binlog_size, max_relay_log_size;
 extern ulong replica_max_allowed_packet;
 extern ulong binlog_row_event_max_size;
@@ -451,6 +452,8 @@ extern PSI_mutex_key key_relay_log_info_run_lock;
 extern PSI_mutex_key key_mutex_slave_parallel_pend_jobs;
 extern PSI_mutex_key key_mutex_slave_parallel_worker;
 extern PSI_mutex_key key_mutex_slave_parallel_worker_count;
+extern PSI_mutex_key key_mutex_mta_writeset_layouts;
+extern PSI_mutex_key key_mutex_mta_transaction_dependencies;
 extern PSI_mutex_key key_structure_guard_mutex;
 extern PSI_mutex_key key_TABLE_SHARE_LOCK_ha_data;
 extern PSI_mutex_key key_LOCK_query_plan;
@@ -653,6 +656,9 @@ extern PSI_stage_info stage_rpl_failover_updating_source_member_details;
 extern PSI_stage_info stage_rpl_failover_wait_before_next_fetch;
 extern PSI_stage_info stage_communication_delegation;
 extern PSI_stage_info stage_wait_on_commit_ticket;
+extern PSI_stage_info stage_binlog_group_commit_flush;
+extern PSI_stage_info stage_binlog_group_commit_sync;
+extern PSI_stage_info stage_binlog_group_commit_commit;
 #ifdef HAVE_PSI_STATEMENT_INTERFACE
 /**
   Statement instrumentation keys (sql).
@@ -454,6 +454,7 @@
 #include "sql/item_func.h"  // Item_func_set_user_var
 #include "sql/my_decimal.h"
 #include "sql/mysqld.h"  // global_system_variables
+#include "sql/result_cache.h"
 #include "sql/session_tracker.h"
 #include "sql/sql_class.h"  // THD
 #include "sql/sql_error.h"
@@ -1365,6 +1366,10 @@ bool Protocol_classic::init_net(Vio *vio) {
   return my_net_init(&m_thd->net, vio);
 }
 
+bool Protocol_classic::reinit_net(Vio *vio) {
+  return my_net_reinit(&m_thd->net, vio);
+}
+
 void Protocol_classic::claim_memory_ownership(bool claim) {
   net_claim_memory_ownership(&m_thd->net, claim);
 }
@@ -1375,6 +1380,12 @@ void Protocol_classic::end_net() {
   m_thd->net.vio = nullptr;
 }
 
+void Protocol_classic::end_net_keep_buffer() {
+  assert(m_thd->net.buff);
+  net_end_keep_buffer(&m_thd->net);
+  m_thd->net.vio = nullptr;
+}
+
 bool Protocol_classic::write(const uchar *ptr, size_t len) {
   return my_net_write(&m_thd->net, ptr, len);
 }
@@ -3099,6 +3110,8 @@ bool Protocol_classic::start_result_metadata(uint num_cols_arg, uint flags,
       pos++;
     }
 
+    if (m_result_capture != nullptr)
+      m_result_capture->add_packet(tmp, (size_t)(pos - (uchar *)&tmp));
     my_net_write(&m_thd->net, (uchar *)&tmp, (size_t)(pos - (uchar *)&tmp));
   }
   DBUG_EXECUTE_IF("send_large_column_count_in_metadata",
@@ -3360,6 +3373,9 @@ bool Protocol_classic::send_field_metadata(Send_field *field,
 
 bool Protocol_classic::end_row() {
   DBUG_TRACE;
+  if (m_result_capture != nullptr)
+    m_result_capture->add_packet(pointer_cast<uchar *>(packet->ptr()),
+                                 packet->length());
   return my_net_write(&m_thd->net, pointer_cast<uchar *>(packet->ptr()),
                       packet->length());
 }
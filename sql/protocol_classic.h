@@ -38,6 +38,7 @@
 #include "violite.h"
 
 class Item_param;
+class Result_cache_capture;
 class Send_field;
 class String;
 class i_string;
@@ -72,6 +73,8 @@ class Protocol_classic : public Protocol {
   ulong input_packet_length;
   uchar *input_raw_packet;
   const CHARSET_INFO *result_cs;
+  /// Receives a copy of the result set packets, see Result_cache.
+  Result_cache_capture *m_result_capture{nullptr};
 
   bool send_ok(uint server_status, uint statement_warn_count,
                ulonglong affected_rows, ulonglong last_insert_id,
@@ -96,6 +99,13 @@ class Protocol_classic : public Protocol {
     init(thd);
   }
   void init(THD *thd_arg);
+  /**
+    Set the object that receives a copy of every result set packet sent,
+    or nullptr to stop capturing.
+  */
+  void set_result_capture(Result_cache_capture *capture) {
+    m_result_capture = capture;
+  }
   bool store_field(const Field *field) final;
   bool store_string(const char *from, size_t length,
                     const CHARSET_INFO *cs) final;
@@ -146,9 +156,13 @@ class Protocol_classic : public Protocol {
   // NET interaction functions
   /* Initialize NET */
   bool init_net(Vio *vio);
+  /* Initialize NET ended by end_net_keep_buffer() */
+  bool reinit_net(Vio *vio);
   void claim_memory_ownership(bool claim);
   /* Deinitialize NET */
   void end_net();
+  /* Deinitialize NET, keeping its buffer for reinit_net() */
+  void end_net_keep_buffer();
   /* Write data to NET buffer */
   bool write(const uchar *ptr, size_t len);
   /* Return last error from NET */
@@ -365,6 +365,64 @@ static SEL_TREE *get_func_mm_tree_from_in_predicate(
   if (predicand->type() == Item::FIELD_ITEM) {
     // The expression is (<column>) IN (...)
     Field *field = down_cast<Item_field *>(predicand)->field;
+
+    /*
+      Long lists of constants are taken from the sorted array used for
+      bisection rather than from the arguments: duplicates are skipped, and
+      since the values come in order, each new interval is appended at the
+      end of the tree built so far. On integer columns, a run of consecutive
+      values becomes a single closed range, so a dense list of ids needs a
+      handful of SEL_ARGs rather than one per value.
+    */
+    const uint IN_SORTED_ARRAY_THRESHOLD = 1000;
+    in_vector *const array = op->m_const_array;
+    if (array != nullptr && !array->is_row_result() &&
+        array->m_used_size > IN_SORTED_ARRAY_THRESHOLD) {
+      bool merge_runs;
+      switch (field->real_type()) {
+        case MYSQL_TYPE_TINY:
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_LONGLONG:
+          merge_runs = true;
+          break;
+        default:
+          merge_runs = false;
+      }
+      Item_basic_constant *value_item = array->create_item(thd->mem_root);
+      Item_basic_constant *last_item = array->create_item(thd->mem_root);
+      if (value_item == nullptr || last_item == nullptr) return nullptr;
+
+      SEL_TREE *tree = nullptr;
+      for (uint i = 0; i < array->m_used_size;) {
+        uint last = i;
+        while (last + 1 < array->m_used_size &&
+               (!array->compare_elems(last + 1, last) ||
+                (merge_runs && array->is_successor(last + 1))))
+          last++;
+
+        SEL_TREE *tree2;
+        array->value_to_item(i, value_item);
+        if (array->compare_elems(last, i)) {
+          array->value_to_item(last, last_item);
+          tree2 = tree_and(
+              param,
+              get_mm_parts(thd, param, prev_tables, read_tables, op, field,
+                           Item_func::GE_FUNC, value_item),
+              get_mm_parts(thd, param, prev_tables, read_tables, op, field,
+                           Item_func::LE_FUNC, last_item));
+        } else {
+          tree2 = get_mm_parts(thd, param, prev_tables, read_tables, op,
+                               field, Item_func::EQ_FUNC, value_item);
+        }
+        tree = i == 0 ? tree2 : tree_or(param, remove_jump_scans, tree, tree2);
+        if (tree == nullptr) break;
+        i = last + 1;
+      }
+      return tree;
+    }
+
     SEL_TREE *tree =
         get_mm_parts(thd, param, prev_tables, read_tables, op, field,
                      Item_func::EQ_FUNC, op->arguments()[1]);
@@ -0,0 +1,524 @@
+/* Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "sql/result_cache.h"
+
+#include <ctype.h>
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "m_string.h"  // native_strncasecmp
+#include "map_helpers.h"
+#include "my_byteorder.h"
+#include "my_dbug.h"
+#include "my_sqlcommand.h"
+#include "mutex_lock.h"
+#include "mysql/components/services/bits/psi_bits.h"
+#include "mysql/psi/mysql_memory.h"
+#include "mysql/psi/mysql_mutex.h"
+#include "mysql/status_var.h"
+#include "mysql_com.h"
+#include "sql/auth/auth_common.h"
+#include "sql/auth/sql_security_ctx.h"
+#include "sql/handler.h"
+#include "sql/protocol_classic.h"
+#include "sql/sql_class.h"
+#include "sql/sql_lex.h"
+#include "sql/sql_locale.h"  // MY_LOCALE
+#include "sql/sql_parse.h"   // is_single_select_query_text
+#include "sql/system_variables.h"
+#include "sql/table.h"
+#include "sql/transaction_info.h"
+#include "sql/tztime.h"
+#include "sql_string.h"
+
+ulonglong query_result_cache_size = 0;
+
+Result_cache result_cache;
+
+static PSI_mutex_key key_LOCK_result_cache;
+static PSI_memory_key key_memory_result_cache;
+
+#ifdef HAVE_PSI_INTERFACE
+static PSI_mutex_info result_cache_mutexes[] = {
+    {&key_LOCK_result_cache, "LOCK_result_cache", 0, 0, PSI_DOCUMENT_ME}};
+
+static PSI_memory_info result_cache_memory[] = {
+    {&key_memory_result_cache, "Result_cache", PSI_FLAG_ONLY_GLOBAL_STAT, 0,
+     "Result sets and infrastructure of the query result cache."}};
+
+static void init_result_cache_psi_keys() {
+  const char *category = "sql";
+  int count = static_cast<int>(array_elements(result_cache_mutexes));
+  mysql_mutex_register(category, result_cache_mutexes, count);
+
+  count = static_cast<int>(array_elements(result_cache_memory));
+  mysql_memory_register(category, result_cache_memory, count);
+}
+#endif /* HAVE_PSI_INTERFACE */
+
+/**
+  A cached result set and the table versions it was computed from.
+*/
+class Result_cache_entry {
+ public:
+  struct Table_version {
+    uint m_slot;
+    ulonglong m_version;
+  };
+
+  Result_cache_entry()
+      : m_packets(Malloc_allocator<uchar>(key_memory_result_cache)),
+        m_tables(Malloc_allocator<Table_version>(key_memory_result_cache)) {}
+
+  size_t size() const {
+    return sizeof(*this) + m_packets.size() +
+           m_tables.size() * sizeof(Table_version);
+  }
+
+  std::vector<uchar, Malloc_allocator<uchar>> m_packets;
+  std::vector<Table_version, Malloc_allocator<Table_version>> m_tables;
+  ulonglong m_epoch{0};
+  ha_rows m_row_count{0};
+  /// The query text enables caching with a SET_VAR hint.
+  bool m_enabled_by_query{false};
+};
+
+/**
+  One shard of the result cache: entries whose key hashes to it, in LRU
+  order, protected by the shard mutex.
+*/
+class Result_cache_shard {
+ public:
+  using Lru_list = std::list<std::string, Malloc_allocator<std::string>>;
+
+  struct Element {
+    std::shared_ptr<const Result_cache_entry> m_entry;
+    Lru_list::iterator m_lru_position;
+    size_t m_size;
+  };
+
+  Result_cache_shard()
+      : m_elements(key_memory_result_cache),
+        m_lru(Malloc_allocator<std::string>(key_memory_result_cache)) {}
+
+  void erase(malloc_unordered_map<std::string, Element>::iterator it) {
+    m_size -= it->second.m_size;
+    m_lru.erase(it->second.m_lru_position);
+    m_elements.erase(it);
+  }
+
+  void clear() {
+    m_elements.clear();
+    m_lru.clear();
+    m_size = 0;
+  }
+
+  mysql_mutex_t m_lock;
+  malloc_unordered_map<std::string, Element> m_elements;
+  /// Keys of m_elements, most recently used first.
+  Lru_list m_lru;
+  /// Total size of the entries and keys in this shard.
+  size_t m_size{0};
+};
+
+Result_cache_capture::Result_cache_capture(size_t max_size,
+                                           ulonglong write_sequence,
+                                           ulonglong epoch)
+    : m_packets(Malloc_allocator<uchar>(key_memory_result_cache)),
+      m_max_size(max_size),
+      m_write_sequence(write_sequence),
+      m_epoch(epoch) {}
+
+void Result_cache_capture::add_packet(const uchar *data, size_t length) {
+  if (m_overflow) return;
+  if (m_packets.size() + length + 4 > m_max_size) {
+    m_overflow = true;
+    m_packets.clear();
+    m_packets.shrink_to_fit();
+    return;
+  }
+  uchar header[4];
+  int4store(header, static_cast<uint32>(length));
+  m_packets.insert(m_packets.end(), header, header + sizeof(header));
+  m_packets.insert(m_packets.end(), data, data + length);
+}
+
+/**
+  Map a table to its version slot. Names are folded to lower case, a
+  collision only invalidates more results than necessary.
+*/
+
+static uint table_version_slot(const char *db, const char *table_name) {
+  uint64 hash = 14695981039346656037ULL;
+  auto add = [&hash](const char *str) {
+    for (; *str != '\0'; str++) {
+      hash ^= static_cast<uchar>(tolower(static_cast<uchar>(*str)));
+      hash *= 1099511628211ULL;
+    }
+    hash ^= '.';
+    hash *= 1099511628211ULL;
+  };
+  add(db);
+  add(table_name);
+  return static_cast<uint>(hash % Result_cache::TABLE_VERSION_SLOTS);
+}
+
+/**
+  Build the cache key of the current query of a session: the query text, the
+  account and roles it runs with, and the session settings that affect the
+  contents or encoding of the result set.
+*/
+
+static std::string result_cache_key(THD *thd) {
+  std::string key(thd->query().str, thd->query().length);
+  auto add_string = [&key](const char *str, size_t length) {
+    if (str != nullptr) key.append(str, length);
+    key.push_back('\0');
+  };
+  add_string(thd->db().str, thd->db().length);
+
+  Security_context *sctx = thd->security_context();
+  add_string(sctx->priv_user().str, sctx->priv_user().length);
+  add_string(sctx->priv_host().str, sctx->priv_host().length);
+  for (const Auth_id_ref &role : *sctx->get_active_roles()) {
+    add_string(role.first.str, role.first.length);
+    add_string(role.second.str, role.second.length);
+  }
+
+  const System_variables &vars = thd->variables;
+  const ulonglong settings[] = {
+      vars.sql_mode,
+      thd->get_protocol()->get_client_capabilities(),
+      vars.character_set_client->number,
+      vars.character_set_results != nullptr
+          ? vars.character_set_results->number
+          : 0,
+      vars.collation_connection->number,
+      reinterpret_cast<uintptr_t>(vars.time_zone),
+      static_cast<ulonglong>(vars.lc_time_names->number),
+      vars.div_precincrement,
+      vars.group_concat_max_len,
+      vars.default_week_format,
+      vars.max_sort_length,
+      vars.select_limit,
+      vars.resultset_metadata};
+  key.append(pointer_cast<const char *>(settings), sizeof(settings));
+  return key;
+}
+
+bool Result_cache::init() {
+#ifdef HAVE_PSI_INTERFACE
+  init_result_cache_psi_keys();
+#endif
+  m_shards.reset(new (std::nothrow) Result_cache_shard[SHARDS]);
+  if (m_shards == nullptr) return true;
+  for (uint i = 0; i < SHARDS; i++)
+    mysql_mutex_init(key_LOCK_result_cache, &m_shards[i].m_lock,
+                     MY_MUTEX_INIT_FAST);
+  for (auto &version : m_table_versions) version.store(0);
+  return false;
+}
+
+void Result_cache::destroy() {
+  if (m_shards == nullptr) return;
+  for (uint i = 0; i < SHARDS; i++) {
+    m_shards[i].clear();
+    mysql_mutex_destroy(&m_shards[i].m_lock);
+  }
+  m_shards.reset();
+}
+
+void Result_cache::resize() {
+  if (m_shards == nullptr) return;
+  for (uint i = 0; i < SHARDS; i++) {
+    MUTEX_LOCK(guard, &m_shards[i].m_lock);
+    m_shards[i].clear();
+  }
+}
+
+Result_cache_shard *Result_cache::shard_for(size_t key_hash) const {
+  return &m_shards[key_hash % SHARDS];
+}
+
+/**
+  Check whether a query text may hold a locking clause: FOR UPDATE,
+  FOR SHARE or LOCK IN SHARE MODE. Lookups happen before parsing, so this
+  looks for the words UPDATE and SHARE. Texts that merely contain them are
+  neither stored nor served, which is only a missed opportunity.
+*/
+
+static bool may_be_locking_read_text(const LEX_CSTRING &query) {
+  const char *pos = query.str;
+  const char *end = query.str + query.length;
+  while (pos < end) {
+    if (!isalpha(static_cast<uchar>(*pos))) {
+      pos++;
+      continue;
+    }
+    const char *word = pos;
+    while (pos < end && (isalnum(static_cast<uchar>(*pos)) || *pos == '_'))
+      pos++;
+    const size_t length = pos - word;
+    if ((length == 6 && native_strncasecmp(word, "UPDATE", 6) == 0) ||
+        (length == 5 && native_strncasecmp(word, "SHARE", 5) == 0))
+      return true;
+  }
+  return false;
+}
+
+/**
+  Check whether a session sees committed data as of statement start, and
+  can thus share results with other sessions. Prepared statements are
+  excluded as their text does not contain the parameter values. Whether
+  caching is enabled for the statement is checked by the callers.
+*/
+
+bool Result_cache::can_use(THD *thd) const {
+  if (m_shards == nullptr || !thd->stmt_arena->is_regular() ||
+      thd->in_sub_stmt ||
+      thd->locked_tables_mode != LTM_NONE ||
+      thd->temporary_tables != nullptr ||
+      thd->bind_parameter_values_count > 0 || !thd->is_classic_protocol() ||
+      thd->get_protocol()->type() != Protocol::PROTOCOL_TEXT ||
+      !thd->get_protocol()->has_client_capability(CLIENT_DEPRECATE_EOF) ||
+      thd->tx_isolation == ISO_READ_UNCOMMITTED)
+    return false;
+
+  if (thd->in_multi_stmt_transaction_mode())
+    return thd->tx_isolation == ISO_READ_COMMITTED &&
+           thd->result_cache_session.m_written_slots.empty();
+  return true;
+}
+
+std::shared_ptr<const Result_cache_entry> Result_cache::find(THD *thd) {
+  if (query_result_cache_size == 0 || !can_use(thd) ||
+      !is_single_select_query_text(thd->query()) ||
+      may_be_locking_read_text(thd->query()))
+    return nullptr;
+
+  const std::string key = result_cache_key(thd);
+  Result_cache_shard *shard = shard_for(std::hash<std::string>()(key));
+  std::shared_ptr<const Result_cache_entry> entry;
+  {
+    MUTEX_LOCK(guard, &shard->m_lock);
+    const auto it = shard->m_elements.find(key);
+    if (it == shard->m_elements.end()) return nullptr;
+
+    const Result_cache_entry &candidate = *it->second.m_entry;
+    /*
+      The SET_VAR hints of the query are not in effect yet. The key holds
+      the query text, so an entry stored while a hint enabled caching is
+      only found for a text with the same hint.
+    */
+    if (!thd->variables.query_result_cache && !candidate.m_enabled_by_query)
+      return nullptr;
+    bool valid = candidate.m_epoch == m_epoch.load();
+    for (const auto &table : candidate.m_tables) {
+      if (!valid) break;
+      valid = m_table_versions[table.m_slot].load() == table.m_version;
+    }
+    if (!valid) {
+      shard->erase(it);
+      return nullptr;
+    }
+    shard->m_lru.splice(shard->m_lru.begin(), shard->m_lru,
+                        it->second.m_lru_position);
+    entry = it->second.m_entry;
+  }
+  m_hits.fetch_add(1, std::memory_order_relaxed);
+  return entry;
+}
+
+bool Result_cache::send(THD *thd, const Result_cache_entry &entry) {
+  DBUG_TRACE;
+  Protocol_classic *protocol = thd->get_protocol_classic();
+  const uchar *pos = entry.m_packets.data();
+  const uchar *end = pos + entry.m_packets.size();
+  while (pos < end) {
+    const size_t length = uint4korr(pos);
+    pos += 4;
+    if (protocol->write(pos, length)) return true;
+    pos += length;
+  }
+  thd->current_found_rows = entry.m_row_count;
+  thd->set_sent_row_count(entry.m_row_count);
+  my_eof(thd);
+  return false;
+}
+
+void Result_cache::note_session_setting(THD *thd) {
+  thd->result_cache_session.m_session_enabled =
+      thd->variables.query_result_cache;
+}
+
+void Result_cache::start_capture(THD *thd) {
+  Result_cache_session &session = thd->result_cache_session;
+  assert(session.m_capture == nullptr);
+
+  const LEX *lex = thd->lex;
+  if (query_result_cache_size == 0 || !thd->variables.query_result_cache ||
+      lex->sql_command != SQLCOM_SELECT || lex->is_explain() ||
+      !lex->safe_to_cache_query || lex->uses_stored_routines() ||
+      !can_use(thd) || !is_single_select_query_text(thd->query()) ||
+      may_be_locking_read_text(thd->query()))
+    return;
+
+  /* Locking reads must take their row locks, they are never cached. */
+  for (const Table_ref *tr = lex->query_tables; tr != nullptr;
+       tr = tr->next_global) {
+    const thr_lock_type lock_type = tr->lock_descriptor().type;
+    if (lock_type == TL_READ_WITH_SHARED_LOCKS ||
+        lock_type >= TL_WRITE_ALLOW_WRITE)
+      return;
+  }
+
+  /* A single result set may take a quarter of a shard at most. */
+  const size_t max_size = query_result_cache_size / SHARDS / 4;
+  session.m_capture.reset(new (std::nothrow) Result_cache_capture(
+      max_size, m_write_sequence.load(), m_epoch.load()));
+  if (session.m_capture == nullptr) return;
+  session.m_capture->m_enabled_by_query = !session.m_session_enabled;
+  thd->get_protocol_classic()->set_result_capture(session.m_capture.get());
+}
+
+void Result_cache::finish_capture(THD *thd, bool error) {
+  Result_cache_session &session = thd->result_cache_session;
+  if (session.m_capture == nullptr) return;
+
+  thd->get_protocol_classic()->set_result_capture(nullptr);
+  const std::unique_ptr<Result_cache_capture> capture =
+      std::move(session.m_capture);
+
+  /*
+    Results with warnings are not cached, since serving them would not
+    reproduce the warnings.
+  */
+  if (error || thd->is_error() || thd->killed || capture->m_overflow ||
+      capture->m_packets.empty() ||
+      thd->get_stmt_da()->current_statement_cond_count() != 0)
+    return;
+
+  const std::shared_ptr<Result_cache_entry> entry =
+      std::make_shared<Result_cache_entry>();
+  for (Table_ref *tr = thd->lex->query_tables; tr != nullptr;
+       tr = tr->next_global) {
+    if (tr->is_derived() || tr->is_table_function()) continue;
+    if (tr->schema_table != nullptr) return;
+    if (tr->table != nullptr) {
+      if (tr->table->s->tmp_table != NO_TMP_TABLE) return;
+      /* Contents of these tables change without being written. */
+      const legacy_db_type db_type = tr->table->s->db_type()->db_type;
+      if (db_type == DB_TYPE_PERFORMANCE_SCHEMA ||
+          db_type == DB_TYPE_FEDERATED_DB)
+        return;
+    }
+    if (tr->db == nullptr || tr->table_name == nullptr) return;
+
+    const uint slot = table_version_slot(tr->db, tr->table_name);
+    if (std::any_of(entry->m_tables.begin(), entry->m_tables.end(),
+                    [slot](const Result_cache_entry::Table_version &table) {
+                      return table.m_slot == slot;
+                    }))
+      continue;
+    /*
+      A table changed while the statement was running, the result may or
+      may not include the change.
+    */
+    const ulonglong version = m_table_versions[slot].load();
+    if (version > capture->m_write_sequence) return;
+    entry->m_tables.push_back({slot, version});
+  }
+  if (m_epoch.load() != capture->m_epoch) return;
+
+  entry->m_epoch = capture->m_epoch;
+  entry->m_enabled_by_query = capture->m_enabled_by_query;
+  entry->m_row_count = thd->get_sent_row_count();
+  entry->m_packets = std::move(capture->m_packets);
+
+  std::string key = result_cache_key(thd);
+  const size_t size = entry->size() + key.size();
+  const size_t shard_capacity = query_result_cache_size / SHARDS;
+  if (size > shard_capacity) return;
+
+  Result_cache_shard *shard = shard_for(std::hash<std::string>()(key));
+  MUTEX_LOCK(guard, &shard->m_lock);
+  const auto it = shard->m_elements.find(key);
+  if (it != shard->m_elements.end()) shard->erase(it);
+  while (shard->m_size + size > shard_capacity)
+    shard->erase(shard->m_elements.find(shard->m_lru.back()));
+
+  shard->m_lru.push_front(key);
+  shard->m_elements.emplace(
+      std::move(key),
+      Result_cache_shard::Element{entry, shard->m_lru.begin(), size});
+  shard->m_size += size;
+  m_inserts.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Result_cache::advance_slot(uint slot) {
+  const ulonglong version = m_write_sequence.fetch_add(1) + 1;
+  ulonglong current = m_table_versions[slot].load();
+  while (current < version &&
+         !m_table_versions[slot].compare_exchange_weak(current, version)) {
+  }
+}
+
+void Result_cache::note_write_lock(THD *thd, const TABLE_SHARE *share) {
+  std::vector<uint> &slots = thd->result_cache_session.m_written_slots;
+  const uint slot = table_version_slot(share->db.str, share->table_name.str);
+  if (std::find(slots.begin(), slots.end(), slot) == slots.end())
+    slots.push_back(slot);
+}
+
+void Result_cache::invalidate_table(const char *db, const char *table_name) {
+  advance_slot(table_version_slot(db, table_name));
+}
+
+void Result_cache::end_transaction(THD *thd, bool committed) {
+  std::vector<uint> &slots = thd->result_cache_session.m_written_slots;
+  if (committed) {
+    for (const uint slot : slots) advance_slot(slot);
+  }
+  slots.clear();
+}
+
+void Result_cache::invalidate_all() { m_epoch.fetch_add(1); }
+
+int show_result_cache_hits(THD *, SHOW_VAR *var, char *buff) {
+  var->type = SHOW_LONGLONG;
+  var->value = buff;
+  *(reinterpret_cast<ulonglong *>(buff)) = result_cache.hits();
+  return 0;
+}
+
+int show_result_cache_inserts(THD *, SHOW_VAR *var, char *buff) {
+  var->type = SHOW_LONGLONG;
+  var->value = buff;
+  *(reinterpret_cast<ulonglong *>(buff)) = result_cache.inserts();
+  return 0;
+}
@@ -0,0 +1,207 @@
+/* Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef RESULT_CACHE_INCLUDED
+#define RESULT_CACHE_INCLUDED
+
+/**
+  @file sql/result_cache.h
+
+  Cache of result sets of read-only SELECT statements.
+
+  A statement is cached only when @@query_result_cache is enabled for it,
+  typically with a SET_VAR(query_result_cache=ON) hint, and
+  @@query_result_cache_size is non-zero. The result set is stored as the
+  text protocol packets sent to the client and is replayed when the same
+  query text is received again from the same account with the same session
+  settings, without parsing or executing the query.
+
+  Invalidation is based on table versions rather than on explicit lists of
+  dependent queries. Every base table hashes to one of a fixed number of
+  version slots. A slot is advanced when a table in it is write-unlocked at
+  the end of a statement, when a transaction that write-locked it commits,
+  and when its definition is removed from the table definition cache. A
+  cached result is valid while none of the slots of the tables it read have
+  moved, which means it is what a statement started now would see under
+  READ COMMITTED. Results are therefore only stored and served for
+  statements that get a fresh snapshot: autocommitted statements and
+  statements in READ COMMITTED transactions that have not written anything.
+*/
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "my_inttypes.h"
+#include "sql/malloc_allocator.h"
+
+class THD;
+class Result_cache_entry;
+class Result_cache_shard;
+struct SHOW_VAR;
+struct TABLE_SHARE;
+
+/// @@query_result_cache_size, total number of bytes the cache may use.
+extern ulonglong query_result_cache_size;
+
+/**
+  Result set packets captured while a statement sends them to the client.
+*/
+class Result_cache_capture {
+ public:
+  Result_cache_capture(size_t max_size, ulonglong write_sequence,
+                       ulonglong epoch);
+
+  /**
+    Append a copy of a packet sent to the client. Capturing stops for good
+    once the result set grows beyond the maximum entry size.
+  */
+  void add_packet(const uchar *data, size_t length);
+
+ private:
+  friend class Result_cache;
+
+  /// Packets, each one prefixed with its length in 4 bytes.
+  std::vector<uchar, Malloc_allocator<uchar>> m_packets;
+  size_t m_max_size;
+  bool m_overflow{false};
+  /// Value of the table version sequence when the statement started.
+  ulonglong m_write_sequence;
+  /// Value of the cache epoch when the statement started.
+  ulonglong m_epoch;
+  /// Caching was enabled by a SET_VAR hint of the statement.
+  bool m_enabled_by_query{false};
+};
+
+/**
+  Per session state of the result cache.
+*/
+class Result_cache_session {
+ private:
+  friend class Result_cache;
+
+  /// Version slots of the tables write-locked by the current transaction.
+  std::vector<uint> m_written_slots;
+  /// Result set captured for the current statement, if any.
+  std::unique_ptr<Result_cache_capture> m_capture;
+  /// @@query_result_cache before the SET_VAR hints of the statement.
+  bool m_session_enabled{false};
+};
+
+/**
+  The result cache, one instance for the server.
+
+  Entries are spread over a fixed number of shards by the hash of their
+  key, each shard having its own mutex and LRU list, so lookups from
+  different sessions rarely contend. Table versions are plain atomics.
+*/
+class Result_cache {
+ public:
+  static constexpr uint SHARDS = 16;
+  static constexpr uint TABLE_VERSION_SLOTS = 4096;
+
+  bool init();
+  void destroy();
+
+  /** Drop all entries, called when @@query_result_cache_size changes. */
+  void resize();
+
+  /**
+    Find a valid cached result for the current query of the session. This
+    is done before the query is parsed, so its SET_VAR hints are not in
+    effect yet: a result is served if @@query_result_cache is enabled for
+    the session, or if it was stored for a query text that enables it with
+    a hint. Locking reads are never served.
+
+    @returns the entry to send with send(), or nullptr.
+  */
+  std::shared_ptr<const Result_cache_entry> find(THD *thd);
+
+  /**
+    Send a cached result set to the client in place of executing the query.
+
+    @returns false on success, true if sending failed.
+  */
+  bool send(THD *thd, const Result_cache_entry &entry);
+
+  /**
+    Remember @@query_result_cache of the session, called before the SET_VAR
+    hints of the statement take effect.
+  */
+  void note_session_setting(THD *thd);
+
+  /**
+    Start capturing the result set of the current statement, if the
+    statement and the session are eligible. Called once the SET_VAR hints of
+    the statement are in effect. Locking reads are not captured.
+  */
+  void start_capture(THD *thd);
+
+  /** Stop capturing and store the result set if the statement succeeded. */
+  void finish_capture(THD *thd, bool error);
+
+  /** Remember that the current transaction write-locked a table. */
+  void note_write_lock(THD *thd, const TABLE_SHARE *share);
+
+  /** Advance the version of a table, its contents or definition changed. */
+  void invalidate_table(const char *db, const char *table_name);
+
+  /**
+    Advance the versions of the tables written by a transaction that ended.
+
+    @param thd        session of the transaction
+    @param committed  true if the changes became visible to other sessions
+  */
+  void end_transaction(THD *thd, bool committed);
+
+  /**
+    Invalidate all entries, used for changes that cannot be attributed to
+    tables, such as privilege changes.
+  */
+  void invalidate_all();
+
+  ulonglong hits() const { return m_hits.load(std::memory_order_relaxed); }
+  ulonglong inserts() const {
+    return m_inserts.load(std::memory_order_relaxed);
+  }
+
+ private:
+  bool can_use(THD *thd) const;
+  void advance_slot(uint slot);
+  Result_cache_shard *shard_for(size_t key_hash) const;
+
+  std::unique_ptr<Result_cache_shard[]> m_shards;
+  std::atomic<ulonglong> m_table_versions[TABLE_VERSION_SLOTS];
+  /// Source of table version numbers, increasing on every table change.
+  std::atomic<ulonglong> m_write_sequence{0};
+  std::atomic<ulonglong> m_epoch{0};
+  std::atomic<ulonglong> m_hits{0};
+  std::atomic<ulonglong> m_inserts{0};
+};
+
+extern Result_cache result_cache;
+
+int show_result_cache_hits(THD *thd, SHOW_VAR *var, char *buff);
+int show_result_cache_inserts(THD *thd, SHOW_VAR *var, char *buff);
+
+#endif /* RESULT_CACHE_INCLUDED */
@@ -84,10 +84,11 @@ class Rpl_applier_reader::Stage_controller {
 };
 
 Rpl_applier_reader::Rpl_applier_reader(Relay_log_info *rli)
-    : m_relaylog_file_reader(
-          opt_replica_sql_verify_checksum,
-          std::max(replica_max_allowed_packet,
-                   binlog_row_event_max_size + MAX_LOG_EVENT_HEADER)),
+    : m_max_event_size(std::max(replica_max_allowed_packet,
+                                binlog_row_event_max_size +
+                                    MAX_LOG_EVENT_HEADER)),
+      m_relaylog_file_reader(opt_replica_sql_verify_checksum,
+                             m_max_event_size),
       m_rli(rli) {}
 
 Rpl_applier_reader::~Rpl_applier_reader() { close(); }
@@ -232,7 +233,8 @@ Log_event *Rpl_applier_reader::read_next_event() {
   }
 
   m_rli->set_event_start_pos(m_relaylog_file_reader.position());
-  ev = m_relaylog_file_reader.read_event_object();
+  if (!m_reading_active_log || !read_event_from_memory(&ev))
+    ev = m_relaylog_file_reader.read_event_object();
   if (ev != nullptr) {
     m_rli->set_future_event_relay_log_pos(m_relaylog_file_reader.position());
     ev->future_event_relay_log_pos = m_rli->get_future_event_relay_log_pos();
@@ -282,6 +284,31 @@ bool Rpl_applier_reader::read_active_log_end_pos() {
   return false;
 }
 
+bool Rpl_applier_reader::read_event_from_memory(Log_event **ev) {
+  Binlog_event_cache *cache = m_rli->relay_log.get_relay_log_event_cache();
+  if (cache->capacity() == 0) return false;
+
+  auto *allocator = m_relaylog_file_reader.allocator();
+  uchar *data = nullptr;
+  uint32 length = 0;
+  my_off_t pos = m_relaylog_file_reader.position();
+  if (!cache->read_event(
+          m_rli->get_event_relay_log_name(), pos, m_max_event_size,
+          [allocator](size_t size) { return allocator->allocate(size); },
+          &data, &length)) {
+    if (data != nullptr) allocator->deallocate(data);
+    return false;
+  }
+
+  /* Only events the receiver has completely flushed can be applied. */
+  if (pos + length > m_log_end_pos) {
+    allocator->deallocate(data);
+    return false;
+  }
+  *ev = m_relaylog_file_reader.read_event_object(data, length);
+  return true;
+}
+
 Rotate_log_event *Rpl_applier_reader::generate_rotate_event() {
   DBUG_TRACE;
   Rotate_log_event *ev = nullptr;
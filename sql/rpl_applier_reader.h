@@ -85,6 +85,8 @@ class Rpl_applier_reader {
   Log_event *read_next_event();
 
  private:
+  /** Largest event accepted from the relay log. */
+  const unsigned int m_max_event_size;
   Relaylog_file_reader m_relaylog_file_reader;
   Relay_log_info *m_rli = nullptr;
   /** Stores the error message which is used internally */
@@ -128,6 +130,17 @@ class Rpl_applier_reader {
      @retval    true     The applier is behind the receiver.
   */
   bool read_active_log_end_pos();
+  /**
+     Take the next event of the active relay log from the copy the receiver
+     keeps in memory, instead of reading it from the relay log file.
+
+     @param[out] ev  The event, or nullptr if it could not be deserialized,
+                     in which case the reader has the error.
+
+     @retval    true     The event was in memory, the reader is moved past it.
+     @retval    false    The event must be read from the file.
+  */
+  bool read_event_from_memory(Log_event **ev);
   /**
      In the case receiver thread says master skipped some events, it will
      generate a Rotate_log_event for applier to advance executed master log
@@ -0,0 +1,240 @@
+/* Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "sql/rpl_binlog_event_cache.h"
+
+#include <string.h>
+#include <algorithm>
+
+#include "libbinlogevents/include/binlog_event.h"  // EVENT_LEN_OFFSET
+#include "m_string.h"                              // strmake
+#include "my_byteorder.h"
+#include "my_dbug.h"
+#include "my_sys.h"
+#include "mysql/components/services/bits/psi_bits.h"
+#include "mysql/psi/mysql_memory.h"
+#include "mysql/status_var.h"
+
+ulonglong binlog_dump_cache_size = 0;
+ulonglong relay_log_event_cache_size = 0;
+
+Binlog_event_cache binlog_event_cache;
+
+static PSI_rwlock_key key_rwlock_LOCK_binlog_event_cache;
+static PSI_rwlock_key key_rwlock_LOCK_relay_log_event_cache;
+static PSI_memory_key key_memory_binlog_event_cache;
+
+#ifdef HAVE_PSI_INTERFACE
+static PSI_rwlock_info binlog_event_cache_rwlocks[] = {
+    {&key_rwlock_LOCK_binlog_event_cache, "LOCK_binlog_event_cache",
+     PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
+    {&key_rwlock_LOCK_relay_log_event_cache, "LOCK_relay_log_event_cache", 0,
+     0, PSI_DOCUMENT_ME}};
+
+static PSI_memory_info binlog_event_cache_memory[] = {
+    {&key_memory_binlog_event_cache, "Binlog_event_cache",
+     PSI_FLAG_ONLY_GLOBAL_STAT, 0,
+     "Copy of the tail of the active binary or relay log, read by dump "
+     "threads and by the replication applier."}};
+
+static void init_binlog_event_cache_psi_keys() {
+  const char *category = "sql";
+  int count = static_cast<int>(array_elements(binlog_event_cache_rwlocks));
+  mysql_rwlock_register(category, binlog_event_cache_rwlocks, count);
+
+  count = static_cast<int>(array_elements(binlog_event_cache_memory));
+  mysql_memory_register(category, binlog_event_cache_memory, count);
+}
+#endif /* HAVE_PSI_INTERFACE */
+
+bool Binlog_event_cache::init(size_t size, bool for_relay_log) {
+#ifdef HAVE_PSI_INTERFACE
+  /* The binary log cache and the caches of relay logs share the keys. */
+  static const bool psi_keys_registered [[maybe_unused]] =
+      (init_binlog_event_cache_psi_keys(), true);
+#endif
+  mysql_rwlock_init(for_relay_log ? key_rwlock_LOCK_relay_log_event_cache
+                                  : key_rwlock_LOCK_binlog_event_cache,
+                    &m_lock);
+  m_inited = true;
+  resize(size);
+  return size != 0 && m_buffer == nullptr;
+}
+
+void Binlog_event_cache::destroy() {
+  if (!m_inited) return;
+  m_capacity.store(0);
+  my_free(m_buffer);
+  m_buffer = nullptr;
+  mysql_rwlock_destroy(&m_lock);
+  m_inited = false;
+}
+
+void Binlog_event_cache::resize(size_t size) {
+  if (!m_inited) return;
+
+  mysql_rwlock_wrlock(&m_lock);
+  my_free(m_buffer);
+  m_buffer = nullptr;
+  if (size > 0)
+    m_buffer = static_cast<uchar *>(
+        my_malloc(key_memory_binlog_event_cache, size, MYF(MY_WME)));
+  m_capacity.store(m_buffer != nullptr ? size : 0);
+  /*
+    Keep the file name, so that caching resumes with the next write to the
+    active file, but drop its content.
+  */
+  m_start.store(0, std::memory_order_relaxed);
+  m_end.store(0, std::memory_order_relaxed);
+  mysql_rwlock_unlock(&m_lock);
+}
+
+void Binlog_event_cache::reset(const char *log_name, my_off_t pos) {
+  /*
+    The name is recorded even while the cache is disabled, so that enabling
+    it takes effect on the active file.
+  */
+  if (!m_inited) return;
+
+  mysql_rwlock_wrlock(&m_lock);
+  strmake(m_log_name, log_name, sizeof(m_log_name) - 1);
+  m_start.store(pos, std::memory_order_relaxed);
+  m_end.store(pos, std::memory_order_relaxed);
+  mysql_rwlock_unlock(&m_lock);
+}
+
+void Binlog_event_cache::append(my_off_t pos, const uchar *data,
+                                my_off_t length) {
+  if (m_capacity.load(std::memory_order_relaxed) == 0) return;
+
+  /*
+    Appends are serialized by the lock of the log file they write to, so the
+    shared lock is enough: it only keeps the buffer and the file name from
+    changing. Readers are not held up while the bytes are copied, they check
+    afterwards that m_start did not pass what they copied.
+  */
+  mysql_rwlock_rdlock(&m_lock);
+  size_t capacity = m_capacity.load(std::memory_order_relaxed);
+  if (capacity > 0 && m_log_name[0] != '\0') {
+    my_off_t end = pos + length;
+    if (pos != m_end.load(std::memory_order_relaxed) || length >= capacity) {
+      /*
+        The stream is not contiguous, or the write does not fit. Start an
+        empty window after it, events before it are read from the file.
+      */
+      m_start.store(end, std::memory_order_relaxed);
+    } else {
+      /* Retire the bytes that are overwritten before writing over them. */
+      if (end - m_start.load(std::memory_order_relaxed) > capacity) {
+        m_start.store(end - capacity, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+      }
+      size_t offset = static_cast<size_t>(pos % capacity);
+      size_t first = std::min(static_cast<size_t>(length), capacity - offset);
+      memcpy(m_buffer + offset, data, first);
+      if (first < length) memcpy(m_buffer, data + first, length - first);
+    }
+    m_end.store(end, std::memory_order_release);
+  }
+  mysql_rwlock_unlock(&m_lock);
+}
+
+void Binlog_event_cache::invalidate() {
+  if (!m_inited) return;
+
+  mysql_rwlock_wrlock(&m_lock);
+  m_log_name[0] = '\0';
+  m_start.store(0, std::memory_order_relaxed);
+  m_end.store(0, std::memory_order_relaxed);
+  mysql_rwlock_unlock(&m_lock);
+}
+
+void Binlog_event_cache::copy_out(my_off_t pos, uchar *to,
+                                  size_t length) const {
+  size_t capacity = m_capacity.load(std::memory_order_relaxed);
+  size_t offset = static_cast<size_t>(pos % capacity);
+  size_t first = std::min(length, capacity - offset);
+  memcpy(to, m_buffer + offset, first);
+  if (first < length) memcpy(to + first, m_buffer, length - first);
+}
+
+bool Binlog_event_cache::read_event(const char *log_name, my_off_t pos,
+                                    size_t max_event_size,
+                                    const Allocator &allocator,
+                                    uchar **event_ptr, uint32 *event_len) {
+  DBUG_TRACE;
+  *event_ptr = nullptr;
+  if (m_capacity.load(std::memory_order_relaxed) == 0) return false;
+
+  bool found = false;
+  mysql_rwlock_rdlock(&m_lock);
+  my_off_t end = m_end.load(std::memory_order_acquire);
+  if (m_capacity.load(std::memory_order_relaxed) > 0 &&
+      pos >= m_start.load(std::memory_order_relaxed) &&
+      pos + LOG_EVENT_MINIMAL_HEADER_LEN <= end &&
+      strcmp(log_name, m_log_name) == 0) {
+    uchar header[LOG_EVENT_MINIMAL_HEADER_LEN];
+    copy_out(pos, header, sizeof(header));
+    uint32 length = uint4korr(header + EVENT_LEN_OFFSET);
+
+    /*
+      Only complete events are served. Anything that does not look like an
+      event is left to the file reader, which reports it properly.
+    */
+    if (length >= LOG_EVENT_MINIMAL_HEADER_LEN && length <= max_event_size &&
+        pos + length <= end) {
+      *event_ptr = allocator(length);
+      if (*event_ptr != nullptr) {
+        copy_out(pos, *event_ptr, length);
+        /*
+          An append may have overwritten the bytes while they were copied,
+          in which case it moved m_start past them first.
+        */
+        std::atomic_thread_fence(std::memory_order_acquire);
+        found = pos >= m_start.load(std::memory_order_relaxed);
+        *event_len = length;
+      }
+    }
+  }
+  mysql_rwlock_unlock(&m_lock);
+
+  if (found)
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+  else
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+  return found;
+}
+
+int show_binlog_dump_cache_hits(THD *, SHOW_VAR *var, char *buff) {
+  var->type = SHOW_LONGLONG;
+  var->value = buff;
+  *(reinterpret_cast<ulonglong *>(buff)) = binlog_event_cache.hits();
+  return 0;
+}
+
+int show_binlog_dump_cache_misses(THD *, SHOW_VAR *var, char *buff) {
+  var->type = SHOW_LONGLONG;
+  var->value = buff;
+  *(reinterpret_cast<ulonglong *>(buff)) = binlog_event_cache.misses();
+  return 0;
+}
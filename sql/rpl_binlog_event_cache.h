@@ -0,0 +1,177 @@
+/* Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef RPL_BINLOG_EVENT_CACHE_INCLUDED
+#define RPL_BINLOG_EVENT_CACHE_INCLUDED
+
+/**
+  @file sql/rpl_binlog_event_cache.h
+
+  In-memory copy of the tail of the active binary log, shared by all dump
+  threads.
+
+  Every byte written to the active binary log file by the flush stage is
+  also appended to a fixed size ring buffer, keyed by its position in the
+  plain (unencrypted) event stream. Dump threads that are close to the end
+  of the binary log find the events they are about to send in the ring and
+  copy them straight into their network packet, instead of each one
+  reading, decrypting and checksumming the same bytes from the file. A dump
+  thread that has fallen behind the window kept in memory, or that is
+  reading an older file, reads from the file as before.
+
+  The cache is disabled when @@binlog_dump_cache_size is 0, which is the
+  default.
+
+  Each replication channel also has a cache of its active relay log, sized
+  by @@relay_log_event_cache_size, so that the applier reads the events the
+  receiver just queued from memory rather than from the relay log file.
+*/
+
+#include <stddef.h>
+#include <atomic>
+#include <functional>
+
+#include "my_inttypes.h"
+#include "my_io.h"  // FN_REFLEN
+#include "mysql/psi/mysql_rwlock.h"
+
+class THD;
+struct SHOW_VAR;
+
+/// @@binlog_dump_cache_size, the number of bytes kept in memory.
+extern ulonglong binlog_dump_cache_size;
+/// @@relay_log_event_cache_size, the size of the cache of each relay log.
+extern ulonglong relay_log_event_cache_size;
+
+class Binlog_event_cache {
+ public:
+  /**
+    Callback used to get memory for an event found in the cache. It returns
+    a buffer of the given size, or nullptr if the memory cannot be
+    allocated.
+  */
+  using Allocator = std::function<uchar *(size_t)>;
+
+  /**
+    @param size           number of bytes kept in memory, 0 disables the
+                          cache
+    @param for_relay_log  the cache belongs to a relay log, of which there is
+                          one per channel, rather than to the binary log
+    @retval true  the memory could not be allocated
+  */
+  bool init(size_t size, bool for_relay_log = false);
+  void destroy();
+
+  /** Reallocate the ring to the given number of bytes, emptying it. */
+  void resize(size_t size);
+
+  size_t capacity() const {
+    return m_capacity.load(std::memory_order_relaxed);
+  }
+
+  /**
+    Start caching a new binary log file, called when the file is created.
+
+    @param log_name  name of the binary log file
+    @param pos       position of the first byte that will be written
+  */
+  void reset(const char *log_name, my_off_t pos);
+
+  /**
+    Append bytes just written to the active binary log file. A write that
+    does not follow the previous one empties the window first. Appends must
+    be serialized by the caller, as writes to the file are; they do not
+    exclude readers.
+
+    @param pos     position of data in the plain binary log stream
+    @param data    bytes written
+    @param length  number of bytes written
+  */
+  void append(my_off_t pos, const uchar *data, my_off_t length);
+
+  /**
+    Forget the cached bytes, called when the active file is closed, or
+    changed in place by update or truncate.
+  */
+  void invalidate();
+
+  /**
+    Copy the event starting at the given position out of the cache.
+
+    @param      log_name        binary log file the event is read from
+    @param      pos             position of the event in the file
+    @param      max_event_size  largest event the caller accepts
+    @param      allocator       provides the memory to copy the event to
+    @param[out] event_ptr       the copy of the event. If the event was
+                                overwritten while it was copied, this is
+                                the memory obtained from the allocator
+                                even though false is returned, otherwise
+                                nullptr on failure.
+    @param[out] event_len       length of the event
+
+    @retval true   the whole event was found and copied
+    @retval false  the event is not cached, or memory could not be
+                   allocated; the caller should read it from the file
+  */
+  bool read_event(const char *log_name, my_off_t pos, size_t max_event_size,
+                  const Allocator &allocator, uchar **event_ptr,
+                  uint32 *event_len);
+
+  ulonglong hits() const { return m_hits.load(std::memory_order_relaxed); }
+  ulonglong misses() const {
+    return m_misses.load(std::memory_order_relaxed);
+  }
+
+ private:
+  /** Copy bytes of the window out of the ring, handling wrap around. */
+  void copy_out(my_off_t pos, uchar *to, size_t length) const;
+
+  /**
+    Taken exclusively to change the buffer or the file name, and shared by
+    appends and reads, which synchronize through m_start and m_end.
+  */
+  mysql_rwlock_t m_lock;
+  bool m_inited{false};
+  /// Size of m_buffer, readable without the lock to skip a disabled cache.
+  std::atomic<size_t> m_capacity{0};
+  uchar *m_buffer{nullptr};
+  /// Binary log file the window belongs to, empty if none.
+  char m_log_name[FN_REFLEN]{};
+  /**
+    The window of cached positions is [m_start, m_end). An append moves
+    m_start past the bytes it overwrites before it writes, and publishes
+    m_end after, so a reader checks m_start again once it copied an event.
+  */
+  std::atomic<my_off_t> m_start{0};
+  std::atomic<my_off_t> m_end{0};
+
+  std::atomic<ulonglong> m_hits{0};
+  std::atomic<ulonglong> m_misses{0};
+};
+
+extern Binlog_event_cache binlog_event_cache;
+
+int show_binlog_dump_cache_hits(THD *thd, SHOW_VAR *var, char *buff);
+int show_binlog_dump_cache_misses(THD *thd, SHOW_VAR *var, char *buff);
+
+#endif /* RPL_BINLOG_EVENT_CACHE_INCLUDED */
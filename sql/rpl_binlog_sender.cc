@@ -47,6 +47,7 @@
 #include "mysql/components/services/log_builtins.h"
 #include "mysql/psi/mysql_file.h"
 #include "mysql/psi/mysql_mutex.h"
+#include "mysql_com_server.h"  // my_net_write_file
 #include "scope_guard.h"
 #include "sql/binlog_reader.h"
 #include "sql/debug_sync.h"  // debug_sync_set_action
@@ -57,7 +58,8 @@
 #include "sql/mysqld.h"  // global_system_variables ...
 #include "sql/protocol.h"
 #include "sql/protocol_classic.h"
-#include "sql/rpl_constants.h"  // BINLOG_DUMP_NON_BLOCK
+#include "sql/rpl_binlog_event_cache.h"  // binlog_event_cache
+#include "sql/rpl_constants.h"           // BINLOG_DUMP_NON_BLOCK
 #include "sql/rpl_gtid.h"
 #include "sql/rpl_handler.h"    // RUN_HOOK
 #include "sql/rpl_reporting.h"  // MAX_SLAVE_ERRMSG
@@ -67,6 +69,7 @@
 #include "sql_string.h"
 #include "typelib.h"
 #include "unsafe_string_append.h"
+#include "violite.h"  // vio_can_sendfile
 
 #ifndef NDEBUG
 static uint binlog_dump_count = 0;
@@ -249,6 +252,7 @@ Binlog_sender::Binlog_sender(THD *thd, const char *start_file,
       m_last_pos(0),
       m_half_buffer_size_req_counter(0),
       m_new_shrink_size(PACKET_MIN_SIZE),
+      m_max_event_size(0),
       m_flag(flag),
       m_observe_transmission(false),
       m_transmit_started(false),
@@ -381,10 +385,9 @@ void Binlog_sender::run() {
 
   init();
 
-  unsigned int max_event_size =
-      std::max(m_thd->variables.max_allowed_packet,
-               binlog_row_event_max_size + MAX_LOG_EVENT_HEADER);
-  File_reader reader(opt_source_verify_checksum, max_event_size);
+  m_max_event_size = std::max(m_thd->variables.max_allowed_packet,
+                              binlog_row_event_max_size + MAX_LOG_EVENT_HEADER);
+  File_reader reader(opt_source_verify_checksum, m_max_event_size);
   my_off_t start_pos = m_start_pos;
   const char *log_file = m_linfo.log_file_name;
   bool is_index_file_reopened_on_binlog_disable = false;
@@ -570,6 +573,7 @@ int Binlog_sender::send_events(File_reader &reader, my_off_t end_pos) {
   my_off_t log_pos = reader.position();
   my_off_t exclude_group_end_pos = 0;
   bool in_exclude_group = false;
+  const File sendfile_file = get_sendfile_file(reader);
 
   while (likely(log_pos < end_pos) || end_pos == 0) {
     uchar *event_ptr = nullptr;
@@ -577,6 +581,17 @@ int Binlog_sender::send_events(File_reader &reader, my_off_t end_pos) {
 
     if (unlikely(thd->killed)) return 1;
 
+    if (sendfile_file >= 0 && !in_exclude_group) {
+      bool sent = false;
+      if (unlikely(send_event_from_file(reader, sendfile_file, end_pos,
+                                        &exclude_group_end_pos, &sent)))
+        return 1;
+      if (sent) {
+        log_pos = reader.position();
+        continue;
+      }
+    }
+
     if (unlikely(read_event(reader, &event_ptr, &event_len))) return 1;
 
     if (event_ptr == nullptr) {
@@ -1225,7 +1240,21 @@ inline int Binlog_sender::read_event(File_reader &reader, uchar **event_ptr,
     assert(!debug_sync_set_action(m_thd, STRING_WITH_LEN(act)));
   };);
 
-  if (reader.read_event_data(event_ptr, event_len)) {
+  /*
+    Dump threads close to the end of the active binary log take the event
+    from the copy kept in memory. It was written by this server, so its
+    checksum is not verified again.
+  */
+  my_off_t event_pos = reader.next_event_pos();
+  if (binlog_event_cache.read_event(
+          m_linfo.log_file_name, event_pos, m_max_event_size,
+          [&reader](size_t size) { return reader.allocator()->allocate(size); },
+          event_ptr, event_len)) {
+    if (reader.seek(event_pos + *event_len)) {
+      set_fatal_error(log_read_error_msg(Binlog_read_error::SYSTEM_IO));
+      return 1;
+    }
+  } else if (reader.read_event_data(event_ptr, event_len)) {
     if (reader.get_error_type() == Binlog_read_error::READ_EOF) {
       *event_ptr = nullptr;
       *event_len = 0;
@@ -1254,6 +1283,92 @@ inline int Binlog_sender::read_event(File_reader &reader, uchar **event_ptr,
   return 0;
 }
 
+File Binlog_sender::get_sendfile_file(File_reader &reader) {
+  NET *net = m_thd->get_protocol_classic()->get_net();
+  if (binlog_dump_sendfile_threshold == 0 || m_observe_transmission ||
+      opt_source_verify_checksum || net->compress || net->vio == nullptr ||
+      !vio_can_sendfile(net->vio))
+    return -1;
+  return reader.ifile()->plain_file();
+}
+
+int Binlog_sender::send_event_from_file(File_reader &reader, File file,
+                                        my_off_t end_pos,
+                                        my_off_t *exclude_group_end_pos,
+                                        bool *sent) {
+  DBUG_TRACE;
+  *sent = false;
+
+  /*
+    The header is read through the reader, which buffers the file. If the
+    event is not sent from here, read_event() goes on after the header. A
+    header that is not completely written yet is left to read_event().
+  */
+  my_off_t event_pos = reader.position();
+  my_off_t file_end = end_pos != 0 ? end_pos : reader.ifile()->length();
+  if (event_pos + LOG_EVENT_MINIMAL_HEADER_LEN > file_end) return 0;
+
+  const uchar *header = nullptr;
+  if (reader.read_event_header(&header)) {
+    set_fatal_error(log_read_error_msg(reader.get_error_type()));
+    return 1;
+  }
+
+  Log_event_type event_type = (Log_event_type)header[EVENT_TYPE_OFFSET];
+  uint32 event_len = uint4korr(header + EVENT_LEN_OFFSET);
+  my_off_t next_pos = event_pos + event_len;
+
+  /*
+    Small events are cheaper to copy than to send with their own system
+    call. Gtid events are inspected by skip_event(), and incomplete events
+    are left to read_event().
+  */
+  if (event_len < binlog_dump_sendfile_threshold ||
+      (m_exclude_gtid != nullptr &&
+       event_type == binary_log::GTID_LOG_EVENT) ||
+      next_pos > file_end)
+    return 0;
+
+  if (unlikely(check_event_type(event_type, m_linfo.log_file_name,
+                                event_pos)))
+    return 1;
+
+  Sender_context_guard ctx_guard(*this, event_type);
+  set_last_pos(next_pos);
+#ifndef NDEBUG
+  if (check_event_count()) return 1;
+#endif
+
+  /*
+    A heartbeat is required before sending a event, If some events are
+    skipped.
+  */
+  if (*exclude_group_end_pos) {
+    if (send_heartbeat_event(*exclude_group_end_pos)) return 1;
+    *exclude_group_end_pos = 0;
+  }
+
+  DBUG_PRINT("info", ("Sending event of type %s from file",
+                      Log_event::get_type_str(event_type)));
+  /* The event follows the byte marking the packet as an OK packet. */
+  static const uchar ok_packet_header = 0;
+  NET *net = m_thd->get_protocol_classic()->get_net();
+  if (DBUG_EVALUATE_IF("simulate_send_error", true,
+                       my_net_write_file(net, &ok_packet_header, 1, file,
+                                         event_pos, event_len))) {
+    set_unknown_error("Failed on my_net_write_file()");
+    return 1;
+  }
+  m_last_event_sent_ts = now_in_nanosecs();
+
+  if (reader.seek(next_pos)) {
+    set_fatal_error(log_read_error_msg(Binlog_read_error::SYSTEM_IO));
+    return 1;
+  }
+  *sent = true;
+  return 0;
+}
+
 int Binlog_sender::send_heartbeat_event_v1(my_off_t log_pos) {
   DBUG_TRACE;
   const char *filename = m_linfo.log_file_name;
@@ -135,6 +135,12 @@ class Binlog_sender {
    */
   size_t m_new_shrink_size;
 
+  /*
+    Largest event accepted from the binary log, the limit given to the file
+    reader and applied to events taken from binlog_event_cache.
+  */
+  unsigned int m_max_event_size;
+
   /*
      Max size of the buffer is 4GB (UINT_MAX32). It is UINT_MAX32 since the
      threshold is set to (@c Log_event::read_log_event):
@@ -336,6 +342,39 @@ class Binlog_sender {
      @retval 1 Fail
   */
   int read_event(File_reader &reader, uchar **event_ptr, uint32 *event_len);
+  /**
+    Get the file events can be sent from with send_event_from_file().
+
+    @param[in] reader  File_reader of the binlog file.
+
+    @retval -1  Events have to be read and sent through the packet buffer,
+                because the binlog file is encrypted, the connection uses
+                TLS or compression, checksums are verified, a plugin
+                observes the transmission, or the feature is disabled.
+    @retval >=0 The descriptor of the binlog file.
+  */
+  File get_sendfile_file(File_reader &reader);
+  /**
+    Send the next event straight from the binlog file with sendfile(2),
+    without reading it into the packet buffer. Only events of at least
+    @@binlog_dump_sendfile_threshold bytes which are not needed to decide
+    which events to skip are sent this way. The header is read through the
+    reader, so for other events read_event() goes on after it.
+
+    @param[in]     reader   File_reader of the binlog file.
+    @param[in]     file     The value returned by get_sendfile_file().
+    @param[in]     end_pos  Only the events before end_pos are sent, 0 if
+                            the whole file can be sent.
+    @param[in,out] exclude_group_end_pos  End of the events skipped before
+                            this one, a heartbeat is sent for it first.
+    @param[out]    sent     true if the event was sent, false if it has to
+                            be read with read_event().
+
+    @retval 0 Succeed
+    @retval 1 Fail
+  */
+  int send_event_from_file(File_reader &reader, File file, my_off_t end_pos,
+                           my_off_t *exclude_group_end_pos, bool *sent);
   /**
     Check if it is allowed to send this event type.
 
@@ -903,6 +903,32 @@ int channel_queue_packet(const char *channel, const char *buf,
   return result;
 }
 
+int channel_add_transaction_dependencies(const char *channel, long long gno,
+                                         long long sequence_number,
+                                         long long barrier,
+                                         const long long *parents,
+                                         unsigned long count) {
+  DBUG_TRACE;
+  int result = 1;
+
+  channel_map.rdlock();
+
+  Master_info *mi = channel_map.get_mi(channel);
+
+  if (mi == nullptr) {
+    channel_map.unlock();
+    return RPL_CHANNEL_SERVICE_CHANNEL_DOES_NOT_EXISTS_ERROR;
+  }
+
+  /* Only the multi-threaded applier takes the entries. */
+  if (mi->rli != nullptr && mi->rli->opt_replica_parallel_workers > 0)
+    result = mi->rli->transaction_dependencies.add(gno, sequence_number,
+                                                   barrier, parents, count);
+  channel_map.unlock();
+
+  return result;
+}
+
 int channel_wait_until_apply_queue_applied(const char *channel,
                                            double timeout) {
   DBUG_TRACE;
@@ -309,6 +309,29 @@ int channel_add_executed_gtids_to_received_gtids(const char *channel);
 int channel_queue_packet(const char *channel, const char *buf,
                          unsigned long len, bool io_buffered);
 
+/**
+  Registers the dependencies of a transaction before it is queued, so
+  that the multi-threaded applier of the channel waits for them instead
+  of its commit parent.
+
+  @param channel          the channel name
+  @param gno              the GNO of the transaction
+  @param sequence_number  the sequence_number of its Gtid_log_event
+  @param barrier          the transaction it waits for along with all
+                          earlier ones
+  @param parents          the later transactions it waits for
+  @param count            the number of parents
+
+  @return the operation status
+    @retval 0      OK
+    @retval != 0   Not registered, the commit parent is used
+*/
+int channel_add_transaction_dependencies(const char *channel, long long gno,
+                                         long long sequence_number,
+                                         long long barrier,
+                                         const long long *parents,
+                                         unsigned long count);
+
 /**
   Checks if all the queued transactions were executed.
 
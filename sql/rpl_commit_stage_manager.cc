@@ -22,8 +22,10 @@
    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
 
 #include <algorithm>
+#include <cmath>
 
 #include "mutex_lock.h"            // MUTEX_LOCK
+#include "my_systime.h"            // my_micro_time
 #include "mysql/psi/mysql_cond.h"  // mysql_cond_timedwait
 #include "sql/binlog.h"
 #include "sql/debug_sync.h"                              // DEBUG_SYNC
@@ -395,6 +397,44 @@ void Commit_stage_manager::wait_count_or_timeout(ulong count, long usec,
   }
 }
 
+void Commit_stage_manager::adaptive_sync_delay(ulong *count, long *usec) {
+  *count = 0;
+  *usec = 0;
+
+  /* Transactions expected to arrive in one microsecond. */
+  double arrival_rate =
+      m_sync_interval > 0 ? m_sync_group_size / m_sync_interval : 0;
+  if (arrival_rate * m_sync_time >= 1) {
+    double delay = m_sync_time;
+    if (opt_binlog_group_commit_sync_delay > 0)
+      delay = std::min(delay,
+                       static_cast<double>(opt_binlog_group_commit_sync_delay));
+    *usec = static_cast<long>(delay);
+    if (*usec > 0)
+      *count = static_cast<ulong>(m_queue[SYNC_STAGE].get_size()) +
+               static_cast<ulong>(std::ceil(arrival_rate * delay));
+    if (opt_binlog_group_commit_sync_no_delay_count > 0)
+      *count = std::min(*count, opt_binlog_group_commit_sync_no_delay_count);
+  }
+  m_adaptive_sync_delay.store(*usec, std::memory_order_relaxed);
+}
+
+void Commit_stage_manager::update_sync_statistics(ulong group_size,
+                                                  ulonglong sync_usec) {
+  /* Weight of a new sample in the moving averages. */
+  constexpr double weight = 0.125;
+  ulonglong now = my_micro_time();
+
+  m_sync_time += (sync_usec - m_sync_time) * weight;
+  m_sync_group_size += (group_size - m_sync_group_size) * weight;
+  if (m_last_sync_end > 0 && now > m_last_sync_end)
+    m_sync_interval += ((now - m_last_sync_end) - m_sync_interval) * weight;
+  m_last_sync_end = now;
+
+  m_average_sync_time.store(static_cast<ulonglong>(m_sync_time),
+                            std::memory_order_relaxed);
+}
+
 THD *Commit_stage_manager::fetch_queue_acquire_lock(StageID stage) {
   DBUG_PRINT("debug", ("Fetching queue for stage %d", stage));
   return m_queue[stage].fetch_and_empty_acquire_lock();
@@ -304,6 +304,43 @@ class Commit_stage_manager {
    */
   void wait_count_or_timeout(ulong count, long usec, StageID stage);
 
+  /**
+    Computes the wait before syncing the binary log when
+    @@binlog_group_commit_sync_delay_adaptive is enabled.
+
+    There is no wait while less than one transaction is expected to
+    arrive during a sync. Otherwise the leader waits for about the
+    time a sync takes, bounded by @@binlog_group_commit_sync_delay if it
+    is set, or until the transactions expected in that time joined the
+    sync queue.
+
+    Called by the leader of the sync stage, with the arguments of
+    wait_count_or_timeout.
+
+    @param[out] count  the number of sessions to wait for
+    @param[out] usec   the number of microseconds to wait
+  */
+  void adaptive_sync_delay(ulong *count, long *usec);
+
+  /**
+    Accounts a sync of the binary log, for the adaptive sync delay.
+    Called by the leader of the sync stage.
+
+    @param group_size  the number of sessions in the synced group
+    @param sync_usec   the number of microseconds the sync took
+  */
+  void update_sync_statistics(ulong group_size, ulonglong sync_usec);
+
+  /** The last wait computed by adaptive_sync_delay(), in microseconds. */
+  ulonglong get_adaptive_sync_delay() const {
+    return m_adaptive_sync_delay.load(std::memory_order_relaxed);
+  }
+
+  /** The average time a sync of the binary log takes, in microseconds. */
+  ulonglong get_average_sync_time() const {
+    return m_average_sync_time.load(std::memory_order_relaxed);
+  }
+
   /**
     The function is called after follower thread are processed by leader,
     to unblock follower threads.
@@ -385,6 +422,23 @@ class Commit_stage_manager {
   /** Mutex used for the stage level locks */
   mysql_mutex_t m_queue_lock[STAGE_COUNTER - 1];
 
+  /*
+    Statistics of the sync stage, only changed by its leader while holding
+    LOCK_sync. Moving averages in microseconds.
+  */
+  /** Time a sync takes. */
+  double m_sync_time{0};
+  /** Time between the end of two syncs. */
+  double m_sync_interval{0};
+  /** Number of sessions synced together. */
+  double m_sync_group_size{0};
+  /** When the previous sync ended. */
+  ulonglong m_last_sync_end{0};
+
+  /** Copies of the statistics above, for status variables. */
+  std::atomic<ulonglong> m_adaptive_sync_delay{0};
+  std::atomic<ulonglong> m_average_sync_time{0};
+
 #ifndef NDEBUG
   /** Save pointer to leader thread which is used later to awake leader */
   THD *leader_thd;
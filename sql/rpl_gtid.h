@@ -1527,8 +1527,9 @@ class Gtid_set {
     assert(sidno > 0);
     assert(gno > 0);
     assert(gno < GNO_END);
-    Interval_iterator ivit(this, sidno);
     Free_intervals_lock lock(this);
+    if (append_gno_interval(sidno, gno, gno + 1, &lock)) return;
+    Interval_iterator ivit(this, sidno);
     add_gno_interval(&ivit, gno, gno + 1, &lock);
     return;
   }
@@ -2002,10 +2003,16 @@ class Gtid_set {
    public:
     /// Create this Interval_iterator.
     Interval_iterator(Gtid_set *gtid_set, rpl_sidno sidno)
-        : Interval_iterator_base<Gtid_set *, Interval *>(gtid_set, sidno) {}
+        : Interval_iterator_base<Gtid_set *, Interval *>(gtid_set, sidno),
+          m_last(&gtid_set->m_last_intervals[sidno - 1]) {}
     /// Destroy this Interval_iterator.
     Interval_iterator(Gtid_set *gtid_set)
         : Interval_iterator_base<Gtid_set *, Interval *>(gtid_set) {}
+    /// Advance current_elem one step.
+    inline void next() {
+      m_prev = get();
+      Interval_iterator_base<Gtid_set *, Interval *>::next();
+    }
 
    private:
     /**
@@ -2017,6 +2024,7 @@ class Gtid_set {
     inline void insert(Interval *iv) {
       iv->next = *p;
       set(iv);
+      if (m_last != nullptr && iv->next == nullptr) *m_last = iv;
     }
     /// Remove current_elem.
     inline void remove(Gtid_set *gtid_set) {
@@ -2024,7 +2032,15 @@ class Gtid_set {
       Interval *next = (*p)->next;
       gtid_set->put_free_interval(*p);
       set(next);
+      if (m_last != nullptr && next == nullptr) *m_last = m_prev;
     }
+    /**
+      The last interval of the list, kept up to date by insert and
+      remove. nullptr when iterating over the free intervals.
+    */
+    Interval **m_last{nullptr};
+    /// The element before current_elem, nullptr if it is the first one.
+    Interval *m_prev{nullptr};
     /**
       Only Gtid_set is allowed to use set/insert/remove.
 
@@ -2282,6 +2298,22 @@ class Gtid_set {
   */
   void remove_gno_interval(Interval_iterator *ivitp, rpl_gno start, rpl_gno end,
                            Free_intervals_lock *lock);
+  /**
+    Adds the interval (start, end) to the given SIDNO if it does not
+    start before the end of the last interval of the SIDNO, which is
+    done without walking the list. This is the common case of GNOs
+    being generated in increasing order.
+
+    @param sidno The SIDNO, which must exist in the Gtid_set.
+    @param start The first GNO in the interval.
+    @param end The first GNO after the interval.
+    @param lock Taken if an interval has to be allocated.
+    @retval true The interval was added.
+    @retval false The interval starts before the end of the set; the
+    caller has to use add_gno_interval.
+  */
+  bool append_gno_interval(rpl_sidno sidno, rpl_gno start, rpl_gno end,
+                           Free_intervals_lock *lock);
   /**
     Adds a list of intervals to the given SIDNO.
 
@@ -2332,6 +2364,12 @@ class Gtid_set {
     intervals of SIDNO N+1.
   */
   Prealloced_array<Interval *, 8> m_intervals;
+  /**
+    Array where the N'th element points to the last interval of SIDNO
+    N+1, or is nullptr if there is none. It lets GTIDs generated in
+    increasing order be added, and looked up, without walking the list.
+  */
+  Prealloced_array<Interval *, 8> m_last_intervals;
   /// Linked list of free intervals.
   Interval *free_intervals;
   /// Linked list of chunks.
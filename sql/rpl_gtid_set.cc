@@ -85,7 +85,8 @@ const Gtid_set::String_format Gtid_set::commented_string_format = {
 Gtid_set::Gtid_set(Sid_map *_sid_map, Checkable_rwlock *_sid_lock)
     : sid_lock(_sid_lock),
       sid_map(_sid_map),
-      m_intervals(key_memory_Gtid_set_Interval_chunk) {
+      m_intervals(key_memory_Gtid_set_Interval_chunk),
+      m_last_intervals(key_memory_Gtid_set_Interval_chunk) {
   init();
 }
 
@@ -93,7 +94,8 @@ Gtid_set::Gtid_set(Sid_map *_sid_map, const char *text,
                    enum_return_status *status, Checkable_rwlock *_sid_lock)
     : sid_lock(_sid_lock),
       sid_map(_sid_map),
-      m_intervals(key_memory_Gtid_set_Interval_chunk) {
+      m_intervals(key_memory_Gtid_set_Interval_chunk),
+      m_last_intervals(key_memory_Gtid_set_Interval_chunk) {
   assert(_sid_map != nullptr);
   init();
   *status = add_gtid_text(text);
@@ -101,6 +103,7 @@ Gtid_set::Gtid_set(Sid_map *_sid_map, const char *text,
 
 void Gtid_set::claim_memory_ownership(bool claim) {
   m_intervals.claim_memory_ownership(claim);
+  m_last_intervals.claim_memory_ownership(claim);
 
   Interval_chunk *chunk = chunks;
   while (chunk != nullptr) {
@@ -174,7 +177,8 @@ enum_return_status Gtid_set::ensure_sidno(rpl_sidno sidno) {
     }
     Interval *null_p = nullptr;
     for (rpl_sidno i = max_sidno; i < sidno; i++)
-      if (m_intervals.push_back(null_p)) goto error;
+      if (m_intervals.push_back(null_p) || m_last_intervals.push_back(null_p))
+        goto error;
     if (sid_lock != nullptr) {
       if (!is_wrlock) {
         sid_lock->unlock();
@@ -292,6 +296,7 @@ void Gtid_set::clear() {
       free_ivit.set(iv);
       // clear the pointer to the head of this list
       ivit.set(nullptr);
+      m_last_intervals[sidno - 1] = nullptr;
     }
   }
 }
@@ -305,6 +310,7 @@ void Gtid_set::clear_set_and_sid_map() {
     Sid_map->get_max_sidno().
   */
   m_intervals.clear();
+  m_last_intervals.clear();
   sid_map->clear();
   assert(get_max_sidno() == sid_map->get_max_sidno());
 }
@@ -358,6 +364,35 @@ void Gtid_set::add_gno_interval(Interval_iterator *ivitp, rpl_gno start,
   *ivitp = ivit;
 }
 
+bool Gtid_set::append_gno_interval(rpl_sidno sidno, rpl_gno start,
+                                   rpl_gno end, Free_intervals_lock *lock) {
+  assert(sidno >= 1 && sidno <= get_max_sidno());
+  assert(start > 0);
+  assert(start < end);
+  Interval *last = m_last_intervals[sidno - 1];
+  assert(last != nullptr || m_intervals[sidno - 1] == nullptr);
+  if (last != nullptr && start < last->end) return false;
+
+  has_cached_string_length = false;
+  cached_string_length = 0;
+  if (last != nullptr && start == last->end) {
+    last->end = end;
+    return true;
+  }
+  Interval *new_iv;
+  lock->lock_if_not_locked();
+  get_free_interval(&new_iv);
+  new_iv->start = start;
+  new_iv->end = end;
+  new_iv->next = nullptr;
+  if (last == nullptr)
+    m_intervals[sidno - 1] = new_iv;
+  else
+    last->next = new_iv;
+  m_last_intervals[sidno - 1] = new_iv;
+  return true;
+}
+
 void Gtid_set::remove_gno_interval(Interval_iterator *ivitp, rpl_gno start,
                                    rpl_gno end, Free_intervals_lock *lock) {
   DBUG_TRACE;
@@ -627,7 +662,8 @@ void Gtid_set::add_gno_intervals(rpl_sidno sidno,
   const Interval *other_iv;
   Interval_iterator ivit(this, sidno);
   while ((other_iv = other_ivit.get()) != nullptr) {
-    add_gno_interval(&ivit, other_iv->start, other_iv->end, lock);
+    if (!append_gno_interval(sidno, other_iv->start, other_iv->end, lock))
+      add_gno_interval(&ivit, other_iv->start, other_iv->end, lock);
     other_ivit.next();
   }
 }
@@ -720,6 +756,10 @@ bool Gtid_set::contains_gtid(rpl_sidno sidno, rpl_gno gno) const {
   if (sidno > get_max_sidno()) return false;
   assert(sidno >= 1);
   assert(gno >= 1);
+  // Lookups are mostly for recent GTIDs, in or after the last interval.
+  const Interval *last = m_last_intervals[sidno - 1];
+  if (last == nullptr || gno >= last->end) return false;
+  if (gno >= last->start) return true;
   Const_interval_iterator ivit(this, sidno);
   const Interval *iv;
   while ((iv = ivit.get()) != nullptr) {
@@ -740,13 +780,8 @@ rpl_gno Gtid_set::get_last_gno(rpl_sidno sidno) const {
 
   if (sidno > get_max_sidno()) return gno;
 
-  Const_interval_iterator ivit(this, sidno);
-  const Gtid_set::Interval *iv = ivit.get();
-  while (iv != nullptr) {
-    gno = iv->end - 1;
-    ivit.next();
-    iv = ivit.get();
-  }
+  const Gtid_set::Interval *last = m_last_intervals[sidno - 1];
+  if (last != nullptr) gno = last->end - 1;
 
   return gno;
 }
@@ -1038,6 +1073,26 @@ bool Gtid_set::is_interval_subset(Const_interval_iterator *sub,
   return true;
 }
 
+/**
+  Compare the sets of one SIDNO by their bounds only.
+
+  @retval 1 sub is a subset of super
+  @retval 0 sub is not a subset of super
+  @retval -1 the intervals have to be compared
+*/
+static int is_interval_subset_by_bounds(const Gtid_set::Interval *sub_first,
+                                        const Gtid_set::Interval *sub_last,
+                                        const Gtid_set::Interval *super_first,
+                                        const Gtid_set::Interval *super_last) {
+  if (sub_first == nullptr) return 1;
+  if (super_first == nullptr) return 0;
+  if (sub_first->start < super_first->start || sub_last->end > super_last->end)
+    return 0;
+  // The first interval of super covers all of sub, e.g. a gapless history.
+  if (super_first->end >= sub_last->end) return 1;
+  return -1;
+}
+
 bool Gtid_set::is_subset_for_sid(const Gtid_set *super,
                                  rpl_sidno superset_sidno,
                                  rpl_sidno subset_sidno) const {
@@ -1071,6 +1126,10 @@ bool Gtid_set::is_subset_for_sid(const Gtid_set *super,
   */
   Const_interval_iterator subset_ivit(this, subset_sidno);
   Const_interval_iterator superset_ivit(super, superset_sidno);
+  int by_bounds = is_interval_subset_by_bounds(
+      subset_ivit.get(), m_last_intervals[subset_sidno - 1],
+      superset_ivit.get(), super->m_last_intervals[superset_sidno - 1]);
+  if (by_bounds >= 0) return by_bounds == 1;
   if (!is_interval_subset(&subset_ivit, &superset_ivit)) return false;
 
   return true;
@@ -1109,7 +1168,12 @@ bool Gtid_set::is_subset(const Gtid_set *super) const {
       // Check if all GNOs in this Gtid_set for sidno exist in other
       // Gtid_set for super_
       Const_interval_iterator super_ivit(super, super_sidno);
-      if (!is_interval_subset(&ivit, &super_ivit)) return false;
+      int by_bounds = is_interval_subset_by_bounds(
+          iv, m_last_intervals[sidno - 1], super_ivit.get(),
+          super->m_last_intervals[super_sidno - 1]);
+      if (by_bounds == 0) return false;
+      if (by_bounds < 0 && !is_interval_subset(&ivit, &super_ivit))
+        return false;
     }
   }
 
@@ -0,0 +1,88 @@
+/* Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "sql/rpl_mta_dependencies.h"
+
+#include "my_dbug.h"
+#include "sql/mysqld.h"  // key_mutex_mta_transaction_dependencies
+
+Mta_transaction_dependencies::Mta_transaction_dependencies() {
+  mysql_mutex_init(key_mutex_mta_transaction_dependencies, &m_lock,
+                   MY_MUTEX_INIT_FAST);
+}
+
+Mta_transaction_dependencies::~Mta_transaction_dependencies() {
+  mysql_mutex_destroy(&m_lock);
+}
+
+bool Mta_transaction_dependencies::add(rpl_gno gno, longlong sequence_number,
+                                       longlong barrier,
+                                       const longlong *parents, size_t count) {
+  DBUG_TRACE;
+  if (count > MTS_MAX_GROUP_PARENTS) return true;
+
+  Transaction transaction;
+  transaction.gno = gno;
+  transaction.barrier = barrier;
+  transaction.parents.assign(parents, parents + count);
+
+  mysql_mutex_lock(&m_lock);
+  /*
+    Entries are only left behind by transactions the applier never
+    scheduled, e.g. when its relay log was purged.
+  */
+  bool full = m_transactions.size() >= MAX_TRANSACTIONS;
+  if (!full) m_transactions[sequence_number] = std::move(transaction);
+  mysql_mutex_unlock(&m_lock);
+  return full;
+}
+
+bool Mta_transaction_dependencies::take(longlong sequence_number, rpl_gno gno,
+                                        Transaction *transaction) {
+  bool found = false;
+
+  mysql_mutex_lock(&m_lock);
+  if (m_transactions.empty()) {
+    mysql_mutex_unlock(&m_lock);
+    return false;
+  }
+  auto it = m_transactions.find(sequence_number);
+  /* Sequence numbers restart when the certifier is reset. */
+  if (it != m_transactions.end() && it->second.gno == gno) {
+    *transaction = std::move(it->second);
+    found = true;
+  }
+  m_transactions.erase(m_transactions.begin(),
+                       m_transactions.upper_bound(sequence_number));
+  mysql_mutex_unlock(&m_lock);
+
+  DBUG_PRINT("info", ("sequence_number %lld, dependencies found %d",
+                      sequence_number, found));
+  return found;
+}
+
+void Mta_transaction_dependencies::clear() {
+  mysql_mutex_lock(&m_lock);
+  m_transactions.clear();
+  mysql_mutex_unlock(&m_lock);
+}
@@ -0,0 +1,114 @@
+/* Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef RPL_MTA_DEPENDENCIES_INCLUDED
+#define RPL_MTA_DEPENDENCIES_INCLUDED
+
+/**
+  @file sql/rpl_mta_dependencies.h
+
+  Transaction dependencies handed to the LOGICAL_CLOCK multi-threaded
+  applier of a channel by the component that queues its relay log.
+
+  The commit parent of a Gtid_log_event is a single logical timestamp:
+  a transaction waits until every transaction up to it committed. The
+  group replication certifier knows the exact transactions a remote
+  transaction conflicts with, i.e. the last transactions that changed
+  each row of its write set, and the commit parent it computes is only
+  the newest of them. Before it queues the transaction to its applier
+  channel it registers those parents here, together with the barrier
+  every transaction depends on (the last DDL, or anything else that was
+  applied alone).
+
+  When the coordinator schedules the transaction it takes its entry, and
+  the worker then waits until the barrier is below the low water mark
+  and each parent either is below it too or committed. Transactions
+  without an entry, or whose entry does not match the event, use the
+  commit parent of the event, which is never earlier than the entry's.
+*/
+
+#include <map>
+#include <vector>
+
+#include "my_inttypes.h"
+#include "mysql/psi/mysql_mutex.h"
+#include "sql/rpl_gtid.h"  // rpl_gno
+
+/** Parents a transaction may wait for, with more it uses its commit parent. */
+#define MTS_MAX_GROUP_PARENTS 16
+
+class Mta_transaction_dependencies {
+ public:
+  /** Entries kept, further ones are dropped until entries are taken. */
+  static const size_t MAX_TRANSACTIONS = 65536;
+
+  struct Transaction {
+    /// GNO of the transaction, to match the Gtid_log_event.
+    rpl_gno gno{0};
+    /// Every transaction up to this one must have committed.
+    longlong barrier{0};
+    /// Transactions after the barrier that must have committed.
+    std::vector<longlong> parents;
+  };
+
+  Mta_transaction_dependencies();
+  ~Mta_transaction_dependencies();
+
+  /**
+    Register the dependencies of a transaction about to be queued.
+
+    @param gno              GNO of the transaction
+    @param sequence_number  sequence number of its Gtid_log_event
+    @param barrier          transaction every transaction waits for
+    @param parents          later transactions it conflicts with
+    @param count            number of parents
+
+    @retval false  registered
+    @retval true   not registered, the commit parent will be used
+  */
+  bool add(rpl_gno gno, longlong sequence_number, longlong barrier,
+           const longlong *parents, size_t count);
+
+  /**
+    Remove and return the entry of a transaction being scheduled. Entries
+    of older transactions are forgotten.
+
+    @param      sequence_number  sequence number of the Gtid_log_event
+    @param      gno              GNO of the Gtid_log_event
+    @param[out] transaction      the entry
+
+    @retval true   found
+    @retval false  no entry for this transaction
+  */
+  bool take(longlong sequence_number, rpl_gno gno, Transaction *transaction);
+
+  /** Forget all entries. */
+  void clear();
+
+ private:
+  mysql_mutex_t m_lock;
+  /// Entries by sequence number.
+  std::map<longlong, Transaction> m_transactions;
+};
+
+#endif /* RPL_MTA_DEPENDENCIES_INCLUDED */
@@ -386,6 +386,57 @@ Mts_submode_logical_clock::Mts_submode_logical_clock() {
   min_waited_timestamp = SEQ_UNINIT;
   last_committed = SEQ_UNINIT;
   sequence_number = SEQ_UNINIT;
+  clear_committed_groups();
+}
+
+void Mts_submode_logical_clock::clear_committed_groups() {
+  for (auto &committed : committed_groups)
+    committed.store(SEQ_UNINIT, std::memory_order_relaxed);
+}
+
+bool Mts_submode_logical_clock::parents_committed(Slave_job_group *ptr_g,
+                                                  longlong lwm) {
+  uint left = 0;
+  for (uint i = 0; i < ptr_g->parent_count; i++) {
+    longlong parent = ptr_g->parents[i];
+    if (clock_leq(parent, lwm) ||
+        committed_groups[parent % COMMITTED_GROUPS_SIZE].load(
+            std::memory_order_acquire) == parent)
+      continue;
+    ptr_g->parents[left++] = parent;
+  }
+  ptr_g->parent_count = left;
+  return left == 0;
+}
+
+longlong Mts_submode_logical_clock::set_group_parents(
+    Relay_log_info *rli, Log_event *ev, Slave_job_group *ptr_group,
+    longlong lwm_estimate) {
+  Mta_transaction_dependencies::Transaction transaction;
+
+  if (ev->get_type_code() != binary_log::GTID_LOG_EVENT ||
+      !rli->transaction_dependencies.take(
+          sequence_number, static_cast<Gtid_log_event *>(ev)->get_gno(),
+          &transaction))
+    return last_committed;
+
+  /*
+    The entry is only trusted when it agrees with the commit parent of the
+    event, which is the newest transaction it depends on.
+  */
+  longlong newest = transaction.barrier;
+  for (longlong parent : transaction.parents) {
+    if (parent >= sequence_number) return last_committed;
+    if (parent > newest) newest = parent;
+  }
+  if (newest != last_committed) return last_committed;
+
+  for (longlong parent : transaction.parents) {
+    if (clock_leq(parent, lwm_estimate) || parent <= transaction.barrier)
+      continue;
+    ptr_group->parents[ptr_group->parent_count++] = parent;
+  }
+  return transaction.barrier;
 }
 
 /**
@@ -702,8 +753,14 @@ int Mts_submode_logical_clock::schedule_next_event(Relay_log_info *rli,
   */
   if (!is_new_group) {
     longlong lwm_estimate = estimate_lwm_timestamp();
+    /*
+      The group waits for its commit parent, or for the exact transactions
+      it depends on when they were registered for it.
+    */
+    longlong commit_parent =
+        set_group_parents(rli, ev, ptr_group, lwm_estimate);
 
-    if (!clock_leq(last_committed, lwm_estimate) &&
+    if (!clock_leq(commit_parent, lwm_estimate) &&
         rli->gaq->assigned_group_index != rli->gaq->entry) {
       /*
         "Unlikely" branch.
@@ -714,7 +771,7 @@ int Mts_submode_logical_clock::schedule_next_event(Relay_log_info *rli,
         At awakening set min_waited_timestamp to commit_parent in the
         subsequent GAQ index (could be NIL).
       */
-      if (wait_for_last_committed_trx(rli, last_committed)) {
+      if (wait_for_last_committed_trx(rli, commit_parent)) {
         /*
           MTS was waiting for a dependent transaction to finish but either it
           has failed or the applier was requested to stop. In any case, this
@@ -737,6 +794,17 @@ int Mts_submode_logical_clock::schedule_next_event(Relay_log_info *rli,
       assert(!clock_leq(sequence_number, estimate_lwm_timestamp()));
     }
 
+    if (ptr_group->parent_count > 0) {
+      if (rli->gaq->assigned_group_index == rli->gaq->entry) {
+        /* Every earlier group committed already. */
+        ptr_group->parent_count = 0;
+      } else if (!rli->is_wait_last_commited) {
+        /* The worker checks the parents while it waits. */
+        rli->is_wait_last_commited = true;
+        rli->last_commmitted_seq = commit_parent;
+      }
+    }
+
     delegated_jobs++;
 
     assert(!force_new_group);
@@ -763,6 +831,8 @@ int Mts_submode_logical_clock::schedule_next_event(Relay_log_info *rli,
       the instant last lwm timestamp must reset when force flag is up.
     */
     rli->gaq->lwm.sequence_number = last_lwm_timestamp = SEQ_UNINIT;
+    /* Sequence numbers may restart with this group. */
+    clear_committed_groups();
     delegated_jobs = 1;
     jobs_done = 0;
     force_new_group = false;
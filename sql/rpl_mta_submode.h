@@ -34,11 +34,13 @@
 #include "my_inttypes.h"
 #include "my_thread_local.h"   // my_thread_id
 #include "prealloced_array.h"  // Prealloced_array
+#include "sql/rpl_mta_writeset.h"  // Mta_writeset_tracker
 
 class Log_event;
 class Query_log_event;
 class Relay_log_info;
 class Slave_worker;
+struct Slave_job_group;
 class THD;
 struct TABLE;
 
@@ -137,6 +139,15 @@ class Mts_submode_logical_clock : public Mts_submode {
   ulong last_lwm_index;
   longlong last_committed;
   longlong sequence_number;
+  /* Row level dependencies computed by the replica */
+  Mta_writeset_tracker writeset_tracker;
+  /*
+    Sequence numbers of the recently committed groups, at their value
+    modulo the size. Workers check them for the parents of their group
+    that are above the low-water-mark.
+  */
+  static const size_t COMMITTED_GROUPS_SIZE = 1024;
+  std::atomic<longlong> committed_groups[COMMITTED_GROUPS_SIZE];
 
  public:
   uint jobs_done;
@@ -161,6 +172,16 @@ class Mts_submode_logical_clock : public Mts_submode {
  protected:
   std::pair<uint, my_thread_id> get_server_and_thread_id(TABLE *table);
   Slave_worker *get_free_worker(Relay_log_info *rli);
+  /**
+    Take the registered dependencies of the group being scheduled, and set
+    the parents the group has to wait for.
+
+    @return the transaction the group waits for along with all earlier
+            ones, which is its commit parent when nothing was registered
+  */
+  longlong set_group_parents(Relay_log_info *rli, Log_event *ev,
+                             Slave_job_group *ptr_group,
+                             longlong lwm_estimate);
 
  public:
   Mts_submode_logical_clock();
@@ -181,6 +202,25 @@ class Mts_submode_logical_clock : public Mts_submode {
     Withdraw the delegated_job increased by the group.
   */
   void withdraw_delegated_job() { delegated_jobs--; }
+  Mta_writeset_tracker *get_writeset_tracker() { return &writeset_tracker; }
+  /** Called by a Worker when its group committed. */
+  void note_group_committed(longlong sequence_number) {
+    if (sequence_number > 0)
+      committed_groups[sequence_number % COMMITTED_GROUPS_SIZE].store(
+          sequence_number, std::memory_order_release);
+  }
+  /**
+    Tell if the parents of a group committed. Parents are removed from
+    the group as they are found committed.
+
+    @param ptr_g  the group, owned by the calling Worker
+    @param lwm    estimate of the low-water-mark
+
+    @return true when no parent is left
+  */
+  bool parents_committed(Slave_job_group *ptr_g, longlong lwm);
+  /** Forget the committed groups, when none is running. */
+  void clear_committed_groups();
   int wait_for_workers_to_finish(Relay_log_info *rli,
                                  Slave_worker *ignore = nullptr) override;
   bool wait_for_last_committed_trx(Relay_log_info *rli, 
@@ -0,0 +1,403 @@
+/* Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "sql/rpl_mta_writeset.h"
+
+#include <string.h>
+
+#include "lex_string.h"
+#include "m_ctype.h"
+#include "m_string.h"  // strmake
+#include "my_bitmap.h"
+#include "my_dbug.h"
+#include "my_xxhash.h"  // IWYU pragma: keep
+#include "mysql_com.h"  // NAME_LEN
+#include "sql/binlog.h"  // mysql_bin_log
+#include "sql/field.h"
+#include "sql/key.h"
+#include "sql/log_event.h"
+#include "sql/mysqld.h"  // key_mutex_mta_writeset_layouts
+#include "sql/rpl_filter.h"
+#include "sql/rpl_record.h"  // Bit_reader
+#include "sql/rpl_rli.h"
+#include "sql/rpl_rli_pdb.h"  // Slave_worker
+#include "sql/rpl_utility.h"  // table_def
+#include "sql/table.h"
+
+bool opt_replica_writeset_dependency_tracking = false;
+
+std::atomic<ulonglong> mta_writeset_table_generation{0};
+
+/**
+  Check that equal values of a column have equal images in row events,
+  so that comparing the images tells whether two rows have the same key.
+*/
+static bool is_key_type_comparable_as_image(const Field *field) {
+  switch (field->real_type()) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+    case MYSQL_TYPE_YEAR:
+    case MYSQL_TYPE_NEWDATE:
+    case MYSQL_TYPE_TIME2:
+    case MYSQL_TYPE_DATETIME2:
+    case MYSQL_TYPE_TIMESTAMP2:
+      return true;
+    case MYSQL_TYPE_STRING:
+    case MYSQL_TYPE_VARCHAR:
+      /* Collations other than binary may consider different strings equal. */
+      return field->charset() == &my_charset_bin;
+    default:
+      return false;
+  }
+}
+
+Mta_writeset_tracker::Mta_writeset_tracker() {
+  mysql_mutex_init(key_mutex_mta_writeset_layouts, &m_layouts_lock,
+                   MY_MUTEX_INIT_FAST);
+}
+
+Mta_writeset_tracker::~Mta_writeset_tracker() {
+  mysql_mutex_destroy(&m_layouts_lock);
+}
+
+std::string Mta_writeset_tracker::make_key(const char *db,
+                                           const char *table_name) {
+  std::string key(db);
+  key.push_back('\0');
+  key.append(table_name);
+  return key;
+}
+
+void Mta_writeset_tracker::clear_history(longlong sequence_number) {
+  m_history.clear();
+  m_history_start = sequence_number;
+}
+
+void Mta_writeset_tracker::start_group(longlong sequence_number,
+                                       longlong last_committed) {
+  m_in_group =
+      opt_replica_writeset_dependency_tracking && sequence_number != 0;
+  if (!m_in_group) return;
+
+  if (sequence_number <= m_last_sequence_number) {
+    /*
+      The source started a new binary log, which restarts the clock. The
+      scheduler waited for all workers, so nothing in the history is
+      pending, and the layouts were recorded by finished groups.
+    */
+    clear_history(0);
+    mysql_mutex_lock(&m_layouts_lock);
+    for (auto &entry : m_layouts) entry.second.sequence_number = 0;
+    m_layout_min_sequence_number = 0;
+    mysql_mutex_unlock(&m_layouts_lock);
+  }
+  m_last_sequence_number = sequence_number;
+
+  m_sequence_number = sequence_number;
+  m_last_committed = last_committed;
+  m_group_usable = true;
+  m_group_hashes.clear();
+  m_group_tables.clear();
+}
+
+void Mta_writeset_tracker::add_event(Relay_log_info *rli, Log_event *ev) {
+  Log_event_type type = ev->get_type_code();
+
+  if (type == binary_log::GTID_LOG_EVENT ||
+      type == binary_log::ANONYMOUS_GTID_LOG_EVENT) {
+    auto *gtid_ev = static_cast<Gtid_log_event *>(ev);
+    start_group(gtid_ev->sequence_number, gtid_ev->last_committed);
+    return;
+  }
+  if (!m_in_group) return;
+
+  if (m_group_usable) {
+    switch (type) {
+      case binary_log::QUERY_EVENT: {
+        auto *query_ev = static_cast<Query_log_event *>(ev);
+        if (query_ev->starts_group() || query_ev->ends_group()) break;
+        m_group_usable = false;
+        if (query_ev->is_query_prefix_match(STRING_WITH_LEN("XA ")) ||
+            query_ev->is_query_prefix_match(STRING_WITH_LEN("SAVEPOINT")))
+          break;
+        /*
+          Anything else may change table definitions, key layouts recorded
+          so far can't be trusted by the groups that follow.
+        */
+        mysql_mutex_lock(&m_layouts_lock);
+        m_layouts.clear();
+        m_layout_min_sequence_number = m_sequence_number;
+        mysql_mutex_unlock(&m_layouts_lock);
+        break;
+      }
+      case binary_log::TABLE_MAP_EVENT:
+        add_table_map(rli, static_cast<Table_map_log_event *>(ev));
+        break;
+      case binary_log::WRITE_ROWS_EVENT:
+      case binary_log::UPDATE_ROWS_EVENT:
+      case binary_log::DELETE_ROWS_EVENT:
+      case binary_log::WRITE_ROWS_EVENT_V1:
+      case binary_log::UPDATE_ROWS_EVENT_V1:
+      case binary_log::DELETE_ROWS_EVENT_V1:
+        if (!add_rows(static_cast<Rows_log_event *>(ev)))
+          m_group_usable = false;
+        break;
+      case binary_log::XID_EVENT:
+      case binary_log::ROWS_QUERY_LOG_EVENT:
+        break;
+      default:
+        /*
+          Statement context (user variables, rand, auto increment),
+          partial JSON updates, compressed transactions and anything
+          else whose effect is not described by its rows.
+        */
+        m_group_usable = false;
+        break;
+    }
+  }
+
+  if (rli->mts_group_status == Relay_log_info::MTS_END_GROUP) end_group(rli);
+}
+
+void Mta_writeset_tracker::add_table_map(Relay_log_info *rli,
+                                         Table_map_log_event *ev) {
+  char db[NAME_LEN + 1];
+  char table_name[NAME_LEN + 1];
+  strmake(db, ev->get_db_name(), NAME_LEN);
+  strmake(table_name, ev->get_table_name(), NAME_LEN);
+
+  /* Name the table like the worker that applies the event does. */
+  if (lower_case_table_names) {
+    my_casedn_str(system_charset_info, db);
+    my_casedn_str(system_charset_info, table_name);
+  }
+  if (rli->rpl_filter != nullptr) {
+    size_t length;
+    const char *rewritten = rli->rpl_filter->get_rewrite_db(db, &length);
+    if (rewritten != db) strmake(db, rewritten, NAME_LEN);
+  }
+
+  Group_table &table = m_group_tables[ev->get_table_id().id()];
+  table.key = make_key(db, table_name);
+  table.def.reset(ev->create_table_def());
+}
+
+bool Mta_writeset_tracker::add_rows(Rows_log_event *ev) {
+  auto it = m_group_tables.find(ev->get_table_id().id());
+  if (it == m_group_tables.end() || it->second.def == nullptr) return false;
+  const Group_table &table = it->second;
+
+  Table_layout layout;
+  ulonglong generation =
+      mta_writeset_table_generation.load(std::memory_order_relaxed);
+  mysql_mutex_lock(&m_layouts_lock);
+  auto layout_it = m_layouts.find(table.key);
+  bool found = layout_it != m_layouts.end() && layout_it->second.usable &&
+               layout_it->second.generation == generation &&
+               layout_it->second.sequence_number >=
+                   m_layout_min_sequence_number;
+  if (found) layout = layout_it->second;
+  mysql_mutex_unlock(&m_layouts_lock);
+  if (!found) return false;
+
+  /*
+    The event must describe the same columns as the replica table, with
+    key columns of the same type.
+  */
+  const table_def *def = table.def.get();
+  if (def->size() != layout.column_count || ev->get_width() != def->size())
+    return false;
+  for (size_t i = 0; i < layout.key_columns.size(); i++)
+    if (def->type(layout.key_columns[i]) != layout.key_types[i]) return false;
+
+  const uchar *ptr = ev->get_rows_buf();
+  const uchar *end = ev->get_rows_end();
+  if (ptr == nullptr || ptr >= end) return false;
+
+  bool is_update =
+      ev->get_general_type_code() == binary_log::UPDATE_ROWS_EVENT;
+  while (ptr < end) {
+    if (!add_row_image(table, layout, ev, false, &ptr)) return false;
+    if (is_update && !add_row_image(table, layout, ev, true, &ptr))
+      return false;
+  }
+  return true;
+}
+
+bool Mta_writeset_tracker::add_row_image(const Group_table &table,
+                                         const Table_layout &layout,
+                                         const Rows_log_event *ev,
+                                         bool after_image,
+                                         const uchar **ptr) {
+  const table_def *def = table.def.get();
+  const MY_BITMAP *cols = after_image ? ev->get_cols_ai() : ev->get_cols();
+  const uchar *end = ev->get_rows_end();
+  const uchar *value = *ptr;
+
+  size_t key_parts = layout.key_columns.size();
+  const uchar *key_values[MAX_REF_PARTS];
+  size_t key_lengths[MAX_REF_PARTS];
+  size_t found = 0;
+
+  size_t null_bytes = (bitmap_bits_set(cols) + 7) / 8;
+  if (null_bytes > static_cast<size_t>(end - value)) return false;
+  Bit_reader null_bits(value);
+  value += null_bytes;
+
+  for (uint col = 0; col < def->size(); col++) {
+    if (!bitmap_is_set(cols, col)) continue;
+    bool is_null = null_bits.get();
+
+    size_t length = 0;
+    if (!is_null) {
+      if (value >= end) return false;
+      length = def->calc_field_size(col, value);
+      if (length > static_cast<size_t>(end - value)) return false;
+    }
+
+    for (size_t part = 0; part < key_parts; part++) {
+      if (layout.key_columns[part] != col) continue;
+      if (is_null) return false;
+      key_values[part] = value;
+      key_lengths[part] = length;
+      found++;
+    }
+    value += length;
+  }
+  *ptr = value;
+
+  /* An after image without key columns keeps the key of the before image. */
+  if (after_image && found == 0) return true;
+  if (found != key_parts) return false;
+
+  m_row_key.assign(table.key);
+  for (size_t part = 0; part < key_parts; part++) {
+    char length_buf[4];
+    int4store(length_buf, static_cast<uint32>(key_lengths[part]));
+    m_row_key.append(length_buf, sizeof(length_buf));
+    m_row_key.append(pointer_cast<const char *>(key_values[part]),
+                     key_lengths[part]);
+  }
+  m_group_hashes.push_back(MY_XXH64(m_row_key.data(), m_row_key.size(), 0));
+  return true;
+}
+
+void Mta_writeset_tracker::end_group(Relay_log_info *rli) {
+  DBUG_TRACE;
+  m_in_group = false;
+  m_group_tables.clear();
+
+  if (!m_group_usable) {
+    /* Transactions that follow depend on this one and on all before it. */
+    clear_history(m_sequence_number);
+    m_group_hashes.clear();
+    return;
+  }
+
+  longlong parent = m_history_start;
+  for (uint64 hash : m_group_hashes) {
+    auto it = m_history.find(hash);
+    if (it != m_history.end() && it->second > parent) parent = it->second;
+  }
+
+  ulong max_history_size =
+      mysql_bin_log.m_dependency_tracker.get_writeset()->m_opt_max_history_size;
+  if (m_history.size() + m_group_hashes.size() > max_history_size)
+    clear_history(m_sequence_number);
+  else
+    for (uint64 hash : m_group_hashes) m_history[hash] = m_sequence_number;
+  m_group_hashes.clear();
+
+  /*
+    The worker of the group polls the parent it was given, copied from the
+    coordinator for every event of the group, so lowering it here lets the
+    worker start before the source commit parent committed.
+  */
+  if (parent < m_last_committed && rli->is_wait_last_commited &&
+      parent < rli->last_commmitted_seq) {
+    DBUG_PRINT("info", ("sequence_number %lld, last_committed %lld relaxed "
+                        "to %lld",
+                        m_sequence_number, m_last_committed, parent));
+    rli->last_commmitted_seq = parent;
+  }
+}
+
+void Mta_writeset_tracker::note_table(const Relay_log_info *rli,
+                                      const Rows_log_event *ev,
+                                      const TABLE *table) {
+  if (!opt_replica_writeset_dependency_tracking) return;
+
+  const auto *worker = static_cast<const Slave_worker *>(rli);
+  longlong sequence_number =
+      worker->c_rli->gaq->get_job_group(ev->mts_group_idx)->sequence_number;
+  const TABLE_SHARE *share = table->s;
+  std::string key = make_key(share->db.str, share->table_name.str);
+  ulonglong generation =
+      mta_writeset_table_generation.load(std::memory_order_relaxed);
+
+  mysql_mutex_lock(&m_layouts_lock);
+  auto it = m_layouts.find(key);
+  bool known = sequence_number < m_layout_min_sequence_number ||
+               (it != m_layouts.end() && it->second.generation == generation);
+  mysql_mutex_unlock(&m_layouts_lock);
+  if (known) return;
+
+  Table_layout layout;
+  layout.column_count = share->fields;
+  layout.sequence_number = sequence_number;
+  layout.generation = generation;
+
+  /*
+    Rows conflict only through their primary key when there is no other
+    unique key, and no foreign key that makes a change depend on, or
+    cascade to, other rows.
+  */
+  uint primary_key = share->primary_key;
+  layout.usable = primary_key != MAX_KEY && share->foreign_keys == 0 &&
+                  share->foreign_key_parents == 0;
+  for (uint key_nr = 0; layout.usable && key_nr < share->keys; key_nr++)
+    if (key_nr != primary_key && (table->key_info[key_nr].flags & HA_NOSAME))
+      layout.usable = false;
+
+  if (layout.usable) {
+    const KEY &key_info = table->key_info[primary_key];
+    for (uint part = 0; part < key_info.user_defined_key_parts; part++) {
+      const KEY_PART_INFO &key_part = key_info.key_part[part];
+      if ((key_part.key_part_flag & HA_PART_KEY_SEG) ||
+          !is_key_type_comparable_as_image(key_part.field)) {
+        layout.usable = false;
+        break;
+      }
+      layout.key_columns.push_back(key_part.field->field_index());
+      layout.key_types.push_back(key_part.field->real_type());
+    }
+  }
+
+  mysql_mutex_lock(&m_layouts_lock);
+  if (sequence_number >= m_layout_min_sequence_number)
+    m_layouts[key] = std::move(layout);
+  mysql_mutex_unlock(&m_layouts_lock);
+}
@@ -0,0 +1,179 @@
+/* Copyright (c) 2024, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is designed to work with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have either included with
+   the program or referenced in the documentation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef RPL_MTA_WRITESET_INCLUDED
+#define RPL_MTA_WRITESET_INCLUDED
+
+/**
+  @file sql/rpl_mta_writeset.h
+
+  Row level dependency tracking for the LOGICAL_CLOCK multi-threaded
+  applier.
+
+  The commit parent recorded by the source is a safe bound, but with
+  COMMIT_ORDER dependency tracking, or when the source committed few
+  transactions together, it serializes transactions that touch different
+  rows. When @@replica_writeset_dependency_tracking is enabled the
+  coordinator decodes the primary key of every row changed by a
+  transaction from its row events, and keeps, like the source's WRITESET
+  tracker, the sequence number of the last transaction that changed each
+  key. A transaction whose keys were last changed by transactions older
+  than its source commit parent is allowed to start as soon as those
+  transactions committed.
+
+  Only the wait of the worker is relaxed: the result is never later than
+  the commit parent sent by the source, and commit order is still
+  enforced by @@replica_preserve_commit_order. Transactions that cannot be
+  described by their row keys (DDL, statement based events, compressed
+  transactions, tables without a usable primary key, ...) use the source
+  commit parent and start a new history, so later transactions depend on
+  them.
+
+  The coordinator does not open tables. The primary key layout of a table
+  is recorded by the workers from the replica's table definition the first
+  time they apply a row event for it, so the tracking takes effect after
+  a table was written once.
+*/
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "my_inttypes.h"
+#include "mysql/psi/mysql_mutex.h"
+
+class Log_event;
+class Relay_log_info;
+class Rows_log_event;
+class Table_map_log_event;
+struct TABLE;
+class table_def;
+
+/// @@replica_writeset_dependency_tracking
+extern bool opt_replica_writeset_dependency_tracking;
+
+/**
+  Incremented whenever a table definition may have changed on the server.
+  Key layouts recorded before the last change are not used.
+*/
+extern std::atomic<ulonglong> mta_writeset_table_generation;
+
+/** Called when the definition of a table is dropped from the cache. */
+inline void mta_writeset_table_changed() {
+  mta_writeset_table_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+class Mta_writeset_tracker {
+ public:
+  Mta_writeset_tracker();
+  ~Mta_writeset_tracker();
+
+  /**
+    Account an event the coordinator is scheduling. At the end of a group
+    the wait for the commit parent of the group is relaxed if its rows
+    allow it.
+
+    @param rli  coordinator's relay log info
+    @param ev   event being scheduled
+  */
+  void add_event(Relay_log_info *rli, Log_event *ev);
+
+  /**
+    Record the primary key layout of a table a worker opened to apply a
+    row event, unless it is already known.
+
+    @param rli    worker's relay log info
+    @param ev     row event being applied
+    @param table  table the event is applied to
+  */
+  void note_table(const Relay_log_info *rli, const Rows_log_event *ev,
+                  const TABLE *table);
+
+ private:
+  /// Primary key of a replica table, as needed to decode row images.
+  struct Table_layout {
+    uint column_count{0};
+    /// False if changes to the table can't be tracked by their key.
+    bool usable{false};
+    std::vector<uint> key_columns;
+    /// Real type of each key column, must match the type in the event.
+    std::vector<uint> key_types;
+    /// Sequence number of the group that recorded the layout.
+    longlong sequence_number{0};
+    ulonglong generation{0};
+  };
+
+  /// A table mapped by the group being scheduled.
+  struct Group_table {
+    std::string key;
+    std::unique_ptr<table_def> def;
+  };
+
+  void start_group(longlong sequence_number, longlong last_committed);
+  void end_group(Relay_log_info *rli);
+  /** Forget all history, later transactions depend on sequence_number. */
+  void clear_history(longlong sequence_number);
+  void add_table_map(Relay_log_info *rli, Table_map_log_event *ev);
+  bool add_rows(Rows_log_event *ev);
+  /**
+    Hash the key of one row image.
+
+    @param[in,out] ptr  start of the image, moved past it
+    @returns false if the image could not be decoded
+  */
+  bool add_row_image(const Group_table &table, const Table_layout &layout,
+                     const Rows_log_event *ev, bool after_image,
+                     const uchar **ptr);
+  static std::string make_key(const char *db, const char *table_name);
+
+  bool m_in_group{false};
+  bool m_group_usable{false};
+  longlong m_sequence_number{0};
+  longlong m_last_committed{0};
+  /// Sequence number of the previous group, to detect a clock reset.
+  longlong m_last_sequence_number{0};
+  /// Key hashes of the rows changed by the group being scheduled.
+  std::vector<uint64> m_group_hashes;
+  std::unordered_map<ulonglong, Group_table> m_group_tables;
+  /// Buffer used to build the key of a row.
+  std::string m_row_key;
+
+  /// Sequence number of the last transaction that changed each key.
+  std::unordered_map<uint64, longlong> m_history;
+  /// Transactions after this one are the only ones in m_history.
+  longlong m_history_start{0};
+
+  /// Protects m_layouts and m_layout_min_sequence_number.
+  mysql_mutex_t m_layouts_lock;
+  std::map<std::string, Table_layout> m_layouts;
+  /**
+    Layouts recorded by groups scheduled before the last DDL may describe
+    the old table definition, they are ignored.
+  */
+  longlong m_layout_min_sequence_number{0};
+};
+
+#endif /* RPL_MTA_WRITESET_INCLUDED */
@@ -6108,7 +6108,11 @@ static void *handle_slave_worker(void *arg) {
     delete job_item->data;
   }
 
-  assert(w->jobs.get_length() == 0);
+  /*
+    The Coordinator enqueues without jobs_lock, so it may still add a job
+    after this purge. Such jobs stay queued and are freed by
+    slave_stop_workers() once this Worker is NOT_RUNNING.
+  */
 
   mysql_mutex_unlock(&w->jobs_lock);
 
@@ -6832,6 +6836,13 @@ static void slave_stop_workers(Relay_log_info *rli, bool *mts_inited) {
       thd->EXIT_COND(&old_stage);
       mysql_mutex_lock(&w->jobs_lock);
     }
+    /*
+      Jobs are enqueued without jobs_lock, so some may have been assigned
+      after the Worker emptied its queue on exit. The Worker is gone and the
+      Coordinator no longer produces, so it can empty the queue itself.
+    */
+    Slave_job_item job_item = {nullptr, 0, {'\0'}};
+    while (w->jobs.de_queue(&job_item)) delete job_item.data;
     mysql_mutex_unlock(&w->jobs_lock);
   }
 
@@ -1046,6 +1046,9 @@ int Relay_log_info::purge_relay_logs(THD *thd, const char **errmsg,
 
   DBUG_TRACE;
 
+  /* The transactions the dependencies were registered for are gone. */
+  transaction_dependencies.clear();
+
   /*
     Even if inited==0, we still try to empty master_log_* variables. Indeed,
     inited==0 does not imply that they already are empty.
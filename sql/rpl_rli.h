@@ -56,6 +56,7 @@
 #include "sql/query_options.h"
 #include "sql/rpl_gtid.h"         // Gtid_set
 #include "sql/rpl_info.h"         // Rpl_info
+#include "sql/rpl_mta_dependencies.h"  // Mta_transaction_dependencies
 #include "sql/rpl_mta_submode.h"  // enum_mts_parallel_type
 #include "sql/rpl_replica_until_options.h"
 #include "sql/rpl_tblmap.h"  // table_mapping
@@ -355,6 +356,12 @@ class Relay_log_info : public Rpl_info {
   bool is_until_satisfied{false};
   bool view_change_until_set{false};
   bool need_to_wait{false};
+  /*
+    Dependencies of the transactions queued to the relay log, registered
+    by the component queueing them when it knows better than their commit
+    parent. Used by the coordinator of the LOGICAL_CLOCK applier.
+  */
+  Mta_transaction_dependencies transaction_dependencies;
 
   /* number of temporary tables open in this channel */
   std::atomic<int32> atomic_channel_open_temp_tables{0};
@@ -1147,6 +1154,12 @@ class Relay_log_info : public Rpl_info {
   */
   bool deferred_events_collecting;
 
+  /*
+    Positions of rows of tables without a usable index, used to apply row
+    events without a table scan.
+  */
+  Hash_slave_row_positions hash_row_positions;
+
   /*****************************************************************************
     WL#5569 MTS
 
@@ -1432,6 +1445,7 @@ class Relay_log_info : public Rpl_info {
   /* The general cleanup that slave applier may need at the end of session. */
   void cleanup_after_session() {
     if (deferred_events) delete deferred_events;
+    hash_row_positions.clear();
   }
 
   /**
@@ -1172,6 +1172,9 @@ void Slave_worker::slave_worker_ends_group(Log_event *ev, int error) {
 
     ptr_g->group_master_log_pos = group_master_log_pos;
     ptr_g->group_relay_log_pos = group_relay_log_pos;
+    if (!is_mts_db_partitioned(c_rli))
+      static_cast<Mts_submode_logical_clock *>(c_rli->current_mts_submode)
+          ->note_group_committed(ptr_g->sequence_number);
     ptr_g->done.store(1);
     last_group_done_index = gaq_index;
     last_groups_assigned_index = ptr_g->total_seqno;
@@ -2180,31 +2183,48 @@ bool append_item_to_jobs(slave_job_item *job_item, Slave_worker *worker,
     my_claim(ptr_g->group_master_log_name, /*claim=*/false);
   }
 
-  mysql_mutex_lock(&worker->jobs_lock);
+  /*
+    The Worker may leave between the check and the enqueue. The job is then
+    owned by the queue all the same, so this still counts as a success: it is
+    freed by slave_stop_workers() after the Worker exited.
+  */
+  if (worker->running_status == Slave_worker::RUNNING && !thd->killed)
+    ret = worker->jobs.en_queue(job_item);
 
   // possible WQ overfill
-  while (worker->running_status == Slave_worker::RUNNING && !thd->killed &&
-         (ret = worker->jobs.en_queue(job_item)) ==
-             Slave_jobs_queue::error_result) {
-    thd->ENTER_COND(&worker->jobs_cond, &worker->jobs_lock,
-                    &stage_replica_waiting_worker_queue, &old_stage);
-    worker->jobs.overfill = true;
-    worker->jobs.waited_overfill++;
-    rli->mts_wq_overfill_cnt++;
-    mysql_cond_wait(&worker->jobs_cond, &worker->jobs_lock);
-    mysql_mutex_unlock(&worker->jobs_lock);
-    thd->EXIT_COND(&old_stage);
-
+  if (ret == Slave_jobs_queue::error_result) {
     mysql_mutex_lock(&worker->jobs_lock);
+    while (worker->running_status == Slave_worker::RUNNING && !thd->killed) {
+      /*
+        Announce the wait before trying again, so that a Worker making room
+        from now on signals.
+      */
+      worker->jobs.overfill = true;
+      if ((ret = worker->jobs.en_queue(job_item)) !=
+          Slave_jobs_queue::error_result)
+        break;
+      thd->ENTER_COND(&worker->jobs_cond, &worker->jobs_lock,
+                      &stage_replica_waiting_worker_queue, &old_stage);
+      worker->jobs.waited_overfill++;
+      rli->mts_wq_overfill_cnt++;
+      mysql_cond_wait(&worker->jobs_cond, &worker->jobs_lock);
+      mysql_mutex_unlock(&worker->jobs_lock);
+      thd->EXIT_COND(&old_stage);
+
+      mysql_mutex_lock(&worker->jobs_lock);
+    }
+    mysql_mutex_unlock(&worker->jobs_lock);
   }
+
   if (ret != Slave_jobs_queue::error_result) {
     worker->curr_jobs++;
-    if (worker->jobs.get_length() == 1) mysql_cond_signal(&worker->jobs_cond);
-
-    mysql_mutex_unlock(&worker->jobs_lock);
+    /* The Worker announced it is waiting before it looked at the queue. */
+    if (worker->jobs.consumer_waiting) {
+      mysql_mutex_lock(&worker->jobs_lock);
+      mysql_cond_signal(&worker->jobs_cond);
+      mysql_mutex_unlock(&worker->jobs_lock);
+    }
   } else {
-    mysql_mutex_unlock(&worker->jobs_lock);
-
     // claim back ownership of the event log memory
     job_item->data->claim_memory_ownership(/*claim=*/true);
     if (worker->checkpoint_notified) {
@@ -2228,16 +2248,15 @@ bool append_item_to_jobs(slave_job_item *job_item, Slave_worker *worker,
   param[in] rli      slave's relay log info object.
  */
 static void remove_item_from_jobs(slave_job_item *job_item, Slave_worker *worker) {
-  mysql_mutex_lock(&worker->jobs_lock);
   worker->jobs.de_queue(job_item);
   /* possible overfill */
-  if (worker->jobs.get_length() == worker->jobs.capacity - 1 &&
-      worker->jobs.overfill == true) {
+  if (worker->jobs.overfill) {
+    mysql_mutex_lock(&worker->jobs_lock);
     worker->jobs.overfill = false;
     // todo: worker->hungry_cnt++;
     mysql_cond_signal(&worker->jobs_cond);
+    mysql_mutex_unlock(&worker->jobs_lock);
   }
-  mysql_mutex_unlock(&worker->jobs_lock);
 
   worker->events_done++;
 }
@@ -2256,6 +2275,19 @@ static struct slave_job_item *pop_jobs_item(Slave_worker *worker,
                                             Slave_job_item *job_item) {
   THD *thd = worker->info_thd;
 
+  /*
+    The queue needs no lock, jobs_lock is only taken to wait for an item or
+    to handle a stop request.
+  */
+  const auto head = worker->jobs.head_queue();
+  if (head != nullptr && !thd->killed &&
+      worker->running_status == Slave_worker::RUNNING) {
+    *job_item = *head;
+    worker->curr_jobs--;
+    thd_proc_info(worker->info_thd, "Executing event");
+    return job_item;
+  }
+
   mysql_mutex_lock(&worker->jobs_lock);
 
   job_item->data = nullptr;
@@ -2266,6 +2298,15 @@ static struct slave_job_item *pop_jobs_item(Slave_worker *worker,
 
     if (set_max_updated_index_on_stop(worker, job_item)) break;
     if (job_item->data == nullptr) {
+      /*
+        The Coordinator enqueues without jobs_lock and only signals a
+        Worker that announced the wait, so look again after announcing it.
+      */
+      worker->jobs.consumer_waiting = true;
+      if (worker->jobs.head_queue() != nullptr) {
+        worker->jobs.consumer_waiting = false;
+        continue;
+      }
       worker->wq_empty_waits++;
       thd->ENTER_COND(&worker->jobs_cond, &worker->jobs_lock,
                       &stage_replica_waiting_event_from_coordinator,
@@ -2274,6 +2315,7 @@ static struct slave_job_item *pop_jobs_item(Slave_worker *worker,
       mysql_mutex_unlock(&worker->jobs_lock);
       thd->EXIT_COND(&old_stage);
       mysql_mutex_lock(&worker->jobs_lock);
+      worker->jobs.consumer_waiting = false;
     }
   }
   if (job_item->data) worker->curr_jobs--;
@@ -2414,11 +2456,17 @@ int slave_worker_exec_job_group(Slave_worker *worker, Relay_log_info *rli) {
 
     DBUG_PRINT("info", ("W_%lu <- job item: %p data: %p thd: %p", worker->id,
                         job_item, ev, thd));
-    if (worker->is_wait_last_commited) {
-     longlong lwm_estimate =  static_cast<Mts_submode_logical_clock *>(rli->current_mts_submode)->estimate_lwm_timestamp();
-     while(worker->is_wait_last_commited) {
-       if (worker->last_commmitted_seq <= lwm_estimate) {
-         worker->is_wait_last_commited = false;
+    if (worker->is_wait_last_commited.load(std::memory_order_acquire)) {
+     auto *submode =
+         static_cast<Mts_submode_logical_clock *>(rli->current_mts_submode);
+     Slave_job_group *wait_group = gaq->get_job_group(ev->mts_group_idx);
+     longlong lwm_estimate =  submode->estimate_lwm_timestamp();
+     while(worker->is_wait_last_commited.load(std::memory_order_acquire)) {
+       if (worker->last_commmitted_seq.load(std::memory_order_acquire) <=
+               lwm_estimate &&
+           submode->parents_committed(wait_group, lwm_estimate)) {
+         worker->is_wait_last_commited.store(false,
+                                             std::memory_order_release);
          break;
        }
        if (unlikely(thd->killed ||
@@ -2430,7 +2478,7 @@ int slave_worker_exec_job_group(Slave_worker *worker, Relay_log_info *rli) {
        }
        my_sleep(10);
        counter++;
-       lwm_estimate =  static_cast<Mts_submode_logical_clock *>(rli->current_mts_submode)->estimate_lwm_timestamp();
+       lwm_estimate =  submode->estimate_lwm_timestamp();
      }
     }
 
@@ -27,6 +27,7 @@
 #include <stdarg.h>
 #include <sys/types.h>
 #include <time.h>
+#include <algorithm>
 #include <atomic>
 #include <tuple>
 
@@ -46,9 +47,10 @@
 #include "prealloced_array.h"  // Prealloced_array
 #include "sql/log_event.h"     // Format_description_log_event
 #include "sql/rpl_gtid.h"
-#include "sql/rpl_mta_submode.h"  // enum_mts_parallel_type
-#include "sql/rpl_replica.h"      // MTS_WORKER_UNDEF
-#include "sql/rpl_rli.h"          // Relay_log_info
+#include "sql/rpl_mta_dependencies.h"  // MTS_MAX_GROUP_PARENTS
+#include "sql/rpl_mta_submode.h"       // enum_mts_parallel_type
+#include "sql/rpl_replica.h"           // MTS_WORKER_UNDEF
+#include "sql/rpl_rli.h"               // Relay_log_info
 #include "sql/sql_class.h"
 #include "sql/system_variables.h"
 
@@ -136,7 +138,9 @@ struct Slave_job_group {
 #endif
         last_committed(other.last_committed),
         sequence_number(other.sequence_number),
+        parent_count(other.parent_count),
         new_fd_event(other.new_fd_event) {
+    std::copy(other.parents, other.parents + other.parent_count, parents);
   }
 
   Slave_job_group &operator=(const Slave_job_group &other) {
@@ -161,6 +165,8 @@ struct Slave_job_group {
 #endif
     last_committed = other.last_committed;
     sequence_number = other.sequence_number;
+    std::copy(other.parents, other.parents + other.parent_count, parents);
+    parent_count = other.parent_count;
     new_fd_event = other.new_fd_event;
     return *this;
   }
@@ -203,6 +209,14 @@ struct Slave_job_group {
   /* Clock-based scheduler requirement: */
   longlong last_committed;   // commit parent timestamp
   longlong sequence_number;  // transaction's logical timestamp
+  /*
+    Transactions the group waits for besides those up to its
+    last_committed, see Mta_transaction_dependencies. Set by Coordinator
+    before the group is handed to a Worker, cleared by the Worker once
+    they committed.
+  */
+  longlong parents[MTS_MAX_GROUP_PARENTS];
+  uint parent_count{0};
   /*
     After Coordinator has seen a new FD event, it sets this member to
     point to the new event, once per worker. Coordinator does so
@@ -252,6 +266,7 @@ struct Slave_job_group {
 #endif
     last_committed = SEQ_UNINIT;
     sequence_number = SEQ_UNINIT;
+    parent_count = 0;
     new_fd_event = nullptr;
   }
 };
@@ -485,6 +500,17 @@ bool circular_buffer_queue<Element_type>::de_tail(Element_type *item) {
   return true;
 }
 
+/**
+  Queue of the jobs assigned to a Worker.
+
+  The Coordinator is the only producer and the Worker the only consumer, so
+  the queue is a single-producer single-consumer ring that needs no lock:
+  the Coordinator only moves `avail`, the Worker only moves `entry`, both
+  kept below `capacity`, and the atomic `len` publishes items from one to
+  the other. jobs_lock and jobs_cond are only used by a side that has to
+  wait, for an item or for room, which it announces with consumer_waiting
+  or overfill so that the other side knows to signal.
+*/
 class Slave_jobs_queue : public circular_buffer_queue<Slave_job_item> {
  public:
   Slave_jobs_queue() : circular_buffer_queue<Slave_job_item>() {}
@@ -492,8 +518,48 @@ class Slave_jobs_queue : public circular_buffer_queue<Slave_job_item> {
      Coordinator marks with true, Worker signals back at queue back to
      available
   */
-  bool overfill;
+  std::atomic<bool> overfill;
   ulonglong waited_overfill;
+  /* Worker marks with true before waiting for the Coordinator to enqueue */
+  std::atomic<bool> consumer_waiting{false};
+
+  /**
+    Enqueue at the tail. Called by the Coordinator only.
+
+    @return the index of the item, or `error_result` if the queue is full.
+  */
+  size_t en_queue(Slave_job_item *item) {
+    if (len.load() == capacity) return error_result;
+    const size_t ret = avail;
+    m_Q[ret] = *item;
+    avail = (avail + 1) % capacity;
+    len++;
+    return ret;
+  }
+
+  /**
+    Return the head of the queue without dequeuing it. Called by the Worker
+    only.
+  */
+  Slave_job_item *head_queue() {
+    if (len.load() == 0) return nullptr;
+    return &m_Q[entry];
+  }
+
+  /**
+    Dequeue from head. Called by the Worker, or by the Coordinator once the
+    Worker has exited.
+
+    @param [out] item A pointer to the being dequeued item.
+    @return true if an element was returned, false if the queue was empty.
+  */
+  bool de_queue(Slave_job_item *item) {
+    if (len.load() == 0) return false;
+    *item = m_Q[entry];
+    entry = (entry + 1) % capacity;
+    len--;
+    return true;
+  }
 };
 
 class Slave_worker : public Relay_log_info {
@@ -536,7 +602,7 @@ class Slave_worker : public Relay_log_info {
   ulong wq_empty_waits;            // how many times got idle
   ulong events_done;               // how many events (statements) processed
   ulong groups_done;               // how many groups (transactions) processed
-  volatile int curr_jobs;          // number of active  assignments
+  std::atomic<int> curr_jobs;      // number of active  assignments
   // number of partitions allocated to the worker at point in time
   long usage_partition;
   // symmetric to rli->mts_end_group_sets_max_dbs
@@ -578,8 +644,13 @@ class Slave_worker : public Relay_log_info {
   */
   ulong excess_cnt;
 
-  longlong last_commmitted_seq;
-  bool is_wait_last_commited;
+  /*
+    Commit parent the next group waits for. The coordinator stores both,
+    and may lower the parent while the worker polls it, so they are read
+    with acquire and written with release ordering.
+  */
+  std::atomic<longlong> last_commmitted_seq;
+  std::atomic<bool> is_wait_last_commited;
 
   /*
     Coordinates of the last CheckPoint (CP) this Worker has
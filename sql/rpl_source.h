@@ -42,6 +42,7 @@ class THD;
 extern bool server_id_supplied;
 extern int max_binlog_dump_events;
 extern bool opt_sporadic_binlog_dump_fail;
+extern ulong binlog_dump_sendfile_threshold;
 extern bool opt_show_replica_auth_info;
 
 // Returns the rpl_resource
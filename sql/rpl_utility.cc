@@ -59,6 +59,7 @@ struct TYPELIB;
 #include "sql/dd/dictionary.h"  // is_dd_table_access_allowed
 #include "sql/derror.h"         // ER_THD
 #include "sql/field.h"          // Field
+#include "sql/handler.h"        // handler
 #include "sql/log.h"
 #include "sql/log_event.h"  // Log_event
 #include "sql/my_decimal.h"
@@ -1267,6 +1268,167 @@ uint Hash_slave_rows::make_hash_key(TABLE *table, MY_BITMAP *cols) {
   return crc;
 }
 
+ulong opt_replica_rows_hash_index_max_rows = 0;
+
+Hash_slave_row_positions::Table_positions *Hash_slave_row_positions::get(
+    TABLE *table) {
+  if (m_tables.empty()) return nullptr;
+
+  const std::string name(table->s->table_cache_key.str,
+                         table->s->table_cache_key.length);
+  const auto it = m_tables.find(name);
+  if (it == m_tables.end()) return nullptr;
+
+  Table_positions *table_positions = it->second.get();
+  /* A new share, the table may have been altered or truncated. */
+  if (table_positions->table_def_version !=
+      table->s->get_table_def_version())
+    reset(table_positions);
+  if (table_positions->cols.bitmap == nullptr) return nullptr;
+  return table_positions;
+}
+
+bool Hash_slave_row_positions::find(TABLE *table, MY_BITMAP *cols, uint *key,
+                                    std::vector<std::string> *positions) {
+  DBUG_TRACE;
+  if (opt_replica_rows_hash_index_max_rows == 0) {
+    clear();
+    return false;
+  }
+
+  Table_positions *table_positions = get(table);
+  if (table_positions == nullptr ||
+      table_positions->cols.n_bits != cols->n_bits ||
+      !bitmap_cmp(&table_positions->cols, cols))
+    return false;
+
+  *key = Hash_slave_rows::make_hash_key(table, cols);
+  positions->clear();
+  const auto range = table_positions->positions.equal_range(*key);
+  for (auto it = range.first; it != range.second; ++it)
+    positions->push_back(it->second.pos);
+  DBUG_PRINT("debug", ("Found %zu positions for key=%u", positions->size(),
+                       *key));
+  return true;
+}
+
+void Hash_slave_row_positions::add(TABLE *table, MY_BITMAP *cols,
+                                   const uchar *pos) {
+  if (opt_replica_rows_hash_index_max_rows == 0) return;
+
+  std::unique_ptr<Table_positions> &slot =
+      m_tables[std::string(table->s->table_cache_key.str,
+                           table->s->table_cache_key.length)];
+  if (slot == nullptr) slot = std::make_unique<Table_positions>();
+  Table_positions *table_positions = slot.get();
+
+  if (table_positions->table_def_version !=
+          table->s->get_table_def_version() ||
+      table_positions->cols.bitmap == nullptr ||
+      table_positions->cols.n_bits != cols->n_bits ||
+      !bitmap_cmp(&table_positions->cols, cols)) {
+    /*
+      A new share, or other columns: only the columns of the latest events
+      are of interest.
+    */
+    reset(table_positions);
+    if (bitmap_init(&table_positions->cols, nullptr, cols->n_bits)) return;
+    bitmap_copy(&table_positions->cols, cols);
+    table_positions->table_def_version = table->s->get_table_def_version();
+  }
+
+  add(table_positions, table,
+      Hash_slave_rows::make_hash_key(table, &table_positions->cols), pos);
+}
+
+void Hash_slave_row_positions::add_written(TABLE *table, const uchar *pos) {
+  if (opt_replica_rows_hash_index_max_rows == 0) return;
+
+  Table_positions *table_positions = get(table);
+  if (table_positions == nullptr) return;
+  add(table_positions, table,
+      Hash_slave_rows::make_hash_key(table, &table_positions->cols), pos);
+}
+
+void Hash_slave_row_positions::add(Table_positions *table_positions,
+                                   TABLE *table, uint key, const uchar *pos) {
+  const std::string position(pointer_cast<const char *>(pos),
+                             table->file->ref_length);
+  const auto range = table_positions->positions.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it)
+    if (it->second.pos == position) return;
+
+  while (m_size >= opt_replica_rows_hash_index_max_rows && !m_order.empty())
+    evict_oldest();
+
+  table_positions->positions.emplace(
+      key, Table_positions::Row_position{position, m_next_seq});
+  m_order.push_back({table_positions, key, m_next_seq});
+  m_next_seq++;
+  m_size++;
+
+  if (m_order.size() > 2 * std::max<size_t>(m_size, 1024)) compact_order();
+}
+
+void Hash_slave_row_positions::evict_oldest() {
+  const Recorded_position oldest = m_order.front();
+  m_order.pop_front();
+
+  auto &positions = oldest.table->positions;
+  const auto range = positions.equal_range(oldest.key);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second.seq == oldest.seq) {
+      positions.erase(it);
+      m_size--;
+      return;
+    }
+  }
+}
+
+void Hash_slave_row_positions::compact_order() {
+  const auto is_kept = [](const Recorded_position &recorded) {
+    const auto range = recorded.table->positions.equal_range(recorded.key);
+    return std::any_of(range.first, range.second, [&](const auto &entry) {
+      return entry.second.seq == recorded.seq;
+    });
+  };
+  m_order.erase(std::remove_if(m_order.begin(), m_order.end(),
+                               [&](const Recorded_position &recorded) {
+                                 return !is_kept(recorded);
+                               }),
+                m_order.end());
+}
+
+void Hash_slave_row_positions::reset(Table_positions *table_positions) {
+  m_size -= table_positions->positions.size();
+  table_positions->positions.clear();
+  bitmap_free(&table_positions->cols);
+  table_positions->cols = MY_BITMAP();
+}
+
+void Hash_slave_row_positions::remove(TABLE *table, uint key,
+                                      const uchar *pos) {
+  Table_positions *table_positions = get(table);
+  if (table_positions == nullptr) return;
+
+  const std::string position(pointer_cast<const char *>(pos),
+                             table->file->ref_length);
+  const auto range = table_positions->positions.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second.pos == position) {
+      table_positions->positions.erase(it);
+      m_size--;
+      return;
+    }
+  }
+}
+
+void Hash_slave_row_positions::clear() {
+  m_order.clear();
+  m_tables.clear();
+  m_size = 0;
+}
+
 #endif
 
 #if defined(MYSQL_SERVER)
@@ -30,8 +30,10 @@
 
 #include <sys/types.h>
 #include <algorithm>
+#include <deque>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "field_types.h"  // enum_field_types
 #include "my_dbug.h"
@@ -45,6 +47,7 @@ struct MY_BITMAP;
 #include <memory>
 
 #include "map_helpers.h"
+#include "my_bitmap.h"
 #include "prealloced_array.h"  // Prealloced_array
 #include "sql/table.h"         // Table_ref
 
@@ -213,6 +216,17 @@ class Hash_slave_rows {
    */
   int size();
 
+  /**
+     Creates an hash key, based on the data in table->record[0] buffer and
+     signaled as used in cols.
+
+     @param table  The table that is being scanned
+     @param cols   The read_set bitmap signaling which columns are used.
+
+     @returns the hash key created.
+   */
+  static uint make_hash_key(TABLE *table, MY_BITMAP *cols);
+
  private:
   /**
      The hashtable itself.
@@ -221,16 +235,126 @@ class Hash_slave_rows {
       uint, std::unique_ptr<HASH_ROW_ENTRY, hash_slave_rows_free_entry>>
       m_hash{key_memory_HASH_ROW_ENTRY};
 
+};
+
+/// @@replica_rows_hash_index_max_rows
+extern ulong opt_replica_rows_hash_index_max_rows;
+
+/**
+   Positions of rows of tables without a usable index, kept by an applier
+   across row events.
+
+   HASH_SCAN hashes the before images of one event and scans the table
+   once to find them, so a table changed by many small events is scanned
+   once per event. The rows those scans go through, and the rows the
+   applier changes, are recorded here by the hash Hash_slave_rows uses, so
+   that the rows of later events are read directly with ha_rnd_pos.
+
+   This is only a hint. A row read from a recorded position is compared
+   with the before image, and rows that are not found this way are looked
+   up by a table scan as before, which records the rows it goes through.
+   At most @@replica_rows_hash_index_max_rows positions are kept, the ones
+   recorded first are dropped first.
+ */
+class Hash_slave_row_positions {
+ public:
+  Hash_slave_row_positions() = default;
+  ~Hash_slave_row_positions() { clear(); }
+
+  Hash_slave_row_positions(const Hash_slave_row_positions &) = delete;
+  Hash_slave_row_positions &operator=(const Hash_slave_row_positions &) =
+      delete;
+
   /**
-     Auxiliary and internal method used to create an hash key, based on
-     the data in table->record[0] buffer and signaled as used in cols.
+     Gets the recorded positions of the rows matching table->record[0].
 
-     @param table  The table that is being scanned
-     @param cols   The read_set bitmap signaling which columns are used.
+     @param      table      The table holding the row in record[0].
+     @param      cols       The columns of the row that are compared.
+     @param[out] key        The hash of the row.
+     @param[out] positions  The positions found, possibly none.
 
-     @returns the hash key created.
+     @returns false if the rows of the table are not recorded for these
+              columns, true otherwise.
+   */
+  bool find(TABLE *table, MY_BITMAP *cols, uint *key,
+            std::vector<std::string> *positions);
+
+  /**
+     Records the position of the row in table->record[0], starting to
+     record rows of the table if it was not done yet.
+
+     @param table  The table holding the row in record[0].
+     @param cols   The columns of the row that are compared.
+     @param pos    The position of the row, table->file->ref_length bytes.
+   */
+  void add(TABLE *table, MY_BITMAP *cols, const uchar *pos);
+
+  /**
+     Records the position of a row written to the table, if the rows of
+     the table are being recorded.
+   */
+  void add_written(TABLE *table, const uchar *pos);
+
+  /** Forgets a position, the row there was deleted or changed. */
+  void remove(TABLE *table, uint key, const uchar *pos);
+
+  void clear();
+
+ private:
+  struct Table_positions {
+    ~Table_positions() { bitmap_free(&cols); }
+
+    /// A row position, and when it was recorded.
+    struct Row_position {
+      std::string pos;
+      ulonglong seq;
+    };
+
+    /// TABLE_SHARE::get_table_def_version() of the share the positions
+    /// were recorded for.
+    ulonglong table_def_version{0};
+    /// The columns the positions are hashed by, no bits if none are kept.
+    MY_BITMAP cols{};
+    malloc_unordered_multimap<uint, Row_position> positions{
+        key_memory_HASH_ROW_ENTRY};
+  };
+
+  /// A position in the order positions are recorded in.
+  struct Recorded_position {
+    Table_positions *table;
+    uint key;
+    ulonglong seq;
+  };
+
+  /**
+     Gets the positions of the table, forgetting them if the table was
+     reopened with another definition.
+   */
+  Table_positions *get(TABLE *table);
+  void add(Table_positions *positions, TABLE *table, uint key,
+           const uchar *pos);
+  /** Forgets the positions of a table and the columns they are for. */
+  void reset(Table_positions *positions);
+  /** Forgets the position recorded first which is still kept. */
+  void evict_oldest();
+  /** Drops the entries of m_order whose position was forgotten. */
+  void compact_order();
+
+  /**
+     Tables are kept until clear(), even when their positions are reset,
+     since m_order points to them.
+   */
+  std::unordered_map<std::string, std::unique_ptr<Table_positions>> m_tables;
+  /**
+     The positions of all tables, oldest first. Positions removed or reset
+     since they were recorded are skipped when evicting, and dropped once
+     they make up half of the entries.
    */
-  uint make_hash_key(TABLE *table, MY_BITMAP *cols);
+  std::deque<Recorded_position> m_order;
+  /// Sequence number of the next position recorded.
+  ulonglong m_next_seq{0};
+  /// Number of positions recorded for all tables.
+  size_t m_size{0};
 };
 
 #endif
@@ -114,8 +114,10 @@
 #include "sql/partition_info.h"  // partition_info
 #include "sql/psi_memory_key.h"  // key_memory_TABLE
 #include "sql/query_options.h"
+#include "sql/result_cache.h"  // result_cache
 #include "sql/rpl_gtid.h"
 #include "sql/rpl_handler.h"                       // RUN_HOOK
+#include "sql/rpl_mta_writeset.h"  // mta_writeset_table_changed
 #include "sql/rpl_replica_commit_order_manager.h"  // has_commit_order_manager
 #include "sql/rpl_rli.h"                           //Relay_log_information
 #include "sql/session_tracker.h"
@@ -10230,6 +10232,9 @@ void tdc_remove_table(THD *thd, enum_tdc_remove_table_type remove_type,
 
   key_length = create_table_def_key(db, table_name, key);
 
+  result_cache.invalidate_table(db, table_name);
+  mta_writeset_table_changed();
+
   auto it = table_def_cache->find(string(key, key_length));
 
   // If the table has a shadow copy in a secondary storage engine, or
@@ -1169,6 +1169,7 @@ void THD::cleanup_connection(void) {
   m_thd_life_cycle_stage = enum_thd_life_cycle_stages::ACTIVE;
   init();
   stmt_map.reset();
+  prepared_query_cache.reset();
   user_vars.clear();
   sp_cache_clear(&sp_proc_cache);
   sp_cache_clear(&sp_func_cache);
@@ -1362,6 +1363,7 @@ void THD::release_resources() {
   mysql_audit_free_thd(this);
 
   stmt_map.reset(); /* close all prepared statements */
+  prepared_query_cache.reset();
   if (!is_cleanup_done()) cleanup();
 
   mdl_context.destroy();
@@ -1412,12 +1414,123 @@ void THD::release_resources() {
   disable_mem_cnt();
 }
 
+bool THD::is_reusable() const {
+  return m_enable_plugins && !slave_thread && rli_fake == nullptr &&
+         external_store_.empty() && is_classic_protocol() &&
+         net.buff != nullptr;
+}
+
+void THD::reset_for_reuse() {
+  assert(is_reusable());
+
+  /* Ensure that no one is using THD */
+  mysql_mutex_lock(&LOCK_query_plan);
+  mysql_mutex_lock(&LOCK_thd_data);
+
+  // Mark THD life cycle state as "SCHEDULED_FOR_DISPOSAL".
+  start_disposal();
+
+  /* Close connection, the network buffer is kept for the next one. */
+  if (get_protocol_classic()->get_vio()) {
+    vio_delete(get_protocol_classic()->get_vio());
+    get_protocol_classic()->end_net_keep_buffer();
+  }
+
+  assert(query_plan.get_modification_plan() == nullptr);
+  mysql_mutex_unlock(&LOCK_thd_data);
+  mysql_mutex_unlock(&LOCK_query_plan);
+  mysql_mutex_lock(&LOCK_thd_query);
+  mysql_mutex_unlock(&LOCK_thd_query);
+
+  mysql_audit_free_thd(this);
+  mysql_audit_init_thd(this);
+
+  stmt_map.reset(); /* close all prepared statements */
+  prepared_query_cache.reset();
+  if (!is_cleanup_done()) cleanup();
+
+  /* Reset the session state that cleanup() leaves to the next session. */
+  user_vars.clear();
+  clear_error();
+  get_stmt_da()->reset_condition_info(this);
+#if defined(ENABLED_PROFILING)
+  profiling->cleanup();
+#endif
+  killed = NOT_KILLED;
+  running_explain_analyze = false;
+
+  /* Reset the connection state set up by the constructor. */
+  m_main_security_ctx.logout();
+  mysql_mutex_lock(&LOCK_thd_data);
+  m_main_security_ctx = Security_context(this);
+  m_security_ctx = &m_main_security_ctx;
+  mysql_mutex_unlock(&LOCK_thd_data);
+  set_system_user(false);
+  set_connection_admin(false);
+  set_db(NULL_CSTR);
+  reset_query();
+  m_connection_attributes.clear();
+  m_user_connect = nullptr;
+  m_is_admin_conn = false;
+  peer_port = 0;
+  *scramble = '\0';
+  set_command(COM_CONNECT);
+  set_proc_info("login");
+
+  /*
+    Release what refers to storage engines and plugins, so that an idle THD
+    does not delay their shutdown and takes the current global variables
+    when init_for_reuse() is called.
+  */
+  ha_close_connection(this);
+#if defined(ENABLED_DEBUG_SYNC)
+  /* End the Debug Sync Facility. See debug_sync.cc. */
+  debug_sync_end_thread(this);
+#endif /* defined(ENABLED_DEBUG_SYNC) */
+  plugin_thdvar_cleanup(this, m_enable_plugins);
+
+  if (current_thd == this) restore_globals();
+
+  mysql_mutex_lock(&LOCK_status);
+  /* Add thread status to the global totals. */
+  add_to_status(&global_status_var, &status_var);
+#ifdef HAVE_PSI_THREAD_INTERFACE
+  /* Aggregate thread status into the Performance Schema. */
+  if (m_psi != nullptr) {
+    PSI_THREAD_CALL(aggregate_thread_status)(m_psi);
+  }
+#endif /* HAVE_PSI_THREAD_INTERFACE */
+  /* Ensure that the thread status is not re-aggregated to the global totals. */
+  status_var_aggregated = true;
+  mysql_mutex_unlock(&LOCK_status);
+
+  m_reset_for_reuse = true;
+  m_thd_life_cycle_stage = enum_thd_life_cycle_stages::RESOURCES_RELEASED;
+  disable_mem_cnt();
+}
+
+void THD::init_for_reuse() {
+  assert(m_reset_for_reuse && release_resources_done());
+  m_reset_for_reuse = false;
+  m_thd_life_cycle_stage = enum_thd_life_cycle_stages::ACTIVE;
+  killed = NOT_KILLED;
+  status_var_aggregated = false;
+  init();
+}
+
 THD::~THD() {
   THD_CHECK_SENTRY(this);
   DBUG_TRACE;
   DBUG_PRINT("info", ("THD dtor, this %p", this));
 
-  if (!release_resources_done()) release_resources();
+  if (!release_resources_done())
+    release_resources();
+  else if (m_reset_for_reuse) {
+    /* Release what reset_for_reuse() kept for the next connection. */
+    net_end(&net);
+    mdl_context.destroy();
+    if (timer_cache) thd_timer_destroy(timer_cache);
+  }
 
   clear_next_event_pos();
 
@@ -2946,6 +3059,7 @@ void THD::claim_memory_ownership(bool claim [[maybe_unused]]) {
 #endif /* defined(ENABLED_DEBUG_SYNC) */
   get_transaction()->claim_memory_ownership(claim);
   stmt_map.claim_memory_ownership(claim);
+  prepared_query_cache.claim_memory_ownership(claim);
 #endif /* HAVE_PSI_MEMORY_INTERFACE */
 }
 
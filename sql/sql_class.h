@@ -44,6 +44,7 @@
 #include <sys/types.h>
 #include <atomic>
 #include <bitset>
+#include <list>
 #include <memory>
 #include <new>
 #include <string>
@@ -94,6 +95,7 @@
 #include "sql/psi_memory_key.h"
 #include "sql/query_options.h"
 #include "sql/resourcegroups/resource_group_basic_types.h"
+#include "sql/result_cache.h"  // Result_cache_session
 #include "sql/rpl_context.h"  // Rpl_thd_context
 #include "sql/rpl_gtid.h"
 #include "sql/session_tracker.h"  // Session_tracker
@@ -520,6 +522,68 @@ class Prepared_statement_map {
   Prepared_statement *m_last_found_statement;
 };
 
+/**
+  Statements prepared implicitly for SELECT queries received through the
+  text protocol, see @@prepared_query_cache_size.
+
+  The cache is keyed on the query text together with the session state that
+  the text was resolved in (current database, sql_mode, character sets and
+  the variables resolution depends on), so a hit can run the prepared
+  statement as if the query had been parsed again. Each execution reports
+  the digest and the warnings of the parse. The statements are not visible
+  to the client and do not count against max_prepared_stmt_count. Metadata
+  changes of the tables they use are detected by the regular reprepare logic
+  of prepared statements.
+
+  Literals that are operands of comparison, LIKE, BETWEEN and IN predicates
+  in the WHERE clause are replaced by parameter markers before the lookup,
+  so queries that differ only in these literals share one statement and the
+  literals are bound as its parameter values. A statement is only used when
+  its parameters resolved to types for which this does not change the
+  result; other literals stay part of the text that is matched.
+*/
+class Prepared_query_cache {
+ public:
+  Prepared_query_cache();
+
+  /**
+    Find the statement cached for the current query of the session, or try
+    to prepare and cache it.
+
+    @param      thd   Current session.
+    @param[out] stmt  The statement to execute, or nullptr if the query is
+                      not eligible and must be parsed and executed as usual.
+
+    @retval false  Success.
+    @retval true   The query failed to parse or resolve, the error is in the
+                   diagnostics area.
+  */
+  bool find_or_prepare(THD *thd, Prepared_statement **stmt);
+
+  void claim_memory_ownership(bool claim);
+
+  /** Erase all cached statements. */
+  void reset();
+
+  ~Prepared_query_cache();
+
+ private:
+  using Lru_list = std::list<std::string, Malloc_allocator<std::string>>;
+
+  struct Entry {
+    /// The statement, nullptr for queries that are not to be prepared.
+    std::unique_ptr<Prepared_statement> m_stmt;
+    /// Position of the key in m_lru.
+    Lru_list::iterator m_lru_position;
+  };
+
+  void evict_least_recently_used();
+
+  malloc_unordered_map<std::string, Entry> m_statements;
+  /// Keys of m_statements, most recently used first.
+  Lru_list m_lru;
+};
+
 /**
   A registry for item tree transformations performed during
   query optimization. We register only those changes which require
@@ -1253,6 +1317,10 @@ class THD : public MDL_context_owner,
 
   /** All prepared statements of this connection. */
   Prepared_statement_map stmt_map;
+  /** Statements prepared implicitly for repeated text protocol queries. */
+  Prepared_query_cache prepared_query_cache;
+  /** Query result cache state of this connection. */
+  Result_cache_session result_cache_session;
   /*
     A pointer to the stack frame of handle_one_connection(),
     which is called first in the thread for handling a client
@@ -2843,6 +2911,33 @@ class THD : public MDL_context_owner,
   ~THD() override;
 
   void release_resources();
+
+  /**
+    Check if the THD of a closed client connection can be reset by
+    reset_for_reuse() instead of being destroyed.
+  */
+  bool is_reusable() const;
+
+  /**
+    Reset the THD of a closed client connection so that it can serve a new
+    connection, in place of release_resources().
+
+    The THD is marked for disposal and its session is cleaned up as by
+    release_resources(), and the connection specific state is reset as it
+    is by the constructor. It keeps its memory, mutexes, metadata locking
+    context and network buffer, but no storage engine data, plugin
+    references or session trackers. As after release_resources(), it must
+    then be removed from the Global_THD_manager before its thread id is
+    released. It may then be destroyed, or initialized by init_for_reuse()
+    for the next connection.
+  */
+  void reset_for_reuse();
+
+  /**
+    Initialize a THD reset by reset_for_reuse() for a new connection. The
+    session variables are set from the current global ones.
+  */
+  void init_for_reuse();
   /**
     @returns true if THD resources are released.
   */
@@ -2880,6 +2975,13 @@ class THD : public MDL_context_owner,
   enum_thd_life_cycle_stages m_thd_life_cycle_stage{
       enum_thd_life_cycle_stages::ACTIVE};
 
+  /**
+    Set by reset_for_reuse() until init_for_reuse(): the resources are
+    released, except the network buffer, metadata locking context and timer
+    kept for the next connection.
+  */
+  bool m_reset_for_reuse{false};
+
   /**
     Set THD in ACTIVE life stage to disposal stage.
 
@@ -126,6 +126,7 @@
 #include "sql/query_result.h"
 #include "sql/resourcegroups/resource_group_basic_types.h"
 #include "sql/resourcegroups/resource_group_mgr.h"  // Resource_group_mgr::instance
+#include "sql/result_cache.h"  // result_cache
 #include "sql/rpl_context.h"
 #include "sql/rpl_filter.h"             // rpl_filter
 #include "sql/rpl_group_replication.h"  // group_replication_start
@@ -1175,6 +1176,28 @@ bool is_explainable_query(enum enum_sql_command command) {
   return (sql_command_flags[command] & CF_CAN_BE_EXPLAINED) != 0;
 }
 
+/**
+  Check, without parsing, whether a query text is a single SELECT statement.
+  Texts that contain a semicolon anywhere are rejected since they may be
+  multi-statement batches.
+
+  @param query  The query text
+  @return true if the text starts with SELECT and has no semicolon
+*/
+bool is_single_select_query_text(const LEX_CSTRING &query) {
+  const char *pos = query.str;
+  const char *end = query.str + query.length;
+  while (pos < end && my_isspace(system_charset_info, *pos)) pos++;
+  static constexpr size_t select_length = sizeof("SELECT") - 1;
+  if (static_cast<size_t>(end - pos) <= select_length ||
+      native_strncasecmp(pos, "SELECT", select_length) != 0)
+    return false;
+  const char next = pos[select_length];
+  if (!my_isspace(system_charset_info, next) && next != '(' && next != '/')
+    return false;
+  return memchr(pos, ';', end - pos) == nullptr;
+}
+
 /**
   Check if a sql command is allowed to write to log tables.
   @param command The SQL command
@@ -3335,10 +3358,16 @@ int mysql_execute_command(THD *thd, bool first_level) {
     thd->query_plan.set_query_plan(lex->sql_command, lex,
                                    !thd->stmt_arena->is_regular());
 
+  if (first_level) result_cache.note_session_setting(thd);
+
   /* Update system variables specified in SET_VAR hints. */
   if (lex->opt_hints_global && lex->opt_hints_global->sys_var_hint)
     lex->opt_hints_global->sys_var_hint->update_vars(thd);
 
+  /* Capture the result set for the query result cache, if enabled. */
+  if (first_level && lex->sql_command == SQLCOM_SELECT)
+    result_cache.start_capture(thd);
+
   /* Check if the statement fulfill the requirements on ACL CACHE */
   if (!command_satisfy_acl_cache_requirement(lex->sql_command)) {
     my_error(ER_OPTION_PREVENTS_STATEMENT, MYF(0), "--skip-grant-tables");
@@ -4863,6 +4892,8 @@ error:
   res = true;
 
 finish:
+  result_cache.finish_capture(thd, res);
+
   /* Restore system variables which were changed by SET_VAR hint. */
   if (lex->opt_hints_global && lex->opt_hints_global->sys_var_hint)
     lex->opt_hints_global->sys_var_hint->restore_vars(thd);
@@ -5252,8 +5283,22 @@ void dispatch_sql_command(THD *thd, Parser_state *parser_state) {
 
   bool err = thd->get_stmt_da()->is_error();
   size_t qlen = 0;
-
-  if (!err) {
+  /*
+    Statement prepared earlier for the same query text, executed instead of
+    parsing the query again. See @@prepared_query_cache_size.
+  */
+  Prepared_statement *cached_stmt = nullptr;
+  /* Result set of the same query, sent instead of executing it. */
+  std::shared_ptr<const Result_cache_entry> cached_result;
+
+  if (!err) cached_result = result_cache.find(thd);
+  if (!err && cached_result == nullptr)
+    err = thd->prepared_query_cache.find_or_prepare(thd, &cached_stmt);
+
+  if (cached_result != nullptr || cached_stmt != nullptr) {
+    lex->sql_command = SQLCOM_SELECT;
+    qlen = thd->query().length;
+  } else if (!err) {
     err = parse_sql(thd, parser_state, nullptr);
     if (!err) err = invoke_post_parse_rewrite_plugins(thd, false);
 
@@ -5348,6 +5393,16 @@ void dispatch_sql_command(THD *thd, Parser_state *parser_state) {
           else
             my_error(ER_MUST_CHANGE_PASSWORD, MYF(0));
           error = 1;
+        } else if (cached_result != nullptr) {
+          error = result_cache.send(thd, *cached_result);
+        } else if (cached_stmt != nullptr) {
+          /*
+            Resource groups are switched by the prepared statement itself.
+            The query is logged as sent, not with its literals replaced.
+          */
+          String expanded_query(thd->query().str, thd->query().length,
+                                thd->charset());
+          error = cached_stmt->execute_loop(thd, &expanded_query, false);
         } else {
           resourcegroups::Resource_group *src_res_grp = nullptr;
           resourcegroups::Resource_group *dest_res_grp = nullptr;
@@ -99,6 +99,7 @@ bool check_host_name(const LEX_CSTRING &str);
 bool mysql_test_parse_for_slave(THD *thd);
 bool is_update_query(enum enum_sql_command command);
 bool is_explainable_query(enum enum_sql_command command);
+bool is_single_select_query_text(const LEX_CSTRING &query);
 bool is_log_table_write_query(enum enum_sql_command command);
 bool alloc_query(THD *thd, const char *packet, size_t packet_length);
 void dispatch_sql_command(THD *thd, Parser_state *parser_state);
@@ -102,8 +102,10 @@ When one supplies long data for a placeholder:
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "decimal.h"
 #include "field_types.h"
@@ -2085,6 +2087,560 @@ void mysql_sql_stmt_close(THD *thd) {
   my_ok(thd);
 }
 
+namespace {
+
+/**
+  A token of a query text, as far as parameterize_query() needs to tell
+  tokens apart. Whitespace and comments are not tokens.
+*/
+struct Query_token {
+  enum Kind {
+    WORD,    ///< Keyword or unquoted identifier
+    QUOTED,  ///< Quoted identifier, or double-quoted string
+    NUMBER,  ///< Number literal
+    STRING,  ///< Single-quoted string literal
+    PUNCT    ///< Operator or punctuation
+  };
+
+  Kind kind;
+  const char *str;
+  size_t length;
+  /// NUMBER: the literal has a decimal point
+  bool has_point{false};
+  /// NUMBER: the literal has an exponent
+  bool has_exponent{false};
+  /// STRING: the literal has no backslash escapes
+  bool is_plain{true};
+  /// WORD: the AND that ends the range of a BETWEEN predicate
+  bool is_between_and{false};
+
+  bool is_word(const char *word) const {
+    return kind == WORD && strlen(word) == length &&
+           native_strncasecmp(str, word, length) == 0;
+  }
+  bool is_punct(const char *punct) const {
+    return kind == PUNCT && strlen(punct) == length &&
+           memcmp(str, punct, length) == 0;
+  }
+};
+
+/// A literal of a query, in the form of a COM_STMT_EXECUTE parameter value.
+struct Query_literal {
+  enum_field_types type;
+  bool is_unsigned;
+  std::string value;
+};
+
+}  // namespace
+
+static bool is_query_word_char(char c) {
+  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+         (c >= 'A' && c <= 'Z') || c == '_' || c == '$' ||
+         static_cast<uchar>(c) >= 0x80;
+}
+
+static bool is_query_digit(char c) { return c >= '0' && c <= '9'; }
+
+/// Whether the next token is qualified by a name, as in "t1.a".
+static bool follows_name(const std::vector<Query_token> &tokens) {
+  return !tokens.empty() && (tokens.back().kind == Query_token::WORD ||
+                             tokens.back().kind == Query_token::QUOTED);
+}
+
+/// Whether a top-level token ends the WHERE clause of a query block.
+static bool is_where_clause_end(const Query_token &token) {
+  static const char *const words[] = {
+      "GROUP",     "ORDER", "HAVING", "LIMIT", "WINDOW", "UNION",
+      "INTERSECT", "EXCEPT", "INTO",  "FOR",   "LOCK",   "PROCEDURE"};
+  for (const char *word : words)
+    if (token.is_word(word)) return true;
+  return token.is_punct(";");
+}
+
+/**
+  Split a query text into tokens.
+
+  @param      cs                 Character set of the query text.
+  @param      backslash_escapes  Whether backslash is an escape character in
+                                 string literals.
+  @param      query              The query text.
+  @param[out] tokens             The tokens of the query.
+
+  @retval false  The tokens describe the query.
+  @retval true   The query has parameter markers, executable comments or
+                 unterminated quotes or comments, which are left to the
+                 parser.
+*/
+
+static bool tokenize_query(const CHARSET_INFO *cs, bool backslash_escapes,
+                           const LEX_CSTRING &query,
+                           std::vector<Query_token> *tokens) {
+  static const char *const operators[] = {
+      "<=>", "->>", "<=", ">=", "<>", "!=", "||", "&&", ":=", "->", "<<", ">>"};
+  const char *pos = query.str;
+  const char *const end = query.str + query.length;
+
+  while (pos < end) {
+    const char c = *pos;
+    if (static_cast<uchar>(c) <= ' ') {
+      pos++;
+      continue;
+    }
+    if (c == '#' || (c == '-' && end - pos >= 2 && pos[1] == '-' &&
+                     (end - pos == 2 || static_cast<uchar>(pos[2]) <= ' '))) {
+      while (pos < end && *pos != '\n') pos++;
+      continue;
+    }
+    if (c == '/' && end - pos >= 2 && pos[1] == '*') {
+      if (end - pos >= 3 && pos[2] == '!') return true;
+      const char *close = pos + 2;
+      while (close + 1 < end && (close[0] != '*' || close[1] != '/')) close++;
+      if (close + 1 >= end) return true;
+      pos = close + 2;
+      continue;
+    }
+    if (c == '?') return true;
+
+    Query_token token{Query_token::PUNCT, pos, 0};
+    if (c == '\'' || c == '"' || c == '`') {
+      token.kind = c == '\'' ? Query_token::STRING : Query_token::QUOTED;
+      for (pos++;; pos++) {
+        if (pos == end) return true;
+        const uint mb_length = use_mb(cs) ? my_ismbchar(cs, pos, end) : 0;
+        if (mb_length > 1) {
+          pos += mb_length - 1;
+        } else if (*pos == '\\' && backslash_escapes && c != '`') {
+          token.is_plain = false;
+          if (++pos == end) return true;
+        } else if (*pos == c) {
+          // A doubled quote stands for the quote itself.
+          if (pos + 1 == end || pos[1] != c) break;
+          pos++;
+        }
+      }
+      pos++;
+    } else if (is_query_digit(c) ||
+               (c == '.' && end - pos >= 2 && is_query_digit(pos[1]) &&
+                !follows_name(*tokens))) {
+      token.kind = Query_token::NUMBER;
+      while (pos < end && is_query_digit(*pos)) pos++;
+      if (pos < end && *pos == '.') {
+        token.has_point = true;
+        for (pos++; pos < end && is_query_digit(*pos);) pos++;
+      }
+      if (pos < end && (*pos == 'e' || *pos == 'E')) {
+        const char *exponent = pos + 1;
+        if (exponent < end && (*exponent == '+' || *exponent == '-'))
+          exponent++;
+        if (exponent < end && is_query_digit(*exponent)) {
+          token.has_exponent = true;
+          for (pos = exponent; pos < end && is_query_digit(*pos);) pos++;
+        }
+      }
+      // Hexadecimal and bit literals, and identifiers that begin with digits
+      if (pos < end && is_query_word_char(*pos)) {
+        token.kind = Query_token::WORD;
+        while (pos < end && is_query_word_char(*pos)) pos++;
+      }
+    } else if (is_query_word_char(c)) {
+      token.kind = Query_token::WORD;
+      while (pos < end && is_query_word_char(*pos)) pos++;
+    } else {
+      pos++;
+      for (const char *op : operators) {
+        const size_t op_length = strlen(op);
+        if (static_cast<size_t>(end - token.str) >= op_length &&
+            memcmp(token.str, op, op_length) == 0) {
+          pos = token.str + op_length;
+          break;
+        }
+      }
+    }
+    token.length = pos - token.str;
+    tokens->push_back(token);
+  }
+  return false;
+}
+
+/**
+  Whether a literal token can be replaced by a parameter marker, given the
+  tokens around it: it must be a whole operand of a comparison, LIKE,
+  BETWEEN or IN predicate.
+*/
+
+static bool is_literal_operand(const Query_token &prev,
+                               const Query_token *next, bool in_list) {
+  static const char *const comparisons[] = {"=",  "<",  ">",  "<=",
+                                            ">=", "<>", "!=", "<=>"};
+
+  bool starts = prev.is_word("LIKE") || prev.is_word("BETWEEN") ||
+                prev.is_between_and ||
+                (in_list && (prev.is_punct("(") || prev.is_punct(",")));
+  for (const char *comparison : comparisons)
+    starts = starts || prev.is_punct(comparison);
+  if (!starts) return false;
+
+  return next == nullptr || next->is_punct(")") || next->is_punct(",") ||
+         next->is_punct("&&") || next->is_word("AND") || next->is_word("OR") ||
+         next->is_word("XOR") || is_where_clause_end(*next);
+}
+
+/**
+  Make the parameter value that stands for a literal token.
+
+  @returns false if the literal is to be left in the query text.
+*/
+
+static bool make_query_literal(const Query_token &token,
+                               Query_literal *literal) {
+  literal->is_unsigned = false;
+  if (token.kind == Query_token::STRING) {
+    if (!token.is_plain) return false;
+    literal->type = MYSQL_TYPE_STRING;
+    literal->value.clear();
+    for (size_t i = 1; i + 1 < token.length; i++) {
+      literal->value.push_back(token.str[i]);
+      if (token.str[i] == '\'') i++;
+    }
+    return true;
+  }
+
+  assert(token.kind == Query_token::NUMBER);
+  char buffer[8];
+  if (token.has_exponent) {
+    const char *end = token.str + token.length;
+    int error = 0;
+    const double value = my_strtod(token.str, &end, &error);
+    if (error != 0) return false;
+    float8store(buffer, value);
+    literal->type = MYSQL_TYPE_DOUBLE;
+    literal->value.assign(buffer, sizeof(buffer));
+    return true;
+  }
+  if (!token.has_point) {
+    ulonglong value = 0;
+    bool overflow = false;
+    for (size_t i = 0; i < token.length && !overflow; i++) {
+      const uint digit = token.str[i] - '0';
+      overflow = value > (ULLONG_MAX - digit) / 10;
+      value = value * 10 + digit;
+    }
+    if (!overflow) {
+      int8store(buffer, value);
+      literal->type = MYSQL_TYPE_LONGLONG;
+      literal->is_unsigned = value > static_cast<ulonglong>(LLONG_MAX);
+      literal->value.assign(buffer, sizeof(buffer));
+      return true;
+    }
+  }
+  literal->type = MYSQL_TYPE_NEWDECIMAL;
+  literal->value.assign(token.str, token.length);
+  return true;
+}
+
+/**
+  Replace the literals that are operands of predicates in the WHERE clause
+  of a query with parameter markers, so that queries that differ only in
+  these literals share one prepared statement.
+
+  Only literals that a parameter can stand for without changing the result
+  are replaced: plain numbers and string literals without escapes or
+  character set introducers, that are the whole operand of a comparison,
+  LIKE, BETWEEN or IN predicate.
+
+  @param      thd       Current session.
+  @param[out] text      The query text with the parameter markers.
+  @param[out] literals  The replaced literals, in query order.
+*/
+
+static void parameterize_query(THD *thd, std::string *text,
+                               std::vector<Query_literal> *literals) {
+  const LEX_CSTRING &query = thd->query();
+  text->assign(query.str, query.length);
+  literals->clear();
+
+  std::vector<Query_token> tokens;
+  if (tokenize_query(thd->charset(),
+                     !(thd->variables.sql_mode & MODE_NO_BACKSLASH_ESCAPES),
+                     query, &tokens))
+    return;
+
+  std::string rewritten;
+  size_t copied = 0;
+  // For each open parenthesis, whether it opens the value list of IN
+  std::vector<bool> in_lists;
+  size_t between_depth = SIZE_MAX;
+  bool in_where = false;
+  for (size_t i = 0; i < tokens.size(); i++) {
+    Query_token &token = tokens[i];
+    const Query_token *prev = i > 0 ? &tokens[i - 1] : nullptr;
+    const Query_token *next = i + 1 < tokens.size() ? &tokens[i + 1] : nullptr;
+    if (token.is_punct("(")) {
+      in_lists.push_back(prev != nullptr && prev->is_word("IN"));
+      continue;
+    }
+    if (token.is_punct(")")) {
+      // Unbalanced parentheses are left to the parser to report.
+      if (in_lists.empty()) {
+        literals->clear();
+        return;
+      }
+      in_lists.pop_back();
+      continue;
+    }
+    if (in_lists.empty() && is_where_clause_end(token)) in_where = false;
+    if (token.kind == Query_token::WORD) {
+      if (in_lists.empty() && token.is_word("WHERE")) in_where = true;
+      if (token.is_word("BETWEEN")) {
+        between_depth = in_lists.size();
+      } else if (token.is_word("AND") && between_depth == in_lists.size()) {
+        token.is_between_and = true;
+        between_depth = SIZE_MAX;
+      }
+      continue;
+    }
+    if (!in_where || prev == nullptr ||
+        (token.kind != Query_token::NUMBER &&
+         token.kind != Query_token::STRING) ||
+        !is_literal_operand(*prev, next,
+                            !in_lists.empty() && in_lists.back()))
+      continue;
+
+    Query_literal literal;
+    if (!make_query_literal(token, &literal)) continue;
+    rewritten.append(query.str + copied, token.str - query.str - copied);
+    rewritten.push_back('?');
+    copied = token.str + token.length - query.str;
+    literals->push_back(std::move(literal));
+  }
+  if (!in_lists.empty() || literals->empty()) {
+    literals->clear();
+    return;
+  }
+  rewritten.append(query.str + copied, query.length - copied);
+  *text = std::move(rewritten);
+}
+
+/**
+  Build the key that identifies an implicitly prepared query: the query text
+  with its literals replaced by parameter markers, the types of the
+  literals, and the session state that affects how the text is parsed and
+  resolved, i.e. the current database, the SQL mode, the character sets and
+  the variables that resolution depends on.
+*/
+
+static std::string prepared_query_key(
+    THD *thd, const std::string &text,
+    const std::vector<Query_literal> &literals) {
+  const System_variables &variables = thd->variables;
+  std::string key(text);
+  key.push_back('\0');
+  for (const Query_literal &literal : literals) {
+    key.push_back(static_cast<char>(literal.type));
+    key.push_back(literal.is_unsigned ? 'u' : 's');
+  }
+  key.push_back('\0');
+  if (thd->db().str != nullptr) key.append(thd->db().str, thd->db().length);
+  key.push_back('\0');
+  const ulonglong state[] = {
+      variables.sql_mode,
+      variables.character_set_client->number,
+      variables.collation_connection->number,
+      variables.default_collation_for_utf8mb4->number,
+      variables.div_precincrement,
+      variables.group_concat_max_len,
+      variables.optimizer_switch,
+      variables.option_bits & OPTION_AUTO_IS_NULL};
+  key.append(pointer_cast<const char *>(state), sizeof(state));
+  return key;
+}
+
+/**
+  Check that the parameters that replaced the literals of a query resolved
+  to types for which a parameter value behaves like the literal: numbers
+  must be compared as numbers, and strings as strings or temporal values.
+*/
+
+static bool literals_fit_parameters(
+    const Prepared_statement &stmt,
+    const std::vector<Query_literal> &literals) {
+  if (stmt.m_param_count != literals.size()) return false;
+  for (uint i = 0; i < stmt.m_param_count; i++) {
+    const bool is_string = literals[i].type == MYSQL_TYPE_STRING;
+    switch (stmt.m_param_array[i]->data_type()) {
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_INT24:
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_LONGLONG:
+      case MYSQL_TYPE_NEWDECIMAL:
+      case MYSQL_TYPE_FLOAT:
+      case MYSQL_TYPE_DOUBLE:
+        if (is_string) return false;
+        break;
+      case MYSQL_TYPE_VARCHAR:
+      case MYSQL_TYPE_STRING:
+      case MYSQL_TYPE_VAR_STRING:
+      case MYSQL_TYPE_TINY_BLOB:
+      case MYSQL_TYPE_MEDIUM_BLOB:
+      case MYSQL_TYPE_LONG_BLOB:
+      case MYSQL_TYPE_BLOB:
+      case MYSQL_TYPE_DATE:
+      case MYSQL_TYPE_TIME:
+      case MYSQL_TYPE_DATETIME:
+      case MYSQL_TYPE_TIMESTAMP:
+        if (!is_string) return false;
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+/**
+  Assign the literals of a query to the parameters of the statement that
+  was prepared for it, as COM_STMT_EXECUTE assigns the values it receives.
+*/
+
+static bool bind_query_literals(THD *thd, Prepared_statement *stmt,
+                                const std::vector<Query_literal> &literals) {
+  if (literals.empty()) return false;
+  std::vector<PS_PARAM> params(literals.size());
+  for (size_t i = 0; i < literals.size(); i++) {
+    params[i].null_bit = 0;
+    params[i].type = literals[i].type;
+    params[i].unsigned_type = literals[i].is_unsigned;
+    params[i].value = pointer_cast<const uchar *>(literals[i].value.data());
+    params[i].length = literals[i].value.length();
+    params[i].name = nullptr;
+    params[i].name_length = 0;
+  }
+  // The original query text is logged, not the expanded one.
+  String expanded_query;
+  return stmt->set_parameters(thd, &expanded_query, true, params.data());
+}
+
+/**
+  Report the digest of an implicitly prepared statement as the digest of the
+  current query, as the parser does for queries it parses.
+*/
+
+static void report_prepared_query_digest(THD *thd,
+                                         const Prepared_statement &stmt) {
+  if (thd->m_digest == nullptr) return;
+  thd->m_digest->m_digest_storage.copy(&stmt.digest());
+  PSI_digest_locker *locker = MYSQL_DIGEST_START(thd->m_statement_psi);
+  MYSQL_DIGEST_END(locker, &thd->m_digest->m_digest_storage);
+}
+
+Prepared_query_cache::Prepared_query_cache()
+    : m_statements(key_memory_prepared_statement_infrastructure),
+      m_lru(Malloc_allocator<std::string>(
+          key_memory_prepared_statement_infrastructure)) {}
+
+bool Prepared_query_cache::find_or_prepare(THD *thd,
+                                           Prepared_statement **stmt_out) {
+  *stmt_out = nullptr;
+  const ulong max_statements = thd->variables.prepared_query_cache_size;
+  if (max_statements == 0 || thd->bind_parameter_values_count > 0 ||
+      !is_single_select_query_text(thd->query()))
+    return false;
+
+  std::string text;
+  std::vector<Query_literal> literals;
+  parameterize_query(thd, &text, &literals);
+
+  std::string key = prepared_query_key(thd, text, literals);
+  const auto it = m_statements.find(key);
+  if (it != m_statements.end()) {
+    m_lru.splice(m_lru.begin(), m_lru, it->second.m_lru_position);
+    Prepared_statement *const stmt = it->second.m_stmt.get();
+    if (stmt == nullptr) return false;
+    if (bind_query_literals(thd, stmt, literals)) return true;
+    report_prepared_query_digest(thd, *stmt);
+    *stmt_out = stmt;
+    return false;
+  }
+
+  while (m_statements.size() >= max_statements) evict_least_recently_used();
+
+  std::unique_ptr<Prepared_statement> stmt(new Prepared_statement(thd));
+  if (stmt == nullptr) return false; /* out of memory */
+  stmt->set_sql_prepare();
+  stmt->set_implicit();
+
+  if (stmt->prepare(thd, text.data(), text.length(), nullptr)) {
+    /*
+      The statement was parsed and resolved as the regular path would do it,
+      so report the error instead of parsing the query again. The few
+      queries that cannot be prepared are remembered and parsed the regular
+      way from then on. Errors of a query whose literals were replaced would
+      show the parameter markers, so that query is parsed again to report
+      the error on the text that was sent.
+    */
+    if (!literals.empty()) {
+      thd->clear_error();
+      thd->get_stmt_da()->reset_condition_info(thd);
+      return false;
+    }
+    if (thd->get_stmt_da()->mysql_errno() != ER_UNSUPPORTED_PS) return true;
+    thd->clear_error();
+    thd->get_stmt_da()->reset_condition_info(thd);
+    stmt.reset();
+  } else if (!literals_fit_parameters(*stmt, literals) ||
+             stmt->m_lex->sql_command != SQLCOM_SELECT ||
+             stmt->m_lex->is_explain()) {
+    /*
+      Parameter markers are a syntax error in a query, literals must not
+      change meaning when passed as parameters, and other statements are not
+      cached: parse the query the regular way, from now on without preparing
+      it first.
+    */
+    thd->get_stmt_da()->reset_condition_info(thd);
+    stmt.reset();
+  }
+
+  Prepared_statement *const prepared = stmt.get();
+  m_lru.push_front(key);
+  m_statements.emplace(std::move(key), Entry{std::move(stmt), m_lru.begin()});
+  if (prepared == nullptr) return false;
+  if (bind_query_literals(thd, prepared, literals)) return true;
+  report_prepared_query_digest(thd, *prepared);
+  *stmt_out = prepared;
+  return false;
+}
+
+void Prepared_query_cache::evict_least_recently_used() {
+  assert(!m_lru.empty());
+  const auto victim = m_statements.find(m_lru.back());
+  assert(victim != m_statements.end());
+  assert(victim->second.m_stmt == nullptr ||
+         !victim->second.m_stmt->is_in_use());
+  m_statements.erase(victim);
+  m_lru.pop_back();
+}
+
+void Prepared_query_cache::claim_memory_ownership(bool claim) {
+  for (const auto &key_and_value : m_statements) {
+    if (key_and_value.second.m_stmt != nullptr)
+      my_claim(key_and_value.second.m_stmt.get(), claim);
+  }
+}
+
+void Prepared_query_cache::reset() {
+  m_statements.clear();
+  m_lru.clear();
+}
+
+Prepared_query_cache::~Prepared_query_cache() {
+  /*
+    reset() should already have been called, the statements must be
+    destroyed while the session is still valid.
+  */
+  assert(m_statements.empty());
+}
+
 /**
   Handle long data in pieces from client.
 
@@ -2464,7 +3020,7 @@ bool Prepared_statement::prepare(THD *thd, const char *query_str,
     However, it seems handy if com_stmt_prepare is increased always,
     no matter what kind of prepare is processed.
   */
-  thd->status_var.com_stmt_prepare++;
+  if (!m_is_implicit) thd->status_var.com_stmt_prepare++;
 
   assert(m_lex == nullptr);
 
@@ -2648,6 +3204,18 @@ bool Prepared_statement::prepare(THD *thd, const char *query_str,
   stmt_backup.restore_thd(thd, this);
   thd->stmt_arena = old_stmt_arena;
 
+  if (error == 0 && m_is_implicit) {
+    /* The token array is allocated in the statement arena. */
+    m_digest = digest.m_digest_storage;
+    m_prepare_conditions.clear();
+    Diagnostics_area::Sql_condition_iterator it =
+        thd->get_stmt_da()->sql_conditions();
+    const Sql_condition *cond;
+    while ((cond = it++))
+      m_prepare_conditions.push_back(
+          {cond->mysql_errno(), cond->severity(), cond->message_text()});
+  }
+
   if (error == 0) {
     setup_stmt_logging(thd);
     m_lex->context_analysis_only &= ~CONTEXT_ANALYSIS_ONLY_PREPARE;
@@ -2679,9 +3247,10 @@ bool Prepared_statement::prepare(THD *thd, const char *query_str,
       Do not print anything if this is an SQL prepared statement and
       we're inside a stored procedure (also called Dynamic SQL) --
       sub-statements inside stored procedures are not logged into
-      the general log.
+      the general log. Neither are statements prepared implicitly, the
+      query was already logged as COM_QUERY.
     */
-    if (thd->sp_runtime_ctx == nullptr) {
+    if (thd->sp_runtime_ctx == nullptr && !m_is_implicit) {
       if (thd->rewritten_query().length())
         query_logger.general_log_write(thd, COM_STMT_PREPARE,
                                        thd->rewritten_query().ptr(),
@@ -3364,6 +3933,10 @@ void Prepared_statement::swap_prepared_statement(Prepared_statement *copy) {
 
   // Need a new cursor, if requested
   std::swap(m_cursor, copy->m_cursor);
+
+  // The digest token array is allocated in the arena
+  std::swap(m_digest, copy->m_digest);
+  std::swap(m_prepare_conditions, copy->m_prepare_conditions);
 }
 
 /**
@@ -3415,7 +3988,7 @@ bool Prepared_statement::execute(THD *thd, String *expanded_query,
   assert(thd->change_list.is_empty());
   assert(thd->item_list() == nullptr);
 
-  thd->status_var.com_stmt_execute++;
+  if (!m_is_implicit) thd->status_var.com_stmt_execute++;
 
   /*
     Reset the diagnostics area.
@@ -3437,6 +4010,13 @@ bool Prepared_statement::execute(THD *thd, String *expanded_query,
   */
   thd->get_stmt_da()->reset_condition_info(thd);
 
+  /*
+    The query of an implicit statement is not parsed again, raise the
+    warnings parsing and resolving it raised.
+  */
+  for (const Prepare_condition &cond : m_prepare_conditions)
+    push_warning(thd, cond.m_level, cond.m_code, cond.m_message.c_str());
+
   if (open_cursor) {
     // Only DML statements may have assigned a cursor.
     if (sql_cmd == nullptr) {
@@ -3646,7 +4226,7 @@ bool Prepared_statement::execute(THD *thd, String *expanded_query,
     a hash of that hash.
   */
   rewrite_query(thd);
-  log_execute_line(thd);
+  if (!m_is_implicit) log_execute_line(thd);
 
   const char *display_query_string;
   int display_query_length;
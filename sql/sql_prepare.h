@@ -27,6 +27,8 @@
 #include <stddef.h>
 #include <sys/types.h>
 #include <new>
+#include <string>
+#include <vector>
 
 #include "lex_string.h"
 #include "my_alloc.h"
@@ -396,6 +398,22 @@ class Prepared_statement final {
   /// Flag that prevents recursive invocation of prepared statements
   bool m_in_use{false};
 
+  /// Flag that marks statements prepared implicitly by Prepared_query_cache
+  bool m_is_implicit{false};
+
+  /**
+    Digest of the query text and the conditions raised while parsing and
+    resolving it, for statements prepared implicitly. The query is not parsed
+    when the statement is executed, so these are reported instead.
+  */
+  sql_digest_storage m_digest;
+  struct Prepare_condition {
+    uint m_code;
+    Sql_condition::enum_severity_level m_level;
+    std::string m_message;
+  };
+  std::vector<Prepare_condition> m_prepare_conditions;
+
   bool m_with_log{false};
 
   bool m_first_execution{true};
@@ -434,6 +452,9 @@ class Prepared_statement final {
   bool is_in_use() const { return m_in_use; }
   bool is_sql_prepare() const { return m_is_sql_prepare; }
   void set_sql_prepare(bool prepare = true) { m_is_sql_prepare = prepare; }
+  bool is_implicit() const { return m_is_implicit; }
+  void set_implicit() { m_is_implicit = true; }
+  const sql_digest_storage &digest() const { return m_digest; }
   void deallocate(THD *thd);
   bool prepare(THD *thd, const char *packet, size_t packet_length,
                Item_param **orig_param_array);
@@ -94,6 +94,7 @@
 #include "sql/auth/auth_acls.h"
 #include "sql/auth/auth_common.h"  // validate_user_plugins
 #include "sql/binlog.h"            // mysql_bin_log
+#include "sql/binlog/compressing_cache_ostream.h"
 #include "sql/changestreams/apply/replication_thread_status.h"
 #include "sql/clone_handler.h"
 #include "sql/conn_handler/connection_handler_impl.h"  // Per_thread_connection_handler
@@ -111,6 +112,8 @@
 #include "sql/protocol_classic.h"
 #include "sql/psi_memory_key.h"
 #include "sql/query_options.h"
+#include "sql/result_cache.h"
+#include "sql/rpl_binlog_event_cache.h"
 #include "sql/rpl_group_replication.h"  // is_group_replication_running
 #include "sql/rpl_handler.h"            // delegates_update_lock_type
 #include "sql/rpl_info_factory.h"       // Rpl_info_factory
@@ -119,8 +122,11 @@
 #include "sql/rpl_mi.h"                 // Master_info
 #include "sql/rpl_msr.h"                // channel_map
 #include "sql/rpl_mta_submode.h"        // MTS_PARALLEL_TYPE_DB_NAME
+#include "sql/rpl_mta_writeset.h"  // opt_replica_writeset_dependency_tracking
 #include "sql/rpl_replica.h"            // SLAVE_THD_TYPE
 #include "sql/rpl_rli.h"                // Relay_log_info
+#include "sql/rpl_source.h"             // binlog_dump_sendfile_threshold
+#include "sql/rpl_utility.h"  // opt_replica_rows_hash_index_max_rows
 #include "sql/rpl_write_set_handler.h"  // transaction_write_set_hashing_algorithms
 #include "sql/server_component/log_builtins_filter_imp.h"  // until we have pluggable variables
 #include "sql/server_component/log_builtins_imp.h"
@@ -1194,6 +1200,33 @@ static Sys_var_ulong Sys_binlog_stmt_cache_size(
     NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(nullptr),
     ON_UPDATE(fix_binlog_stmt_cache_size));
 
+static bool fix_binlog_dump_cache_size(sys_var *, THD *, enum_var_type) {
+  binlog_event_cache.resize(binlog_dump_cache_size);
+  return false;
+}
+
+static Sys_var_ulonglong Sys_binlog_dump_cache_size(
+    "binlog_dump_cache_size",
+    "The amount of memory used to keep a copy of the most recent events of "
+    "the active binary log, from which dump threads close to the end of the "
+    "binary log send events instead of reading the file. Changing the value "
+    "empties the cache. A value of 0 disables the cache.",
+    GLOBAL_VAR(binlog_dump_cache_size), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(0, ULLONG_MAX), DEFAULT(0), BLOCK_SIZE(IO_SIZE),
+    NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(nullptr),
+    ON_UPDATE(fix_binlog_dump_cache_size));
+
+static Sys_var_ulong Sys_binlog_dump_sendfile_threshold(
+    "binlog_dump_sendfile_threshold",
+    "Binary log events of at least this size are sent by dump threads "
+    "straight from the binary log file with sendfile(), without copying "
+    "them to user space. This is only done for unencrypted binary logs, "
+    "on connections without TLS or compression, when source_verify_checksum "
+    "is disabled and no plugin observes the transmission. A value of 0 "
+    "disables it.",
+    GLOBAL_VAR(binlog_dump_sendfile_threshold), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(0, ULONG_MAX), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_int32 Sys_binlog_max_flush_queue_time(
     "binlog_max_flush_queue_time",
     "The maximum time that the binary log group commit will keep reading"
@@ -1223,6 +1256,17 @@ static Sys_var_ulong Sys_binlog_group_commit_sync_no_delay_count(
     CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 100000 /* max connections */),
     DEFAULT(0), BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG);
 
+static Sys_var_bool Sys_binlog_group_commit_sync_delay_adaptive(
+    "binlog_group_commit_sync_delay_adaptive",
+    "Compute the wait for the binary log group commit sync queue to fill "
+    "from the time a sync takes and the rate at which transactions commit. "
+    "There is no wait under light load. Otherwise the server waits for "
+    "about the time of a sync, or until the transactions expected in that "
+    "time are enqueued. binlog_group_commit_sync_delay and "
+    "binlog_group_commit_sync_no_delay_count, if set, bound the wait.",
+    GLOBAL_VAR(opt_binlog_group_commit_sync_delay_adaptive),
+    CMD_LINE(OPT_ARG), DEFAULT(false), NO_MUTEX_GUARD, NOT_IN_BINLOG);
+
 static bool check_outside_trx(sys_var *var, THD *thd, set_var *) {
   if (thd->in_active_multi_stmt_transaction()) {
     my_error(ER_VARIABLE_NOT_SETTABLE_IN_TRANSACTION, MYF(0), var->name.str);
@@ -1526,6 +1570,24 @@ static Sys_var_uint Sys_binlog_transaction_compression_level_zstd(
     BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG,
     ON_CHECK(check_binlog_trx_compression), ON_UPDATE(nullptr));
 
+static Sys_var_ulonglong Sys_binlog_transaction_compression_chunk_size(
+    "binlog_transaction_compression_chunk_size",
+    "When binlog_transaction_compression is enabled, compress a transaction "
+    "in chunks of this many bytes while it is written to the binary log "
+    "cache, instead of compressing the whole cache when the transaction "
+    "commits. 0 disables compression while writing.",
+    GLOBAL_VAR(opt_binlog_transaction_compression_chunk_size),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 1024 * 1024 * 1024), DEFAULT(0),
+    BLOCK_SIZE(1024), NO_MUTEX_GUARD, NOT_IN_BINLOG);
+
+static Sys_var_ulong Sys_binlog_transaction_compression_threads(
+    "binlog_transaction_compression_threads",
+    "Number of threads compressing the chunks of transactions set by "
+    "binlog_transaction_compression_chunk_size, while the sessions go on "
+    "executing them. With 0, sessions compress their own chunks.",
+    READ_ONLY GLOBAL_VAR(opt_binlog_transaction_compression_threads),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 256), DEFAULT(0), BLOCK_SIZE(1));
+
 static bool on_session_track_gtids_update(sys_var *, THD *thd, enum_var_type) {
   thd->session_tracker.get_tracker(SESSION_GTIDS_TRACKER)->update(thd);
   return false;
@@ -4034,14 +4096,54 @@ static Sys_var_ulong Sys_trans_prealloc_size(
     ON_UPDATE(nullptr), DEPRECATED_VAR(""));
 
 static const char *thread_handling_names[] = {
-    "one-thread-per-connection", "no-threads", "loaded-dynamically", nullptr};
+    "one-thread-per-connection", "no-threads", "pool-of-threads",
+    "loaded-dynamically", nullptr};
 static Sys_var_enum Sys_thread_handling(
     "thread_handling",
     "Define threads usage for handling queries, one of "
-    "one-thread-per-connection, no-threads, loaded-dynamically",
+    "one-thread-per-connection, no-threads, pool-of-threads, "
+    "loaded-dynamically",
     READ_ONLY GLOBAL_VAR(Connection_handler_manager::thread_handling),
     CMD_LINE(REQUIRED_ARG), thread_handling_names, DEFAULT(0));
 
+static Sys_var_uint Sys_thread_pool_size(
+    "thread_pool_size",
+    "Number of thread groups of the pool-of-threads connection handler, "
+    "each running about one query at a time. 0 means the number of CPUs",
+    READ_ONLY GLOBAL_VAR(Thread_pool_connection_handler::size),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 1024), DEFAULT(0), BLOCK_SIZE(1));
+
+static Sys_var_uint Sys_thread_pool_stall_limit(
+    "thread_pool_stall_limit",
+    "Milliseconds after which a thread group of the pool-of-threads "
+    "connection handler that made no progress lets one more query run",
+    GLOBAL_VAR(Thread_pool_connection_handler::stall_limit),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(10, 60000), DEFAULT(500),
+    BLOCK_SIZE(1));
+
+static Sys_var_uint Sys_thread_pool_oversubscribe(
+    "thread_pool_oversubscribe",
+    "Number of queries, in addition to one, a thread group of the "
+    "pool-of-threads connection handler may run at a time",
+    GLOBAL_VAR(Thread_pool_connection_handler::oversubscribe),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 1000), DEFAULT(3), BLOCK_SIZE(1));
+
+static Sys_var_uint Sys_thread_pool_max_threads(
+    "thread_pool_max_threads",
+    "Maximum number of worker threads of the pool-of-threads connection "
+    "handler",
+    GLOBAL_VAR(Thread_pool_connection_handler::max_threads),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(1, 100000), DEFAULT(100000),
+    BLOCK_SIZE(1));
+
+static Sys_var_uint Sys_thread_pool_idle_timeout(
+    "thread_pool_idle_timeout",
+    "Seconds after which an idle worker thread of the pool-of-threads "
+    "connection handler exits",
+    GLOBAL_VAR(Thread_pool_connection_handler::idle_timeout),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(1, UINT_MAX), DEFAULT(60),
+    BLOCK_SIZE(1));
+
 static Sys_var_charptr Sys_secure_file_priv(
     "secure_file_priv",
     "Limit LOAD DATA, SELECT ... OUTFILE, and LOAD_FILE() to files "
@@ -4141,6 +4243,15 @@ static Sys_var_set Sys_replica_type_conversions(
 static Sys_var_deprecated_alias Sys_slave_type_conversions(
     "slave_type_conversions", Sys_replica_type_conversions);
 
+static Sys_var_ulong Sys_replica_rows_hash_index_max_rows(
+    "replica_rows_hash_index_max_rows",
+    "Maximum number of row positions each replication applier keeps for "
+    "tables that have no usable index, so that rows changed by one row "
+    "event are read directly by later events instead of scanning the table "
+    "again. 0 disables it.",
+    GLOBAL_VAR(opt_replica_rows_hash_index_max_rows), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(0, ULONG_MAX), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_bool Sys_replica_sql_verify_checksum(
     "replica_sql_verify_checksum",
     "Force checksum verification of replication events after reading them "
@@ -4289,6 +4400,18 @@ static Sys_var_bool Sys_replica_preserve_commit_order(
 static Sys_var_deprecated_alias Sys_slave_preserve_commit_order(
     "slave_preserve_commit_order", Sys_replica_preserve_commit_order);
 
+static Sys_var_bool Sys_replica_writeset_dependency_tracking(
+    "replica_writeset_dependency_tracking",
+    "When using replica_parallel_type=LOGICAL_CLOCK, compute the "
+    "dependencies between replicated transactions from the primary keys of "
+    "the rows they change, and let a transaction start as soon as the "
+    "transactions it conflicts with have committed, even when its commit "
+    "parent on the source is more recent. The number of keys remembered is "
+    "limited by binlog_transaction_dependency_history_size.",
+    GLOBAL_VAR(opt_replica_writeset_dependency_tracking), CMD_LINE(OPT_ARG),
+    DEFAULT(false), NO_MUTEX_GUARD, NOT_IN_BINLOG,
+    ON_CHECK(check_slave_stopped), ON_UPDATE(nullptr));
+
 bool Sys_var_charptr::global_update(THD *, set_var *var) {
   char *new_val, *ptr = var->save_result.string_value.str;
   size_t len = var->save_result.string_value.length;
@@ -5154,6 +5277,14 @@ static Sys_var_ulong Sys_thread_cache_size(
     DEFAULT(0), BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, nullptr,
     ON_UPDATE(modify_thread_cache_size));
 
+static Sys_var_bool Sys_thread_cache_reuse_sessions(
+    "thread_cache_reuse_sessions",
+    "Let a thread kept in the thread cache reset the session of its last "
+    "connection and reuse it for the next one, instead of destroying it "
+    "and creating a new one",
+    GLOBAL_VAR(Per_thread_connection_handler::reuse_sessions),
+    CMD_LINE(OPT_ARG), DEFAULT(false));
+
 /**
   Function to check if the 'next' transaction isolation level
   can be changed.
@@ -6203,6 +6334,16 @@ static Sys_var_bool Sys_relay_log_purge(
     "if enabled - purge them as soon as they are no more needed",
     GLOBAL_VAR(relay_log_purge), CMD_LINE(OPT_ARG), DEFAULT(true));
 
+static Sys_var_ulonglong Sys_relay_log_event_cache_size(
+    "relay_log_event_cache_size",
+    "Size of the copy of the tail of the active relay log that each "
+    "replication channel keeps in memory. The applier takes the events the "
+    "receiver has just written from it instead of reading them back from the "
+    "relay log file, which is still written for crash safety. A new value "
+    "takes effect with the next relay log file. A value of 0 disables it.",
+    GLOBAL_VAR(relay_log_event_cache_size), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(0, ULLONG_MAX), DEFAULT(0), BLOCK_SIZE(IO_SIZE));
+
 static Sys_var_bool Sys_relay_log_recovery(
     "relay_log_recovery",
     "If enabled, existing relay logs will be skipped by the "
@@ -6577,6 +6718,40 @@ static Sys_var_ulong Sys_sp_cache_size(
     GLOBAL_VAR(stored_program_cache_size), CMD_LINE(REQUIRED_ARG),
     VALID_RANGE(16, 512 * 1024), DEFAULT(256), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_prepared_query_cache_size(
+    "prepared_query_cache_size",
+    "The number of SELECT statements received as text queries that are "
+    "kept prepared for the connection, so that a query can skip parsing "
+    "and name resolution when it is sent again, also with other literals "
+    "in the predicates of its WHERE clause. "
+    "A value of 0 disables the cache.",
+    SESSION_VAR(prepared_query_cache_size), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(0, 1024), DEFAULT(0), BLOCK_SIZE(1));
+
+static bool fix_query_result_cache_size(sys_var *, THD *, enum_var_type) {
+  result_cache.resize();
+  return false;
+}
+
+static Sys_var_ulonglong Sys_query_result_cache_size(
+    "query_result_cache_size",
+    "The amount of memory used to cache result sets of SELECT statements "
+    "executed with query_result_cache enabled. Changing the value empties "
+    "the cache. A value of 0 disables the cache.",
+    GLOBAL_VAR(query_result_cache_size), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(0, ULLONG_MAX), DEFAULT(0), BLOCK_SIZE(1024), NO_MUTEX_GUARD,
+    NOT_IN_BINLOG, ON_CHECK(nullptr), ON_UPDATE(fix_query_result_cache_size));
+
+static Sys_var_bool Sys_query_result_cache(
+    "query_result_cache",
+    "Store the result sets of SELECT statements in the query result cache. "
+    "Usually enabled per statement with a SET_VAR hint. Results are only "
+    "cached for statements that read committed data as of statement start, "
+    "and only for deterministic queries on base tables without warnings. "
+    "Locking reads are never cached.",
+    HINT_UPDATEABLE SESSION_VAR(query_result_cache), CMD_LINE(OPT_ARG),
+    DEFAULT(false));
+
 static bool check_pseudo_replica_mode(sys_var *self, THD *thd, set_var *var) {
   if (check_session_admin_or_replication_applier(self, thd, var)) return true;
   if (check_outside_trx(self, thd, var)) return true;
@@ -221,6 +221,7 @@ struct System_variables {
   ulonglong long_query_time;
   bool end_markers_in_json;
   bool windowing_use_high_precision;
+  bool query_result_cache;
   /* A bitmap for switching optimizations on/off */
   ulonglong optimizer_switch;
   ulonglong optimizer_trace;           ///< bitmap to tune optimizer tracing
@@ -264,6 +265,7 @@ struct System_variables {
   ulong div_precincrement;
   ulong sortbuff_size;
   ulong max_sp_recursion_depth;
+  ulong prepared_query_cache_size;
   ulong default_week_format;
   ulong max_seeks_for_key;
   ulong range_alloc_block_size;
@@ -55,6 +55,7 @@
 #include "sql/mysqld.h"          // mysql_data_home
 #include "sql/psi_memory_key.h"  // key_memory_TC_LOG_MMAP_pages
 #include "sql/raii/sentry.h"     // raii::Sentry<>
+#include "sql/result_cache.h"  // result_cache
 #include "sql/rpl_handler.h"     // RUN_HOOK
 #include "sql/sql_class.h"       // THD
 #include "sql/sql_const.h"
@@ -115,6 +116,8 @@ bool trx_coordinator::commit_detached_by_xid(THD *thd, bool run_after_commit) {
 
   auto error = plugin_foreach(thd, ::commit_one_ht, MYSQL_STORAGE_ENGINE_PLUGIN,
                               const_cast<XID *>(xs->get_xid()));
+  /* The tables changed by the prepared transaction are not known here. */
+  result_cache.invalidate_all();
 
   if (run_after_commit && trx_ctx->m_flags.run_hooks) {
     if (!error) (void)RUN_HOOK(transaction, after_commit, (thd, true));
@@ -35,6 +35,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 
 #include "clone0api.h"
 #include "clone0clone.h"
+#include "clone0incr.h"
 #include "os0thread-create.h"
 
 #include "sql/clone_handler.h"
@@ -906,8 +907,22 @@ int innodb_clone_apply_begin(handlerton *, THD *thd, const byte *&loc,
                  "Clone cannot replace data with innodb_read_only = ON");
         ut_d(ut_error);
       } else {
-        track_redo_files();
-        err = clone_drop_user_data(thd, false);
+        /* Check donor reply to incremental clone request. */
+        clone_incr_begin_apply(loc, loc_len);
+
+        /* Check the kept tablespaces before dropping anything, so that
+        user data is kept if the incremental clone cannot go on. */
+        err = clone_incr_check_base();
+
+        if (err == 0) {
+          track_redo_files();
+          err = clone_drop_user_data(thd, false);
+        }
+
+        /* Check again for changes made till the data was dropped. */
+        if (err == 0) {
+          err = clone_incr_check_base();
+        }
         if (err != 0) {
           clone_files_error();
         }
@@ -943,6 +958,11 @@ int innodb_clone_apply_begin(handlerton *, THD *thd, const byte *&loc,
   if (mode != HA_CLONE_MODE_ADD_TASK) {
     loc = clone_hdl->get_locator(loc_len);
   }
+
+  /* Request incremental clone if the data directory is replaced. */
+  if (mode == HA_CLONE_MODE_VERSION && clone_hdl->replace_datadir()) {
+    clone_incr_add_request(loc, loc_len);
+  }
   return (0);
 }
 
@@ -36,6 +36,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "buf0dump.h"
 #include "clone0api.h"
 #include "clone0clone.h"
+#include "clone0incr.h"
 #include "dict0dict.h"
 #include "log0files_io.h"
 #include "sql/handler.h"
@@ -1057,8 +1058,39 @@ int Clone_Handle::set_compression(Clone_file_ctx *file_ctx) {
 
 int Clone_Handle::file_create_init(const Clone_file_ctx *file_ctx,
                                    ulint file_type, bool init) {
+  const auto meta = file_ctx->get_file_meta_read();
+
+  /* Use the file kept from previous clone. Only modified pages are sent. */
+  if (meta->m_incremental) {
+    std::string file_name;
+    file_ctx->get_file_name(file_name);
+
+    auto err = clone_incr_use_base(meta, file_name);
+
+    if (err != 0) {
+      return err;
+    }
+  }
+
   /* Create the file and path. */
   File_init_cbk init_cbk = [&](pfs_os_file_t file) {
+    if (meta->m_incremental) {
+      std::string file_name;
+      file_ctx->get_file_name(file_name);
+
+      /* Match the size of the donor file. */
+      auto cur_size = os_file_get_size(file);
+      bool success = true;
+
+      if (cur_size < meta->m_file_size) {
+        success = os_file_set_size(file_name.c_str(), file, cur_size,
+                                   meta->m_file_size, true);
+      } else if (cur_size > meta->m_file_size) {
+        success = os_file_truncate(file_name.c_str(), file, meta->m_file_size);
+      }
+      return success ? DB_SUCCESS : DB_ERROR;
+    }
+
     if (!init) {
       return DB_SUCCESS;
     }
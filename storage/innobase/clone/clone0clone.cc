@@ -31,6 +31,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
  *******************************************************/
 
 #include "clone0clone.h"
+#include "clone0incr.h"
 #include <string>
 #ifdef UNIV_DEBUG
 #include "current_thd.h" /* current_thd */
@@ -2040,6 +2041,15 @@ int Clone_Handle::init(const byte *ref_loc, uint ref_len, Ha_clone_type type,
     ut_ad(snapshot_id != CLONE_LOC_INVALID_ID);
   }
 
+  /* Check if the recipient requests incremental clone. */
+  Clone_Desc_Incremental incr_request;
+  bool incremental = false;
+
+  if (is_copy_clone() && ref_loc != nullptr) {
+    incremental = clone_incr_check_request(ref_loc, ref_len, type,
+                                           incr_request, m_incr_reply);
+  }
+
   /* Create and attach to snapshot. */
   auto err = clone_sys->attach_snapshot(m_clone_handle_type, type, snapshot_id,
                                         enable_monitor, snapshot);
@@ -2048,6 +2058,10 @@ int Clone_Handle::init(const byte *ref_loc, uint ref_len, Ha_clone_type type,
     return (err);
   }
 
+  if (incremental) {
+    snapshot->set_incremental(incr_request);
+  }
+
   /* Initialize clone task manager. */
   m_clone_task_manager.init(snapshot);
 
@@ -2077,6 +2091,16 @@ byte *Clone_Handle::get_locator(uint &loc_len) {
 
   snapshot->release_heap(heap);
 
+  /* Append reply to incremental clone request. */
+  if (!m_incr_reply.empty()) {
+    m_incr_locator.assign(m_clone_locator, m_clone_locator + loc_len);
+    m_incr_locator.insert(m_incr_locator.end(), m_incr_reply.begin(),
+                          m_incr_reply.end());
+
+    loc_len = static_cast<uint>(m_incr_locator.size());
+    return (m_incr_locator.data());
+  }
+
   return (m_clone_locator);
 }
 
@@ -32,6 +32,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 
 #include "buf0dump.h"
 #include "clone0clone.h"
+#include "clone0incr.h"
 #include "dict0dict.h"
 #include "fsp0sysspace.h"
 #include "sql/binlog.h"
@@ -206,6 +207,9 @@ int Clone_Snapshot::init_file_copy(Snapshot_State new_state) {
 
   } else if (m_snapshot_type == HA_CLONE_HYBRID ||
              m_snapshot_type == HA_CLONE_PAGE) {
+    /* Keep tracking for incremental clone from this donor. */
+    clone_incr_track_pages();
+
     /* Start modified Page ID Archiving */
     err = m_page_ctx.start(false, nullptr);
   } else {
@@ -312,6 +316,10 @@ int Clone_Snapshot::init_page_copy(Snapshot_State new_state, byte *page_buffer,
   err = m_page_ctx.get_pages(add_page_callback, context, page_buffer,
                              page_buffer_len);
 
+  if (err == 0 && m_incr_lsn != 0) {
+    err = add_incremental_pages(page_buffer, page_buffer_len);
+  }
+
   m_page_vector.assign(m_page_set.begin(), m_page_set.end());
 
   aligned_size = ut_calc_align(m_num_pages, chunk_size());
@@ -758,14 +766,23 @@ int Clone_Snapshot::add_file(const char *name, uint64_t size_bytes,
 
   if (file_ctx == nullptr) {
     uint32_t num_chunks = 0;
+
+    /* No data is sent for a file kept by the recipient. */
+    bool incremental = !by_ddl && node != nullptr && is_incremental(node);
+
     /* Build file metadata entry and add to data file vector. */
-    file_ctx = build_file(name, size_bytes, 0, num_chunks);
+    file_ctx = build_file(name, incremental ? 0 : size_bytes, 0, num_chunks);
 
     if (file_ctx == nullptr) {
       return (ER_OUTOFMEMORY); /* purecov: inspected */
     }
     auto file_meta = file_ctx->get_file_meta();
 
+    if (incremental) {
+      file_meta->m_file_size = size_bytes;
+      file_meta->m_incremental = true;
+    }
+
     file_meta->m_alloc_size = alloc_bytes;
     file_meta->m_file_index = num_data_files();
     m_data_file_vector.push_back(file_ctx);
@@ -901,7 +918,7 @@ dberr_t Clone_Snapshot::add_node(fil_node_t *node, bool by_ddl) {
   }
 
   /* Update estimation */
-  if (!by_ddl) {
+  if (!by_ddl && !is_incremental(node)) {
     m_data_bytes_disk += alloc_size;
     m_monitor.add_estimate(size_bytes);
   }
@@ -938,6 +955,98 @@ int Clone_Snapshot::add_page(space_id_t space_id, uint32_t page_num) {
   return (0);
 }
 
+bool Clone_Snapshot::is_incremental(const fil_node_t *node) const {
+  auto space = node->space;
+
+  return m_incr_lsn != 0 && m_incr_spaces.count(space->id) != 0 &&
+         clone_incr_can_keep(space, m_incr_max_space_id);
+}
+
+bool Clone_Snapshot::is_incremental_page(space_id_t space_id,
+                                         uint32_t page_num) const {
+  auto it = m_data_file_map.find(space_id);
+
+  if (it == m_data_file_map.end() || it->second == 0) {
+    return false;
+  }
+
+  auto file_meta = m_data_file_vector[it->second - 1]->get_file_meta_read();
+
+  if (!file_meta->m_incremental) {
+    return false;
+  }
+
+  /* Pages beyond the file are not there on the recipient after clone. */
+  const page_size_t page_size(file_meta->m_fsp_flags);
+
+  return page_num < file_meta->m_file_size / page_size.physical();
+}
+
+/** Callback to collect page IDs tracked since previous clone.
+@param[in]      buff            buffer having page IDs
+@param[in]      num_pages       number of tracked pages
+@param[in,out]  context         page IDs with tablespace ID in the high bits
+@return error code */
+static int add_incremental_page_callback(MYSQL_THD, const unsigned char *buff,
+                                         size_t, int num_pages,
+                                         void *context) {
+  auto pages = static_cast<std::vector<uint64_t> *>(context);
+
+  for (int index = 0; index < num_pages; ++index) {
+    uint64_t space_id = mach_read_from_4(buff);
+    auto page_num = mach_read_from_4(buff + 4);
+    buff += 8;
+
+    pages->push_back(space_id << 32 | page_num);
+  }
+
+  return (0);
+}
+
+int Clone_Snapshot::add_incremental_pages(byte *page_buffer,
+                                          uint page_buffer_len) {
+  /* Pages modified by the recipient since it was cloned. */
+  auto pages = std::move(m_incr_pages);
+
+  /* Pages modified here since the recipient was cloned. */
+  lsn_t start_lsn = m_incr_lsn;
+  lsn_t stop_lsn = 0;
+
+  auto err = arch_page_sys->get_pages(nullptr, add_incremental_page_callback,
+                                      &pages, start_lsn, stop_lsn,
+                                      page_buffer, page_buffer_len);
+
+  if (err != 0) {
+    my_error(ER_INTERNAL_ERROR, MYF(0),
+             "Clone: pages modified since previous clone are not tracked");
+    return ER_INTERNAL_ERROR;
+  }
+
+  uint64_t num_pages = 0;
+
+  for (auto page : pages) {
+    auto space_id = static_cast<space_id_t>(page >> 32);
+    auto page_num = static_cast<uint32_t>(page);
+
+    if (!is_incremental_page(space_id, page_num)) {
+      continue;
+    }
+
+    err = add_page(space_id, page_num);
+
+    if (err != 0) {
+      return err; /* purecov: inspected */
+    }
+    ++num_pages;
+  }
+
+  ib::info(ER_IB_CLONE_OPERATION)
+      << "Clone incremental from LSN " << m_incr_lsn << " : " << num_pages
+      << " pages of " << m_incr_spaces.size() << " kept tablespaces";
+
+  return 0;
+}
+
 int Clone_Snapshot::add_redo_file(char *file_name, uint64_t file_size,
                                   uint64_t file_offset) {
   ut_ad(m_snapshot_handle_type == CLONE_HDL_COPY);
@@ -33,6 +33,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "clone0desc.h"
 #include "dict0dict.h"
 #include "mach0data.h"
+#include "sql/sql_const.h"
 
 /** Maximum supported descriptor version. The version represents the current
 set of descriptors and its elements. */
@@ -632,6 +633,8 @@ static const uint CLONE_DESC_FILE_FLAG_RENAMED = 4;
 static const uint CLONE_DESC_FILE_FLAG_DELETED = 5;
 /** Clone File Flag: File metadata has encryption key. */
 static const uint CLONE_DESC_FILE_HAS_KEY = 6;
+/** Clone File Flag: File is kept from previous clone. */
+static const uint CLONE_DESC_FILE_FLAG_INCREMENTAL = 7;
 
 /** File Metadata: Tablespace ID in 4 bytes */
 static const uint CLONE_FILE_SPACE_ID_OFFSET = CLONE_FILE_FLAGS_OFFSET + 2;
@@ -716,6 +719,11 @@ void Clone_Desc_File_MetaData::serialize(byte *&desc_file, uint &len,
     DESC_SET_FLAG(file_flags, CLONE_DESC_FILE_HAS_KEY);
   }
 
+  /* Set incremental file attribute */
+  if (m_file_meta.m_incremental) {
+    DESC_SET_FLAG(file_flags, CLONE_DESC_FILE_FLAG_INCREMENTAL);
+  }
+
   mach_write_to_2(desc_file + CLONE_FILE_FLAGS_OFFSET, file_flags);
 
   mach_write_to_4(desc_file + CLONE_FILE_SPACE_ID_OFFSET,
@@ -802,6 +810,10 @@ bool Clone_Desc_File_MetaData::deserialize(const byte *desc_file,
   m_file_meta.m_deleted =
       DESC_CHECK_FLAG(file_flags, CLONE_DESC_FILE_FLAG_DELETED);
 
+  /* Get incremental file attribute */
+  m_file_meta.m_incremental =
+      DESC_CHECK_FLAG(file_flags, CLONE_DESC_FILE_FLAG_INCREMENTAL);
+
   m_file_meta.m_space_id =
       mach_read_from_4(desc_file + CLONE_FILE_SPACE_ID_OFFSET);
   m_file_meta.m_file_index =
@@ -1087,9 +1099,131 @@ void Clone_File_Meta::init() {
   m_fsblk_size = 0;
 
   m_transfer_encryption_key = false;
+  m_incremental = false;
 
   m_begin_chunk = 0;
   m_end_chunk = 0;
 
   reset_ddl();
 }
+
+/** Incremental: Donor server UUID in UUID_LENGTH bytes */
+static const uint CLONE_INCR_UUID_OFFSET = CLONE_DESC_HEADER_LEN;
+
+/** Incremental: Base LSN in 8 bytes */
+static const uint CLONE_INCR_LSN_OFFSET = CLONE_INCR_UUID_OFFSET + UUID_LENGTH;
+
+/** Incremental: Maximum tablespace ID in 4 bytes */
+static const uint CLONE_INCR_MAX_SPACE_OFFSET = CLONE_INCR_LSN_OFFSET + 8;
+
+/** Incremental: Accepted by donor in 4 bytes */
+static const uint CLONE_INCR_ACCEPTED_OFFSET = CLONE_INCR_MAX_SPACE_OFFSET + 4;
+
+/** Incremental: Number of tablespaces in 4 bytes */
+static const uint CLONE_INCR_NSPACES_OFFSET = CLONE_INCR_ACCEPTED_OFFSET + 4;
+
+/** Incremental: Number of pages in 4 bytes */
+static const uint CLONE_INCR_NPAGES_OFFSET = CLONE_INCR_NSPACES_OFFSET + 4;
+
+/** Incremental: Length excluding tablespace IDs and pages */
+static const uint CLONE_INCR_BASE_LEN = CLONE_INCR_NPAGES_OFFSET + 4;
+
+void Clone_Desc_Incremental::init_header(uint version) {
+  m_header.m_version = version;
+
+  m_header.m_length = CLONE_INCR_BASE_LEN;
+  m_header.m_length += static_cast<uint>(4 * m_spaces.size());
+  m_header.m_length += static_cast<uint>(8 * m_pages.size());
+
+  m_header.m_type = CLONE_DESC_INCREMENTAL;
+}
+
+void Clone_Desc_Incremental::serialize(byte *desc_incr, uint len) {
+  ut_a(len >= m_header.m_length);
+
+  m_header.serialize(desc_incr);
+
+  memset(desc_incr + CLONE_INCR_UUID_OFFSET, 0, UUID_LENGTH);
+  memcpy(desc_incr + CLONE_INCR_UUID_OFFSET, m_donor_uuid.c_str(),
+         std::min(m_donor_uuid.length(), static_cast<size_t>(UUID_LENGTH)));
+
+  mach_write_to_8(desc_incr + CLONE_INCR_LSN_OFFSET, m_base_lsn);
+  mach_write_to_4(desc_incr + CLONE_INCR_MAX_SPACE_OFFSET, m_max_space_id);
+  mach_write_to_4(desc_incr + CLONE_INCR_ACCEPTED_OFFSET, m_accepted ? 1 : 0);
+
+  mach_write_to_4(desc_incr + CLONE_INCR_NSPACES_OFFSET, m_spaces.size());
+  mach_write_to_4(desc_incr + CLONE_INCR_NPAGES_OFFSET, m_pages.size());
+
+  auto ptr = desc_incr + CLONE_INCR_BASE_LEN;
+
+  for (auto space_id : m_spaces) {
+    mach_write_to_4(ptr, space_id);
+    ptr += 4;
+  }
+
+  for (auto page : m_pages) {
+    mach_write_to_8(ptr, page);
+    ptr += 8;
+  }
+}
+
+bool Clone_Desc_Incremental::deserialize(const byte *desc_incr,
+                                         uint desc_len) {
+  /* Deserialize the header and validate type and length. */
+  if (desc_len < CLONE_INCR_BASE_LEN ||
+      !m_header.deserialize(desc_incr, desc_len) ||
+      m_header.m_type != CLONE_DESC_INCREMENTAL ||
+      m_header.m_length > desc_len) {
+    return (false);
+  }
+
+  auto uuid = reinterpret_cast<const char *>(desc_incr) +
+              CLONE_INCR_UUID_OFFSET;
+  m_donor_uuid.assign(uuid, strnlen(uuid, UUID_LENGTH));
+
+  m_base_lsn = mach_read_from_8(desc_incr + CLONE_INCR_LSN_OFFSET);
+  m_max_space_id = mach_read_from_4(desc_incr + CLONE_INCR_MAX_SPACE_OFFSET);
+  m_accepted = mach_read_from_4(desc_incr + CLONE_INCR_ACCEPTED_OFFSET) != 0;
+
+  uint64_t num_spaces = mach_read_from_4(desc_incr + CLONE_INCR_NSPACES_OFFSET);
+  uint64_t num_pages = mach_read_from_4(desc_incr + CLONE_INCR_NPAGES_OFFSET);
+
+  /* Check if we have enough length. */
+  if (CLONE_INCR_BASE_LEN + 4 * num_spaces + 8 * num_pages >
+      m_header.m_length) {
+    return (false);
+  }
+
+  auto ptr = desc_incr + CLONE_INCR_BASE_LEN;
+
+  m_spaces.clear();
+  m_spaces.reserve(num_spaces);
+
+  for (uint64_t index = 0; index < num_spaces; ++index) {
+    m_spaces.push_back(mach_read_from_4(ptr));
+    ptr += 4;
+  }
+
+  m_pages.clear();
+  m_pages.reserve(num_pages);
+
+  for (uint64_t index = 0; index < num_pages; ++index) {
+    m_pages.push_back(mach_read_from_8(ptr));
+    ptr += 8;
+  }
+
+  return (true);
+}
+
+bool clone_get_incremental(const byte *desc_loc, uint desc_len,
+                           Clone_Desc_Incremental &desc_incr) {
+  Clone_Desc_Header header;
+
+  if (desc_loc == nullptr || !header.deserialize(desc_loc, desc_len) ||
+      header.m_length >= desc_len) {
+    return (false);
+  }
+
+  return (desc_incr.deserialize(desc_loc + header.m_length,
+                                desc_len - header.m_length));
+}
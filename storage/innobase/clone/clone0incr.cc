@@ -0,0 +1,547 @@
+/*****************************************************************************
+
+Copyright (c) 2024, Oracle and/or its affiliates.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License, version 2.0, as published by the
+Free Software Foundation.
+
+This program is designed to work with certain software (including
+but not limited to OpenSSL) that is licensed under separate terms,
+as designated in a particular file or component or in included license
+documentation.  The authors of MySQL hereby grant you an additional
+permission to link the program and your derivative works with the
+separately licensed software that they have either included with
+the program or referenced in the documentation.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License, version 2.0,
+for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+
+*****************************************************************************/
+
+/** @file clone/clone0incr.cc
+ Innodb incremental clone
+
+ *******************************************************/
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+
+#include "arch0page.h"
+#include "clone0clone.h"
+#include "clone0incr.h"
+#include "dict0boot.h"
+#include "log0chkp.h"
+#include "mtr0log.h"
+#include "sql/mysqld.h"
+#include "srv0srv.h"
+
+/** Value of innodb_clone_incremental_base. */
+static char clone_incr_base_uuid[UUID_LENGTH + 1];
+
+char *srv_clone_incremental_base = clone_incr_base_uuid;
+
+/** Maximum number of modified pages a recipient sends. Beyond it the clone
+is not incremental. */
+static const size_t CLONE_INCR_MAX_PAGES = 128 * 1024;
+
+/** Length of buffer for reading tracked pages. */
+static const uint CLONE_INCR_PAGE_BUFFER_LEN = 64 * 1024;
+
+/** Base for incremental clone, saved in CLONE_INNODB_BASE_FILE. */
+struct Clone_Incr_Base {
+  /** Read the base.
+  @return true, if successful. */
+  bool read() {
+    std::ifstream file(CLONE_INNODB_BASE_FILE);
+
+    if (!file.is_open()) {
+      return false;
+    }
+    file >> m_donor_uuid >> m_lsn >> m_max_space_id >> m_track_lsn;
+
+    return !file.fail() && m_donor_uuid.length() == UUID_LENGTH;
+  }
+
+  /** Write the base.
+  @return true, if successful. */
+  bool write() const {
+    std::ofstream file(CLONE_INNODB_BASE_FILE);
+
+    if (!file.is_open()) {
+      return false;
+    }
+    file << m_donor_uuid << " " << m_lsn << " " << m_max_space_id << " "
+         << m_track_lsn << std::endl;
+
+    return file.good();
+  }
+
+  /** Server UUID of the donor */
+  std::string m_donor_uuid;
+
+  /** LSN the data directory was cloned at */
+  lsn_t m_lsn{};
+
+  /** Maximum tablespace ID at m_lsn */
+  space_id_t m_max_space_id{};
+
+  /** LSN the recipient started tracking modified pages at */
+  lsn_t m_track_lsn{};
+};
+
+/** Incremental clone requested by the recipient. It is set when sending the
+version locator and used till user data is dropped and the kept files are
+put in place. Only the master task of a clone replacing the data directory
+uses it and there is at most one. */
+struct Clone_Incr_Request {
+  /** Remove the kept files not used and forget the request. */
+  void clear() {
+    for (auto &file : m_files) {
+      os_file_delete_if_exists(innodb_clone_file_key, file.second.c_str(),
+                               nullptr);
+    }
+    m_files.clear();
+    m_pages.clear();
+    m_donor_uuid.clear();
+    m_check_lsn = 0;
+  }
+
+  /** Server UUID of the donor */
+  std::string m_donor_uuid;
+
+  /** Page tracking reset point when the modified pages were collected */
+  lsn_t m_check_lsn{};
+
+  /** Kept data files linked in clone directory by tablespace ID */
+  std::map<space_id_t, std::string> m_files;
+
+  /** Modified pages sent to the donor */
+  std::set<uint64_t> m_pages;
+
+  /** Version locator with the request appended */
+  std::vector<byte> m_locator;
+};
+
+static Clone_Incr_Request clone_incr_request;
+
+/** Context for collecting modified pages of kept tablespaces. */
+struct Clone_Incr_Pages {
+  /** Kept tablespaces */
+  const std::map<space_id_t, std::string> *m_files;
+
+  /** Modified pages */
+  std::set<uint64_t> m_pages;
+
+  /** Set if there are too many modified pages */
+  bool m_overflow{false};
+};
+
+/** Page tracking callback collecting modified pages of kept tablespaces.
+@param[in]      buffer          page IDs
+@param[in]      num_pages       number of page IDs
+@param[in,out]  context         Clone_Incr_Pages
+@return error code */
+static int clone_incr_add_pages(MYSQL_THD, const unsigned char *buffer,
+                                size_t, int num_pages, void *context) {
+  auto pages = static_cast<Clone_Incr_Pages *>(context);
+
+  for (int index = 0; index < num_pages; ++index) {
+    auto space_id = mach_read_from_4(buffer);
+    auto page_no = mach_read_from_4(buffer + 4);
+    buffer += 8;
+
+    if (pages->m_files->count(space_id) == 0) {
+      continue;
+    }
+    pages->m_pages.insert(static_cast<uint64_t>(space_id) << 32 | page_no);
+
+    if (pages->m_pages.size() > CLONE_INCR_MAX_PAGES) {
+      pages->m_overflow = true;
+      return ER_INTERNAL_ERROR;
+    }
+  }
+  return 0;
+}
+
+/** Collect pages of kept tablespaces modified since an LSN. Modified pages
+in buffer pool are flushed first.
+@param[in]      start_lsn       collect from this LSN
+@param[in,out]  pages           modified pages
+@return true, if successful. */
+static bool clone_incr_get_pages(lsn_t start_lsn, Clone_Incr_Pages &pages) {
+  /* Pages are tracked when flushed. */
+  log_make_latest_checkpoint();
+
+  std::vector<byte> buffer(CLONE_INCR_PAGE_BUFFER_LEN);
+  lsn_t stop_lsn = 0;
+
+  auto err = arch_page_sys->get_pages(nullptr, clone_incr_add_pages, &pages,
+                                      start_lsn, stop_lsn, buffer.data(),
+                                      CLONE_INCR_PAGE_BUFFER_LEN);
+
+  return err == 0 && !pages.m_overflow;
+}
+
+bool clone_incr_can_keep(const fil_space_t *space, space_id_t max_space_id) {
+  if (space->purpose != FIL_TYPE_TABLESPACE ||
+      !fsp_is_ibd_tablespace(space->id) || fsp_is_dd_tablespace(space->id) ||
+      space->id > max_space_id ||
+      space->is_deleted() || space->files.size() != 1) {
+    return false;
+  }
+
+  /* Pages of these are not written as they are in buffer pool. */
+  const page_size_t page_size(space->flags);
+
+  return !space->can_encrypt() &&
+         space->encryption_op_in_progress == Encryption::Progress::NONE &&
+         space->compression_type == Compression::NONE &&
+         !page_size.is_compressed();
+}
+
+void clone_incr_boot(lsn_t clone_lsn) {
+  /* Option processing may have set it to the default value. */
+  srv_clone_incremental_base = clone_incr_base_uuid;
+  clone_incr_base_uuid[0] = '\0';
+
+  if (srv_read_only_mode) {
+    return;
+  }
+
+  if (!os_file_exists(CLONE_FILES_DIR)) {
+    return;
+  }
+
+  /* Remove kept files left by an incomplete clone. */
+  std::string clone_dir(CLONE_FILES_DIR);
+  std::string prefix(CLONE_INNODB_BASE_DATA_FILE + clone_dir.length());
+
+  os_file_scan_directory(
+      clone_dir.c_str(),
+      [&](const char *path, const char *name) {
+        if (strncmp(name, prefix.c_str(), prefix.length()) == 0) {
+          std::string file_name(path);
+          file_name.append(OS_PATH_SEPARATOR_STR).append(name);
+          os_file_delete_if_exists(innodb_clone_file_key, file_name.c_str(),
+                                   nullptr);
+        }
+      },
+      false);
+
+  std::string donor_uuid;
+  {
+    std::ifstream file(CLONE_INNODB_BASE_PENDING_FILE);
+    if (file.is_open()) {
+      file >> donor_uuid;
+    }
+  }
+  os_file_delete_if_exists(innodb_clone_file_key,
+                           CLONE_INNODB_BASE_PENDING_FILE, nullptr);
+
+  Clone_Incr_Base base;
+
+  if (clone_lsn == 0 || donor_uuid.length() != UUID_LENGTH ||
+      !srv_clone_incremental) {
+    if (srv_clone_incremental && base.read()) {
+      memcpy(clone_incr_base_uuid, base.m_donor_uuid.c_str(), UUID_LENGTH + 1);
+    }
+    return;
+  }
+
+  /* Track pages modified from now on, before any change is made. */
+  auto err = arch_page_sys->get_sys_client()->start(false, &base.m_track_lsn);
+
+  if (err != 0) {
+    ib::warn(ER_IB_CLONE_OPERATION)
+        << "Clone could not start page tracking for incremental clone";
+    return;
+  }
+
+  mtr_t mtr;
+  mtr_start(&mtr);
+  base.m_max_space_id = mtr_read_ulint(
+      dict_hdr_get(&mtr) + DICT_HDR_MAX_SPACE_ID, MLOG_4BYTES, &mtr);
+  mtr_commit(&mtr);
+
+  base.m_donor_uuid = donor_uuid;
+  base.m_lsn = clone_lsn;
+
+  if (!base.write()) {
+    ib::warn(ER_IB_CLONE_OPERATION)
+        << "Clone could not write " << CLONE_INNODB_BASE_FILE;
+    return;
+  }
+  memcpy(clone_incr_base_uuid, donor_uuid.c_str(), UUID_LENGTH + 1);
+
+  ib::info(ER_IB_CLONE_OPERATION)
+      << "Clone incremental base from " << donor_uuid << " at LSN "
+      << clone_lsn << ", page tracking from LSN " << base.m_track_lsn;
+}
+
+void clone_incr_add_request(const byte *&loc, uint &loc_len) {
+  auto &request = clone_incr_request;
+  request.clear();
+
+  Clone_Incr_Base base;
+
+  if (!srv_clone_incremental || srv_read_only_mode ||
+      !arch_page_sys->get_sys_client()->is_active() || !base.read()) {
+    return;
+  }
+
+  /* Keep tablespaces that existed at the base LSN by linking their files
+  in clone directory. User data is dropped before the clone is applied. */
+  Fil_iterator::for_each_file([&](fil_node_t *file) {
+    auto space = file->space;
+
+    if (!clone_incr_can_keep(space, base.m_max_space_id)) {
+      return DB_SUCCESS;
+    }
+    std::string file_name(CLONE_INNODB_BASE_DATA_FILE);
+    file_name.append(std::to_string(space->id));
+
+    std::error_code error;
+    std::filesystem::create_hard_link(file->name, file_name, error);
+
+    if (!error) {
+      request.m_files[space->id] = file_name;
+    }
+    return DB_SUCCESS;
+  });
+
+  /* Set a reset point to find pages modified after the ones sent. */
+  Clone_Incr_Pages pages;
+  pages.m_files = &request.m_files;
+
+  if (request.m_files.empty() ||
+      arch_page_sys->get_sys_client()->start(false, &request.m_check_lsn) !=
+          0 ||
+      !clone_incr_get_pages(base.m_track_lsn, pages)) {
+    request.clear();
+    return;
+  }
+
+  Clone_Desc_Incremental request_desc;
+  request_desc.m_donor_uuid = base.m_donor_uuid;
+  request_desc.m_base_lsn = base.m_lsn;
+  request_desc.m_max_space_id = base.m_max_space_id;
+  request_desc.m_accepted = false;
+
+  for (auto &file : request.m_files) {
+    request_desc.m_spaces.push_back(file.first);
+  }
+  request_desc.m_pages.assign(pages.m_pages.begin(), pages.m_pages.end());
+
+  Clone_Desc_Header header;
+  header.deserialize(loc, loc_len);
+  request_desc.init_header(header.m_version);
+
+  /* Append the request after the locator. */
+  auto &locator = request.m_locator;
+  locator.assign(loc, loc + header.m_length);
+  locator.resize(header.m_length + request_desc.m_header.m_length);
+
+  request_desc.serialize(locator.data() + header.m_length,
+                         request_desc.m_header.m_length);
+
+  request.m_donor_uuid = base.m_donor_uuid;
+  request.m_pages = std::move(pages.m_pages);
+
+  loc = locator.data();
+  loc_len = static_cast<uint>(locator.size());
+
+  ib::info(ER_IB_CLONE_OPERATION)
+      << "Clone incremental request to " << base.m_donor_uuid << ": "
+      << request.m_files.size() << " tablespaces, " << request.m_pages.size()
+      << " modified pages";
+}
+
+void clone_incr_begin_apply(const byte *loc, uint loc_len) {
+  auto &request = clone_incr_request;
+
+  Clone_Desc_Incremental reply;
+  bool replied = clone_get_incremental(loc, loc_len, reply);
+
+  /* The data directory is replaced with the donor's. */
+  os_file_delete_if_exists(innodb_clone_file_key, CLONE_INNODB_BASE_FILE,
+                           nullptr);
+  clone_incr_base_uuid[0] = '\0';
+
+  if (replied && srv_clone_incremental) {
+    std::ofstream file(CLONE_INNODB_BASE_PENDING_FILE);
+    file << reply.m_donor_uuid << std::endl;
+  }
+
+  if (!replied || !reply.m_accepted ||
+      reply.m_donor_uuid != request.m_donor_uuid) {
+    request.clear();
+    return;
+  }
+
+  ib::info(ER_IB_CLONE_OPERATION)
+      << "Clone incremental from " << reply.m_donor_uuid;
+}
+
+int clone_incr_check_base() {
+  auto &request = clone_incr_request;
+
+  if (request.m_files.empty()) {
+    return 0;
+  }
+
+  Clone_Incr_Pages pages;
+  pages.m_files = &request.m_files;
+
+  bool modified = !clone_incr_get_pages(request.m_check_lsn, pages);
+
+  for (auto page : pages.m_pages) {
+    if (modified || request.m_pages.count(page) == 0) {
+      modified = true;
+      break;
+    }
+  }
+
+  if (modified) {
+    request.clear();
+
+    my_error(ER_INTERNAL_ERROR, MYF(0),
+             "Clone: tablespaces modified while requesting incremental clone,"
+             " please retry");
+    return ER_INTERNAL_ERROR;
+  }
+  return 0;
+}
+
+int clone_incr_use_base(const Clone_File_Meta *file_meta,
+                        const std::string &file_name) {
+  auto &files = clone_incr_request.m_files;
+  auto it = files.find(file_meta->m_space_id);
+
+  if (it == files.end()) {
+    my_error(ER_CLONE_PROTOCOL, MYF(0),
+             "Wrong Clone RPC: Incremental file not requested");
+    return ER_CLONE_PROTOCOL;
+  }
+
+  auto db_err = os_file_create_subdirs_if_needed(file_name.c_str());
+
+  if (db_err != DB_SUCCESS ||
+      !os_file_rename(innodb_clone_file_key, it->second.c_str(),
+                      file_name.c_str())) {
+    char errbuf[MYSYS_STRERROR_SIZE];
+    my_error(ER_ERROR_ON_RENAME, MYF(0), it->second.c_str(),
+             file_name.c_str(), errno,
+             my_strerror(errbuf, sizeof(errbuf), errno));
+    return ER_ERROR_ON_RENAME;
+  }
+
+  files.erase(it);
+  return 0;
+}
+
+void clone_incr_invalidate() {
+  /* The data files no longer match the base of this server. */
+  os_file_delete_if_exists(innodb_clone_file_key, CLONE_INNODB_BASE_FILE,
+                           nullptr);
+  clone_incr_base_uuid[0] = '\0';
+
+  /* Pages written by import are not tracked. Restart tracking so that no
+  range from before the import is tracked and requests from recipients
+  cloned before it are not accepted. */
+  auto sys_client = arch_page_sys->get_sys_client();
+
+  if (!srv_clone_incremental || !sys_client->is_active()) {
+    return;
+  }
+
+  lsn_t stop_lsn = 0;
+  lsn_t start_lsn = 0;
+
+  if (sys_client->stop(&stop_lsn) != 0 ||
+      sys_client->start(false, &start_lsn) != 0) {
+    ib::warn(ER_IB_CLONE_OPERATION)
+        << "Clone could not restart page tracking for incremental clone";
+    return;
+  }
+
+  ib::info(ER_IB_CLONE_OPERATION)
+      << "Clone restarted page tracking for incremental clone at LSN "
+      << start_lsn << " after tablespace import";
+}
+
+void clone_incr_track_pages() {
+  auto sys_client = arch_page_sys->get_sys_client();
+
+  if (!srv_clone_incremental || srv_read_only_mode ||
+      sys_client->is_active()) {
+    return;
+  }
+
+  lsn_t start_lsn = 0;
+  auto err = sys_client->start(false, &start_lsn);
+
+  if (err != 0) {
+    ib::warn(ER_IB_CLONE_OPERATION)
+        << "Clone could not start page tracking for incremental clone";
+    return;
+  }
+
+  ib::info(ER_IB_CLONE_OPERATION)
+      << "Clone started page tracking for incremental clone at LSN "
+      << start_lsn;
+}
+
+bool clone_incr_check_request(const byte *loc, uint loc_len,
+                              Ha_clone_type type,
+                              Clone_Desc_Incremental &request,
+                              std::vector<byte> &reply) {
+  reply.clear();
+
+  if (!srv_clone_incremental || srv_read_only_mode || loc == nullptr) {
+    return false;
+  }
+
+  Clone_Desc_Incremental reply_desc;
+  reply_desc.m_donor_uuid = server_uuid;
+  reply_desc.m_base_lsn = 0;
+  reply_desc.m_max_space_id = 0;
+  reply_desc.m_accepted = false;
+
+  /* Pages can be tracked since the base only if this server was the donor,
+  as LSN and tablespace IDs are its own. */
+  if (type == HA_CLONE_HYBRID && clone_get_incremental(loc, loc_len, request) &&
+      request.m_donor_uuid == reply_desc.m_donor_uuid &&
+      request.m_base_lsn != 0) {
+    lsn_t start_lsn = request.m_base_lsn;
+    lsn_t stop_lsn = 0;
+    uint64_t num_pages = 0;
+
+    auto err = arch_page_sys->get_num_pages(start_lsn, stop_lsn, &num_pages);
+
+    reply_desc.m_accepted = (err == 0);
+
+    ib::info(ER_IB_CLONE_OPERATION)
+        << "Clone incremental request from LSN " << request.m_base_lsn << ": "
+        << request.m_spaces.size() << " tablespaces, "
+        << request.m_pages.size() << " modified pages, "
+        << (reply_desc.m_accepted ? "accepted" : "not tracked");
+  }
+
+  Clone_Desc_Header header;
+  header.deserialize(loc, loc_len);
+  reply_desc.init_header(header.m_version);
+
+  reply.resize(reply_desc.m_header.m_length);
+  reply_desc.serialize(reply.data(), reply_desc.m_header.m_length);
+
+  return reply_desc.m_accepted;
+}
@@ -62,6 +62,8 @@ Clone_Snapshot::Clone_Snapshot(Clone_Handle_Type hdl_type,
       m_page_ctx(false),
       m_num_pages(),
       m_num_duplicate_pages(),
+      m_incr_lsn(),
+      m_incr_max_space_id(),
       m_redo_ctx(),
       m_redo_start_offset(),
       m_redo_header(),
@@ -239,6 +241,15 @@ bool Clone_Snapshot::is_aborted() const {
   return m_aborted;
 }
 
+void Clone_Snapshot::set_incremental(const Clone_Desc_Incremental &request) {
+  ut_ad(get_state() == CLONE_SNAPSHOT_INIT);
+
+  m_incr_lsn = request.m_base_lsn;
+  m_incr_max_space_id = request.m_max_space_id;
+  m_incr_spaces.insert(request.m_spaces.begin(), request.m_spaces.end());
+  m_incr_pages = request.m_pages;
+}
+
 void Clone_Snapshot::set_abort() {
   IB_mutex_guard guard(&m_snapshot_mutex, UT_LOCATION_HERE);
   m_aborted = true;
@@ -96,6 +96,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "buf0stats.h"
 #include "clone0api.h"
 #include "clone0clone.h"
+#include "clone0incr.h"
 #include "dd/dd.h"
 #include "dd/dictionary.h"
 #include "dd/impl/bootstrap/bootstrap_ctx.h"
@@ -23042,6 +23043,19 @@ static MYSQL_SYSVAR_BOOL(redo_log_encrypt, srv_redo_log_encrypt,
                          "Enable or disable Encryption of REDO tablespace.",
                          validate_innodb_redo_log_encrypt, nullptr, false);
 
+static MYSQL_SYSVAR_BOOL(
+    clone_incremental, srv_clone_incremental, PLUGIN_VAR_OPCMDARG,
+    "Track modified pages so that a data directory replaced by clone can be"
+    " cloned again from the same donor by sending modified pages only.",
+    nullptr, nullptr, false);
+
+static MYSQL_SYSVAR_STR(clone_incremental_base, srv_clone_incremental_base,
+                        PLUGIN_VAR_NOCMDOPT | PLUGIN_VAR_READONLY |
+                            PLUGIN_VAR_NOPERSIST,
+                        "Server UUID of the donor this data directory can be"
+                        " cloned incrementally from.",
+                        nullptr, nullptr, "");
+
 static MYSQL_SYSVAR_BOOL(
     print_ddl_logs, srv_print_ddl_logs, PLUGIN_VAR_OPCMDARG,
     "Print all DDl logs to MySQL error log (off by default)", nullptr, nullptr,
@@ -23346,6 +23360,8 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(default_row_format),
     MYSQL_SYSVAR(redo_log_archive_dirs),
     MYSQL_SYSVAR(redo_log_encrypt),
+    MYSQL_SYSVAR(clone_incremental),
+    MYSQL_SYSVAR(clone_incremental_base),
     MYSQL_SYSVAR(print_ddl_logs),
 #ifdef UNIV_DEBUG
     MYSQL_SYSVAR(trx_rseg_n_slots_debug),
@@ -91,6 +91,18 @@ const char CLONE_INNODB_OLD_FILES[] =
 const char CLONE_INNODB_DDL_FILES[] =
     CLONE_FILES_DIR OS_FILE_PREFIX "ddl_files";
 
+/** Clone file name for the base of incremental clone: the donor, LSN and
+page tracking start of the last clone. */
+const char CLONE_INNODB_BASE_FILE[] = CLONE_FILES_DIR OS_FILE_PREFIX "base";
+
+/** Clone file name for the donor of a clone not yet started on. */
+const char CLONE_INNODB_BASE_PENDING_FILE[] =
+    CLONE_FILES_DIR OS_FILE_PREFIX "base_pending";
+
+/** Clone file name prefix for data files kept during incremental clone. */
+const char CLONE_INNODB_BASE_DATA_FILE[] =
+    CLONE_FILES_DIR OS_FILE_PREFIX "base_space_";
+
 /** Clone file extension for files to be replaced. */
 const char CLONE_INNODB_REPLACED_FILE_EXTN[] = "." OS_FILE_PREFIX "clone";
 
@@ -1020,6 +1032,12 @@ class Clone_Handle {
   /** Locator length in bytes */
   uint m_locator_length;
 
+  /** Serialized reply to incremental clone request, appended to locator */
+  std::vector<byte> m_incr_reply;
+
+  /** Serialized locator with incremental clone reply */
+  std::vector<byte> m_incr_locator;
+
   /** Serialized Restart locator */
   byte *m_restart_loc;
 
@@ -33,6 +33,9 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #ifndef CLONE_DESC_INCLUDE
 #define CLONE_DESC_INCLUDE
 
+#include <string>
+#include <vector>
+
 #include "mem0mem.h"
 #include "os0file.h"
 #include "univ.i"
@@ -143,6 +146,9 @@ enum Clone_Desc_Type {
   /** Information for a data block */
   CLONE_DESC_DATA,
 
+  /** Incremental clone request or reply, appended after a locator */
+  CLONE_DESC_INCREMENTAL,
+
   /** Must be the last member */
   CLONE_DESC_MAX
 };
@@ -535,6 +541,10 @@ struct Clone_File_Meta {
   /* Contains encryption key to be transferred. */
   bool m_transfer_encryption_key;
 
+  /* File is kept from the recipient's previous clone and only its
+  modified pages are transferred. */
+  bool m_incremental;
+
   /** File system block size. */
   size_t m_fsblk_size;
 
@@ -633,4 +643,58 @@ struct Clone_Desc_Data {
   bool deserialize(const byte *desc_data, uint desc_len);
 };
 
+/** CLONE_DESC_INCREMENTAL: Descriptor appended by the recipient after its
+version locator to request an incremental clone, and by the donor after its
+locator to reply. Servers not knowing it ignore it as it is beyond the
+locator length. */
+struct Clone_Desc_Incremental {
+  /** Descriptor header */
+  Clone_Desc_Header m_header;
+
+  /** Server UUID of the donor the recipient was cloned from, or of the
+  donor replying. */
+  std::string m_donor_uuid;
+
+  /** LSN the recipient was cloned at. */
+  uint64_t m_base_lsn;
+
+  /** Maximum tablespace ID at the base LSN. */
+  uint32_t m_max_space_id;
+
+  /** Set by the donor if it sends only modified pages for the
+  tablespaces. */
+  bool m_accepted;
+
+  /** Tablespaces the recipient keeps from its previous clone. */
+  std::vector<uint32_t> m_spaces;
+
+  /** Pages the recipient modified in them, as (space ID << 32 | page
+  number). */
+  std::vector<uint64_t> m_pages;
+
+  /** Initialize header
+  @param[in]    version descriptor version */
+  void init_header(uint version);
+
+  /** Serialize the descriptor.
+  @param[out]   desc_incr       serialized descriptor
+  @param[in]    len             length of the buffer, must be at least
+                                m_header.m_length */
+  void serialize(byte *desc_incr, uint len);
+
+  /** Deserialize the descriptor.
+  @param[in]    desc_incr       serialized descriptor
+  @param[in]    desc_len        descriptor length
+  @return true, if successful. */
+  bool deserialize(const byte *desc_incr, uint desc_len);
+};
+
+/** Get the incremental clone descriptor appended to a locator.
+@param[in]      desc_loc        serialized locator
+@param[in]      desc_len        length of the serialized locator
+@param[out]     desc_incr       incremental clone descriptor
+@return true, if the locator has a valid one. */
+bool clone_get_incremental(const byte *desc_loc, uint desc_len,
+                           Clone_Desc_Incremental &desc_incr);
+
 #endif /* CLONE_DESC_INCLUDE */
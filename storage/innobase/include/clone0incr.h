@@ -0,0 +1,122 @@
+/*****************************************************************************
+
+Copyright (c) 2024, Oracle and/or its affiliates.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License, version 2.0, as published by the
+Free Software Foundation.
+
+This program is designed to work with certain software (including
+but not limited to OpenSSL) that is licensed under separate terms,
+as designated in a particular file or component or in included license
+documentation.  The authors of MySQL hereby grant you an additional
+permission to link the program and your derivative works with the
+separately licensed software that they have either included with
+the program or referenced in the documentation.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License, version 2.0,
+for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+
+*****************************************************************************/
+
+/** @file include/clone0incr.h
+ Innodb incremental clone
+
+ A data directory replaced by clone can later be cloned again from the same
+ donor by sending only the pages modified since. Both servers need
+ innodb_clone_incremental = ON.
+
+ The donor keeps the system page tracking client started from its first
+ clone on. The recipient records the donor, the LSN it was cloned at and
+ the maximum tablespace ID in CLONE_INNODB_BASE_FILE when it first starts,
+ and starts page tracking too.
+
+ The next clone from that donor keeps the file-per-table and general
+ tablespaces that existed at the base LSN: the recipient links them under
+ the clone directory before dropping user data and sends their IDs with the
+ pages it modified since. The donor sends the file metadata of the ones it
+ still has without data, then the pages either server modified in page
+ copy. Encrypted and compressed tablespaces are always sent whole.
+
+ IMPORT TABLESPACE writes pages without tracking them, so it invalidates
+ incremental clone on both sides, see clone_incr_invalidate.
+
+ *******************************************************/
+
+#ifndef CLONE_INCR_INCLUDE
+#define CLONE_INCR_INCLUDE
+
+#include <string>
+#include <vector>
+
+#include "clone0desc.h"
+#include "fil0fil.h"
+#include "sql/handler.h"
+#include "univ.i"
+
+/** Donor server UUID a replaced data directory can be cloned incrementally
+from, empty if none. */
+extern char *srv_clone_incremental_base;
+
+/** Record the base for incremental clone when starting after clone and
+remove leftovers of an incremental clone otherwise.
+@param[in]      clone_lsn       LSN the data directory was cloned at, 0 if it
+                                was not replaced by clone */
+void clone_incr_boot(lsn_t clone_lsn);
+
+/** Check if a tablespace can be kept by incremental clone.
+@param[in]      space           tablespace
+@param[in]      max_space_id    maximum tablespace ID of the base
+@return true, iff the data file can be reused */
+bool clone_incr_can_keep(const fil_space_t *space, space_id_t max_space_id);
+
+/** Append an incremental clone request to the version locator if the data
+directory is being replaced and has a base for the donor.
+@param[in,out]  loc     serialized locator
+@param[in,out]  loc_len locator length */
+void clone_incr_add_request(const byte *&loc, uint &loc_len);
+
+/** Start applying clone data with the reply of the donor. Called before
+user data is dropped.
+@param[in]      loc     donor locator
+@param[in]      loc_len locator length */
+void clone_incr_begin_apply(const byte *loc, uint loc_len);
+
+/** Check that no kept tablespace was modified after the request was sent.
+Called before user data is dropped and again after it is dropped.
+@return error code */
+int clone_incr_check_base();
+
+/** Put a data file kept from the previous clone in place.
+@param[in]      file_meta       file metadata from donor
+@param[in]      file_name       name for the file
+@return error code */
+int clone_incr_use_base(const Clone_File_Meta *file_meta,
+                        const std::string &file_name);
+
+/** Invalidate incremental clone when a tablespace is imported: drop the
+base of this server and stop accepting requests with an older base. */
+void clone_incr_invalidate();
+
+/** Start tracking modified pages for incremental clone from this server. */
+void clone_incr_track_pages();
+
+/** Check the incremental clone request appended to a recipient locator.
+@param[in]      loc             recipient locator
+@param[in]      loc_len         locator length
+@param[in]      type            clone type
+@param[out]     request         request of the recipient
+@param[out]     reply           serialized reply, empty if none is sent
+@return true, iff modified pages only are sent for requested tablespaces */
+bool clone_incr_check_request(const byte *loc, uint loc_len,
+                              Ha_clone_type type,
+                              Clone_Desc_Incremental &request,
+                              std::vector<byte> &reply);
+
+#endif /* CLONE_INCR_INCLUDE */
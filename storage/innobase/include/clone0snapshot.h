@@ -44,6 +44,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "sql/handler.h"
 
 #include <map>
+#include <set>
 #include <vector>
 
 struct Clone_file_ctx {
@@ -427,6 +428,11 @@ class Clone_Snapshot {
   /** Detach from snapshot. */
   void detach();
 
+  /** Send only modified pages of tablespaces kept by the recipient from
+  a previous clone.
+  @param[in]    request incremental clone request */
+  void set_incremental(const Clone_Desc_Incremental &request);
+
   /** Set current snapshot aborted state. Used in error cases before exiting
   clone to make sure any DDL notifier exits waiting. */
   void set_abort();
@@ -489,6 +495,24 @@ class Clone_Snapshot {
   @return error code */
   int add_page(uint32_t space_id, uint32_t page_num);
 
+  /** Check if a data file is kept by the recipient.
+  @param[in]    node    file node
+  @return true, iff only modified pages are sent for the file */
+  bool is_incremental(const fil_node_t *node) const;
+
+  /** Check if a page of a file kept by the recipient needs to be sent.
+  @param[in]    space_id        page tablespace
+  @param[in]    page_num        page number within tablespace
+  @return true, iff page is to be sent */
+  bool is_incremental_page(space_id_t space_id, uint32_t page_num) const;
+
+  /** Add pages modified by either server since the previous clone for
+  files kept by the recipient.
+  @param[in]    page_buffer     buffer for reading tracked pages
+  @param[in]    page_buffer_len buffer length
+  @return error code */
+  int add_incremental_pages(byte *page_buffer, uint page_buffer_len);
+
   /** Add redo file to snapshot
   @param[in]    file_name       file name
   @param[in]    file_size       file size in bytes
@@ -1033,6 +1057,20 @@ class Clone_Snapshot {
   /** Number of duplicate pages found */
   uint m_num_duplicate_pages;
 
+  /** @name Snapshot incremental clone data */
+
+  /** LSN of the data the recipient keeps, zero if clone is not incremental */
+  lsn_t m_incr_lsn;
+
+  /** Maximum tablespace ID at m_incr_lsn */
+  space_id_t m_incr_max_space_id;
+
+  /** Tablespaces kept by the recipient */
+  std::set<space_id_t> m_incr_spaces;
+
+  /** Pages modified by the recipient, tablespace ID in the high bits */
+  std::vector<uint64_t> m_incr_pages;
+
   /** @name Snapshot redo data */
 
   /** redo log archiver client */
@@ -430,6 +430,10 @@ extern char *srv_log_group_home_dir;
 /** Enable or Disable Encrypt of REDO tablespace. */
 extern bool srv_redo_log_encrypt;
 
+/** Value of innodb_clone_incremental: track modified pages so that a data
+directory replaced by clone can be cloned again incrementally. */
+extern bool srv_clone_incremental;
+
 /* Maximum number of redo files of a cloned DB. */
 constexpr size_t SRV_N_LOG_FILES_CLONE_MAX = 1000;
 
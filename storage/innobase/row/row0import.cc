@@ -40,6 +40,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "sql/dd/types/column_type_element.h"
 
 #include "btr0pcur.h"
+#include "clone0incr.h"
 #include "dict0boot.h"
 #include "dict0crea.h"
 #include "dict0dd.h"
@@ -4380,6 +4381,9 @@ dberr_t row_import_for_mysql(dict_table_t *table, dd::Table *table_def,
   ut_ad(prebuilt->trx);
   ut_a(table->ibd_file_missing);
 
+  /* The imported pages are not tracked for incremental clone. */
+  clone_incr_invalidate();
+
   ibuf_delete_for_discarded_space(table->space);
 
   trx_start_if_not_started(prebuilt->trx, true, UT_LOCATION_HERE);
@@ -103,6 +103,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "buf0rea.h"
 #include "clone0api.h"
 #include "clone0clone.h"
+#include "clone0incr.h"
 #include "dict0boot.h"
 #include "dict0crea.h"
 #include "dict0load.h"
@@ -2152,6 +2153,9 @@ dberr_t srv_start(bool create_new_db) {
       ut_a(redo_writes_allowed || srv_read_only_mode);
     }
 
+    /* Record the base for incremental clone before data is modified. */
+    clone_incr_boot(recv_sys->is_cloned_db ? recv_sys->recovered_lsn : 0);
+
     if (sum_of_new_sizes > 0) {
       ut_a(!srv_read_only_mode);
 
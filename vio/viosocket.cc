@@ -68,6 +68,9 @@
 #ifdef HAVE_SYS_IOCTL_H
 #include <sys/ioctl.h>
 #endif
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
 
 #include "mysql/psi/mysql_socket.h"
 
@@ -243,6 +246,67 @@ size_t vio_write(Vio *vio, const uchar *buf, size_t size) {
   return ret;
 }
 
+bool vio_can_sendfile(Vio *vio [[maybe_unused]]) {
+#ifdef __linux__
+  return vio->type == VIO_TYPE_TCPIP || vio->type == VIO_TYPE_SOCKET;
+#else
+  return false;
+#endif
+}
+
+size_t vio_sendfile(Vio *vio, File file, my_off_t offset, size_t size) {
+  DBUG_TRACE;
+#ifdef __linux__
+  assert(vio_can_sendfile(vio));
+  const my_socket sd = mysql_socket_getfd(vio->mysql_socket);
+  off_t file_offset = static_cast<off_t>(offset);
+  ssize_t ret;
+
+  /*
+    sendfile(2) has no equivalent of VIO_DONTWAIT, so if timeout is enabled
+    the socket is made nonblocking while sending and vio_socket_io_wait() is
+    used to wait for it to become writable, as in vio_write().
+  */
+  int old_flags = -1;
+  if (vio->write_timeout >= 0) {
+    old_flags = fcntl(sd, F_GETFL);
+    if (old_flags == -1) return VIO_SOCKET_ERROR;
+    if (!(old_flags & O_NONBLOCK) &&
+        fcntl(sd, F_SETFL, old_flags | O_NONBLOCK) == -1)
+      return VIO_SOCKET_ERROR;
+  }
+
+  while ((ret = sendfile(sd, file, &file_offset, size)) == -1) {
+    int error = socket_errno;
+
+    /* The operation would block? */
+#if SOCKET_EAGAIN == SOCKET_EWOULDBLOCK
+    if (error != SOCKET_EAGAIN)
+#else
+    if (error != SOCKET_EAGAIN && error != SOCKET_EWOULDBLOCK)
+#endif
+      break;
+
+    /* Wait for the output buffer to become writable.*/
+    if ((ret = vio_socket_io_wait(vio, VIO_IO_EVENT_WRITE))) break;
+  }
+
+  if (old_flags != -1 && !(old_flags & O_NONBLOCK)) {
+    int error = errno;
+    (void)fcntl(sd, F_SETFL, old_flags);
+    errno = error;
+  }
+  return ret;
+#else
+  (void)vio;
+  (void)file;
+  (void)offset;
+  (void)size;
+  errno = ENOSYS;
+  return VIO_SOCKET_ERROR;
+#endif
+}
+
 // WL#4896: Not covered
 int vio_set_blocking(Vio *vio, bool status) {
   DBUG_TRACE;